@@ -0,0 +1,109 @@
+// Keeping the last N events, like trace or telemetry ring
+// my::deque needs push_back and pop_front for every event, circular_buffer overwrites the oldest event in place
+
+#include "toy_stl/circular_buffer.hpp"
+#include "toy_stl/deque.hpp"
+
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    volatile long long sink = 0;
+
+    struct event
+    {
+        long long timestamp;
+        int kind;
+        int thread_id;
+        double value;
+    };
+
+    struct string_event
+    {
+        long long timestamp;
+        std::string message;
+    };
+
+    template <typename Event>
+    Event make_event(long long i)
+    {
+        if constexpr (std::is_same_v<Event, event>) {
+            return event { i, static_cast<int>(i & 7), 1, i * 0.5 };
+        } else {
+            return string_event { i, "request handled in 42 ms, status 200" };
+        }
+    }
+
+    // Returns best time of several runs in nanoseconds per recorded event
+    template <typename Record>
+    double measure(int runs, std::size_t events_count, Record record)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; run += 1) {
+            const auto start = std::chrono::steady_clock::now();
+            sink = sink + record(events_count);
+            const auto end = std::chrono::steady_clock::now();
+
+            const std::chrono::duration<double, std::nano> elapsed = end - start;
+            best = std::min(best, elapsed.count() / events_count);
+        }
+
+        return best;
+    }
+
+    template <typename Event>
+    void print_row(const char* name, std::size_t last_n, int runs)
+    {
+        constexpr std::size_t events_count = 10'000'000;
+
+        const auto deque_time = measure(runs, events_count, [last_n](std::size_t count) {
+            my::deque<Event> events;
+            for (std::size_t i = 0; i < count; i += 1) {
+                events.push_back(make_event<Event>(i));
+                if (events.size() > last_n) {
+                    events.pop_front();
+                }
+            }
+            return events.back().timestamp;
+        });
+
+        const auto buffer_time = measure(runs, events_count, [last_n](std::size_t count) {
+            my::circular_buffer<Event> events(last_n);
+            for (std::size_t i = 0; i < count; i += 1) {
+                events.push_back(make_event<Event>(i));
+            }
+            return events.back().timestamp;
+        });
+
+        std::cout << std::left << std::setw(24) << name
+            << std::right << std::setw(10) << last_n
+            << std::fixed << std::setprecision(3)
+            << std::setw(14) << deque_time
+            << std::setw(18) << buffer_time
+            << '\n';
+    }
+}
+
+int main()
+{
+    constexpr int runs = 5;
+
+    std::cout << std::left << std::setw(24) << "event"
+        << std::right << std::setw(10) << "last N"
+        << std::setw(14) << "my::deque"
+        << std::setw(18) << "circular_buffer"
+        << '\n';
+
+    for (std::size_t last_n : { 1000, 100000 }) {
+        print_row<event>("24 byte struct", last_n, runs);
+        print_row<string_event>("struct with std::string", last_n, runs);
+    }
+
+    return 0;
+}
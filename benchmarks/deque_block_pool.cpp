@@ -0,0 +1,89 @@
+// Compares short-lived deques with blocks from std::allocator and from thread-local block pool
+// Every deque below allocates and frees a few blocks, so with std::allocator most of the time goes to malloc and free
+
+#include "toy_stl/deque.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    volatile long long sink = 0;
+
+    // Creates deque, pushes elements_count elements through it like through a queue and destroys it
+    template <typename Deque>
+    long long churn(std::size_t elements_count)
+    {
+        Deque deq;
+        long long sum = 0;
+
+        for (std::size_t i = 0; i < elements_count; i += 1) {
+            deq.push_back(static_cast<int>(i));
+            if (deq.size() > 8) {
+                sum += deq.front();
+                deq.pop_front();
+            }
+        }
+
+        return sum;
+    }
+
+    // Returns time of one run in nanoseconds per deque
+    template <typename Deque>
+    double measure(std::size_t deques_count, std::size_t elements_count)
+    {
+        long long sum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < deques_count; i += 1) {
+            sum += churn<Deque>(elements_count);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        sink = sink + sum;
+
+        const std::chrono::duration<double, std::nano> elapsed = end - start;
+        return elapsed.count() / deques_count;
+    }
+
+    template <typename Policy>
+    void print_row(const char* name, std::size_t elements_count)
+    {
+        constexpr std::size_t total_elements = 20'000'000;
+        constexpr int runs = 7;
+
+        const auto deques_count = total_elements / elements_count;
+
+        // Runs are interleaved, so that both variants see the same noise, best run is taken
+        double plain_time = std::numeric_limits<double>::max();
+        double pooled_time = std::numeric_limits<double>::max();
+        for (int run = 0; run < runs; run += 1) {
+            plain_time = std::min(plain_time, measure<my::deque<int, std::allocator<int>, Policy>>(deques_count, elements_count));
+            pooled_time = std::min(pooled_time, measure<my::pooled_deque<int, Policy>>(deques_count, elements_count));
+        }
+
+        std::cout << std::left << std::setw(12) << name
+            << std::right << std::setw(12) << elements_count
+            << std::fixed << std::setprecision(1)
+            << std::setw(16) << plain_time
+            << std::setw(16) << pooled_time
+            << '\n';
+    }
+}
+
+int main()
+{
+    std::cout << "short-lived deques of int, ns per deque\n";
+    std::cout << std::left << std::setw(12) << "blocks"
+        << std::right << std::setw(12) << "elements"
+        << std::setw(16) << "std::allocator"
+        << std::setw(16) << "block pool"
+        << '\n';
+
+    print_row<my::small_block_size>("small", 4);
+    print_row<my::small_block_size>("small", 100);
+    print_row<my::default_block_size>("default", 4);
+    print_row<my::default_block_size>("default", 100);
+    print_row<my::default_block_size>("default", 10000);
+}
@@ -0,0 +1,130 @@
+// Compares block size policies of my::deque
+// Larger blocks are allocated and crossed less often, so queue throughput should grow with block size
+// Every non-empty deque holds at least one whole block, so memory overhead of small deques grows with block size too
+// Huge page policy only picks block size, blocks are still allocated with std::allocator and are not aligned to huge pages
+
+#include "toy_stl/deque.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    volatile long long sink = 0;
+
+    // Total number of bytes allocated by all counting allocators
+    std::size_t allocated_bytes = 0;
+
+    template <typename T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        counting_allocator() = default;
+
+        template <typename U>
+        counting_allocator(const counting_allocator<U>&) { }
+
+        T* allocate(std::size_t n)
+        {
+            allocated_bytes += n * sizeof(T);
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n)
+        {
+            allocated_bytes -= n * sizeof(T);
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <typename U>
+        bool operator==(const counting_allocator<U>&) const { return true; }
+    };
+
+    template <typename Policy>
+    using deque_type = my::deque<int, counting_allocator<int>, Policy>;
+
+    // Keeps queue_length elements in the deque and pushes to the back and pops from the front
+    // Returns best time of several runs in nanoseconds per push and pop pair
+    template <typename Policy>
+    double measure_queue(std::size_t queue_length, std::size_t operations, int runs)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; run += 1) {
+            deque_type<Policy> deq;
+            for (std::size_t i = 0; i < queue_length; i += 1) {
+                deq.push_back(static_cast<int>(i));
+            }
+
+            long long sum = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < operations; i += 1) {
+                deq.push_back(static_cast<int>(i));
+                sum += deq.front();
+                deq.pop_front();
+            }
+            const auto end = std::chrono::steady_clock::now();
+            sink = sink + sum;
+
+            const std::chrono::duration<double, std::nano> elapsed = end - start;
+            best = std::min(best, elapsed.count() / operations);
+        }
+
+        return best;
+    }
+
+    // Returns allocated bytes per deque when deques_count deques hold elements_count elements each
+    template <typename Policy>
+    double measure_memory(std::size_t deques_count, std::size_t elements_count)
+    {
+        const auto allocated_before = allocated_bytes;
+
+        std::vector<deque_type<Policy>> deques(deques_count);
+        for (auto& deq : deques) {
+            for (std::size_t i = 0; i < elements_count; i += 1) {
+                deq.push_back(static_cast<int>(i));
+            }
+        }
+
+        return static_cast<double>(allocated_bytes - allocated_before) / deques_count;
+    }
+
+    template <typename Policy>
+    void print_row(const char* name)
+    {
+        constexpr int runs = 5;
+        constexpr std::size_t operations = 20'000'000;
+
+        std::cout << std::left << std::setw(12) << name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << deque_type<Policy>::block_size
+            << std::setw(12) << measure_queue<Policy>(16, operations, runs)
+            << std::setw(12) << measure_queue<Policy>(1'000'000, operations, runs)
+            << std::setw(14) << std::setprecision(0) << measure_memory<Policy>(100, 4)
+            << std::setw(14) << std::setprecision(3) << measure_memory<Policy>(1, 1'000'000) / (1'000'000 * sizeof(int))
+            << '\n';
+    }
+}
+
+int main()
+{
+    std::cout << "queue: push_back and pop_front of int, ns per pair\n";
+    std::cout << "tiny: bytes allocated by deque of 4 ints, large: bytes allocated per byte of 1M ints\n";
+    std::cout << std::left << std::setw(12) << "policy"
+        << std::right << std::setw(12) << "elements"
+        << std::setw(12) << "queue 16"
+        << std::setw(12) << "queue 1M"
+        << std::setw(14) << "tiny bytes"
+        << std::setw(14) << "large ratio"
+        << '\n';
+
+    print_row<my::small_block_size>("small");
+    print_row<my::default_block_size>("default");
+    print_row<my::large_block_size>("large");
+    print_row<my::huge_page_block_size>("huge page");
+}
@@ -0,0 +1,90 @@
+// Compares filling a queue with a batch of known size element by element and with emplace_back_n
+// emplace_back_n checks capacity once and constructs elements block by block
+
+#include "toy_stl/deque.hpp"
+
+#include <deque>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    volatile long long sink = 0;
+
+    // Returns best time of several runs in nanoseconds per element
+    template <typename Fill>
+    double measure(std::size_t batch_size, int batches, int runs, Fill fill)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; run += 1) {
+            const auto start = std::chrono::steady_clock::now();
+            sink = sink + fill(batch_size, batches);
+            const auto end = std::chrono::steady_clock::now();
+
+            const std::chrono::duration<double, std::nano> elapsed = end - start;
+            best = std::min(best, elapsed.count() / (batch_size * batches));
+        }
+
+        return best;
+    }
+
+    // Every batch is pushed and then consumed, like in a queue between two stages of a pipeline
+    template <typename Deque>
+    long long push_one_by_one(std::size_t batch_size, int batches)
+    {
+        Deque deq;
+        long long sum = 0;
+        for (int batch = 0; batch < batches; batch += 1) {
+            for (std::size_t i = 0; i < batch_size; i += 1) {
+                deq.push_back(static_cast<int>(i));
+            }
+            sum += deq.back();
+            deq.clear();
+        }
+
+        return sum;
+    }
+
+    long long emplace_n(std::size_t batch_size, int batches)
+    {
+        my::deque<int> deq;
+        long long sum = 0;
+        for (int batch = 0; batch < batches; batch += 1) {
+            int next = 0;
+            deq.emplace_back_n(batch_size, [&next] { return next++; });
+            sum += deq.back();
+            deq.clear();
+        }
+
+        return sum;
+    }
+}
+
+int main()
+{
+    constexpr std::size_t batch_size = 100'000;
+    constexpr int batches = 20;
+    constexpr int runs = 5;
+
+    std::cout << batches << " batches of " << batch_size << " ints, ns per element\n";
+    std::cout << std::left << std::setw(28) << "operation"
+        << std::right << std::setw(14) << "time"
+        << '\n';
+
+    const auto print_row = [](const char* name, double time) {
+        std::cout << std::left << std::setw(28) << name
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(14) << time
+            << '\n';
+    };
+
+    print_row("std::deque push_back", measure(batch_size, batches, runs, push_one_by_one<std::deque<int>>));
+    print_row("my::deque push_back", measure(batch_size, batches, runs, push_one_by_one<my::deque<int>>));
+    print_row("my::deque emplace_back_n", measure(batch_size, batches, runs, emplace_n));
+
+    return 0;
+}
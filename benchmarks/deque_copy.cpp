@@ -0,0 +1,89 @@
+// Compares copying of my::deque and std::deque, like taking a snapshot of a queue
+// For trivially copyable elements my::deque copies every block with memmove
+
+#include "toy_stl/deque.hpp"
+
+#include <deque>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    volatile long long sink = 0;
+
+    template <typename Deque>
+    Deque make_deque(std::size_t elements_count)
+    {
+        // Some elements are popped from the front, so elements do not start at the beginning of a block
+        Deque deq;
+        for (std::size_t i = 0; i < elements_count + 100; i += 1) {
+            deq.push_back(static_cast<int>(i));
+        }
+        for (std::size_t i = 0; i < 100; i += 1) {
+            deq.pop_front();
+        }
+
+        return deq;
+    }
+
+    // Returns best time of several runs in nanoseconds per element
+    template <typename Deque, typename Copy>
+    double measure(const Deque& deq, int runs, Copy copy)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; run += 1) {
+            const auto start = std::chrono::steady_clock::now();
+            sink = sink + copy(deq);
+            const auto end = std::chrono::steady_clock::now();
+
+            const std::chrono::duration<double, std::nano> elapsed = end - start;
+            best = std::min(best, elapsed.count() / deq.size());
+        }
+
+        return best;
+    }
+
+    template <typename Copy>
+    void print_row(const char* name, const my::deque<int>& my_deque, const std::deque<int>& std_deque, int runs, Copy copy)
+    {
+        const auto my_time = measure(my_deque, runs, copy);
+        const auto std_time = measure(std_deque, runs, copy);
+
+        std::cout << std::left << std::setw(20) << name
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(14) << my_time
+            << std::setw(14) << std_time
+            << '\n';
+    }
+}
+
+int main()
+{
+    constexpr std::size_t elements_count = 1'000'000;
+    constexpr int runs = 20;
+
+    const auto my_deque = make_deque<my::deque<int>>(elements_count);
+    const auto std_deque = make_deque<std::deque<int>>(elements_count);
+
+    std::cout << "copy of " << elements_count << " ints, ns per element\n";
+    std::cout << std::left << std::setw(20) << "operation"
+        << std::right << std::setw(14) << "my::deque"
+        << std::setw(14) << "std::deque"
+        << '\n';
+
+    print_row("copy constructor", my_deque, std_deque, runs, [](const auto& deq) {
+        const auto copy = deq;
+        return copy.back();
+    });
+
+    print_row("copy assignment", my_deque, std_deque, runs, [](const auto& deq) {
+        // Destination already has memory, like a snapshot buffer that is reused
+        static std::remove_cvref_t<decltype(deq)> copy(deq.size(), 0);
+        copy = deq;
+        return copy.back();
+    });
+}
@@ -0,0 +1,111 @@
+// Insertion and removal in the middle of a deque, like cancelling orders in a queue
+// Deque moves elements on the shorter side, whole runs inside of one block are moved at once
+
+#include "toy_stl/deque.hpp"
+
+#include <deque>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    volatile long long sink = 0;
+
+    struct order
+    {
+        long long id;
+        long long price;
+        long long quantity;
+    };
+
+    template <typename Deque>
+    Deque make_deque(std::size_t elements_count)
+    {
+        Deque deq;
+        for (std::size_t i = 0; i < elements_count; i += 1) {
+            deq.push_back(order { static_cast<long long>(i), 100, 10 });
+        }
+        return deq;
+    }
+
+    // Positions are spread over the whole deque, but are the same for both containers
+    std::size_t position(std::size_t step, std::size_t size)
+    {
+        return (step * 2654435761u) % size;
+    }
+
+    // Returns best time of several runs in nanoseconds per operation
+    template <typename Deque, typename Operation>
+    double measure(int runs, std::size_t elements_count, std::size_t operations_count, Operation operation)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; run += 1) {
+            auto deq = make_deque<Deque>(elements_count);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < operations_count; i += 1) {
+                operation(deq, i);
+            }
+            const auto end = std::chrono::steady_clock::now();
+
+            sink = sink + deq.size();
+            const std::chrono::duration<double, std::nano> elapsed = end - start;
+            best = std::min(best, elapsed.count() / operations_count);
+        }
+
+        return best;
+    }
+
+    template <typename Operation>
+    void print_row(const char* name, std::size_t elements_count, std::size_t operations_count, Operation operation)
+    {
+        constexpr int runs = 5;
+
+        const auto my_time = measure<my::deque<order>>(runs, elements_count, operations_count, operation);
+        const auto std_time = measure<std::deque<order>>(runs, elements_count, operations_count, operation);
+
+        std::cout << std::left << std::setw(28) << name
+            << std::right << std::setw(10) << elements_count
+            << std::fixed << std::setprecision(1)
+            << std::setw(14) << my_time
+            << std::setw(14) << std_time
+            << '\n';
+    }
+}
+
+int main()
+{
+    std::cout << std::left << std::setw(28) << "operation"
+        << std::right << std::setw(10) << "size"
+        << std::setw(14) << "my::deque"
+        << std::setw(14) << "std::deque"
+        << '\n';
+
+    for (std::size_t elements_count : { 1000, 100000 }) {
+        const std::size_t operations_count = elements_count / 2;
+
+        print_row("erase one", elements_count, operations_count, [](auto& deq, std::size_t i) {
+            deq.erase(deq.begin() + position(i, deq.size()));
+        });
+
+        print_row("emplace one", elements_count, operations_count, [](auto& deq, std::size_t i) {
+            deq.emplace(deq.begin() + position(i, deq.size()), order { -1, 0, 0 });
+        });
+
+        print_row("insert 100 copies", elements_count, operations_count / 100, [](auto& deq, std::size_t i) {
+            deq.insert(deq.begin() + position(i, deq.size()), 100, order { -1, 0, 0 });
+        });
+
+        print_row("erase 100", elements_count, operations_count / 100, [](auto& deq, std::size_t i) {
+            const auto first = position(i, deq.size() - 100);
+            deq.erase(deq.begin() + first, deq.begin() + first + 100);
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Compares full scans of my::deque and std::deque
+// Iterator caches pointer to the current block, so iteration should be close to std::deque
+// Indexing has to find block for every element, so it is expected to be slower than iteration
+// my:: algorithms run on pointers inside of every block of my::deque, for std::deque they fall back to std:: algorithms
+
+#include "toy_stl/deque.hpp"
+
+#include <deque>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    // Result is accumulated here, so compiler can't throw scans away
+    volatile long long sink = 0;
+
+    template <typename Deque>
+    Deque make_deque(std::size_t elements_count)
+    {
+        // Half of elements is pushed to the front, so they wrap around array of blocks
+        Deque deq;
+        for (std::size_t i = 0; i < elements_count / 2; i += 1) {
+            deq.push_back(static_cast<int>(i));
+            deq.push_front(static_cast<int>(i));
+        }
+
+        return deq;
+    }
+
+    // Returns best time of several runs in nanoseconds per element
+    template <typename Deque, typename Scan>
+    double measure(const Deque& deq, int runs, Scan scan)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; run += 1) {
+            const auto start = std::chrono::steady_clock::now();
+            sink = sink + scan(deq);
+            const auto end = std::chrono::steady_clock::now();
+
+            const std::chrono::duration<double, std::nano> elapsed = end - start;
+            best = std::min(best, elapsed.count() / deq.size());
+        }
+
+        return best;
+    }
+
+    template <typename Deque>
+    long long iterate(const Deque& deq)
+    {
+        long long sum = 0;
+        for (const auto& element : deq) {
+            sum += element;
+        }
+
+        return sum;
+    }
+
+    template <typename Deque>
+    long long index(const Deque& deq)
+    {
+        long long sum = 0;
+        for (std::size_t i = 0; i < deq.size(); i += 1) {
+            sum += deq[i];
+        }
+
+        return sum;
+    }
+
+    template <typename Deque>
+    long long accumulate(const Deque& deq)
+    {
+        return std::accumulate(deq.begin(), deq.end(), 0LL);
+    }
+
+    template <typename Deque>
+    long long copy(const Deque& deq)
+    {
+        static std::vector<int> buffer;
+        buffer.resize(deq.size());
+
+        my::copy(deq.begin(), deq.end(), buffer.data());
+        return buffer.back();
+    }
+
+    template <typename Deque>
+    long long find(const Deque& deq)
+    {
+        // Value is not in the deque, so every element is checked
+        return my::find(deq.begin(), deq.end(), -1) - deq.begin();
+    }
+
+    template <typename Deque>
+    long long for_each(const Deque& deq)
+    {
+        long long sum = 0;
+        my::for_each(deq.begin(), deq.end(), [&sum](int element) { sum += element; });
+        return sum;
+    }
+
+    template <typename Scan>
+    void print_row(const char* name, const my::deque<int>& my_deque, const std::deque<int>& std_deque, int runs, Scan scan)
+    {
+        const auto my_time = measure(my_deque, runs, scan);
+        const auto std_time = measure(std_deque, runs, scan);
+
+        std::cout << std::left << std::setw(16) << name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(14) << my_time
+            << std::setw(14) << std_time
+            << '\n';
+    }
+}
+
+int main()
+{
+    constexpr std::size_t elements_count = 10'000'000;
+    constexpr int runs = 5;
+
+    const auto my_deque = make_deque<my::deque<int>>(elements_count);
+    const auto std_deque = make_deque<std::deque<int>>(elements_count);
+
+    std::cout << "scan of " << elements_count << " ints, ns per element\n";
+    std::cout << std::left << std::setw(16) << "scan"
+        << std::right << std::setw(14) << "my::deque"
+        << std::setw(14) << "std::deque"
+        << '\n';
+
+    print_row("range for", my_deque, std_deque, runs, [](const auto& deq) { return iterate(deq); });
+    print_row("accumulate", my_deque, std_deque, runs, [](const auto& deq) { return accumulate(deq); });
+    print_row("operator[]", my_deque, std_deque, runs, [](const auto& deq) { return index(deq); });
+    print_row("my::for_each", my_deque, std_deque, runs, [](const auto& deq) { return for_each(deq); });
+    print_row("my::copy", my_deque, std_deque, runs, [](const auto& deq) { return copy(deq); });
+    print_row("my::find", my_deque, std_deque, runs, [](const auto& deq) { return find(deq); });
+}
@@ -0,0 +1,73 @@
+// Measures durable enqueues per second of journaled_deque for different group commit sizes
+// Every commit is one write and one fdatasync, so throughput grows with number of records sharing it
+
+#include "toy_stl/journaled_deque.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+namespace
+{
+    struct Job
+    {
+        long long id;
+        long long payload[3];
+    };
+
+    // Returns millions of committed enqueues per second
+    double measure(const std::filesystem::path& directory, std::size_t commit_operations, std::size_t jobs_count)
+    {
+        std::filesystem::remove_all(directory);
+
+        my::deque_journal_options options;
+        options.commit_operations = commit_operations;
+        options.commit_interval = std::chrono::seconds(1);
+
+        my::journaled_deque<Job> journal(directory, options);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < jobs_count; i += 1) {
+            journal.push_back(Job { static_cast<long long>(i), { } });
+        }
+        journal.commit();
+        const auto end = std::chrono::steady_clock::now();
+
+        const std::chrono::duration<double> elapsed = end - start;
+        return jobs_count / elapsed.count() / 1'000'000;
+    }
+}
+
+int main()
+{
+    std::string name = (std::filesystem::temp_directory_path() / "toy_stl_journal_benchmark_XXXXXX").string();
+    const std::filesystem::path directory = ::mkdtemp(name.data());
+
+    std::cout << "durable enqueues of " << sizeof(Job) << " byte jobs, millions per second\n";
+    std::cout << std::left << std::setw(20) << "commit every"
+        << std::right << std::setw(14) << "jobs"
+        << std::setw(14) << "Mops/s"
+        << '\n';
+
+    // Fewer jobs for small batches, every commit waits for the disk
+    const std::pair<std::size_t, std::size_t> cases[] = {
+        { 1, 2'000 },
+        { 64, 100'000 },
+        { 4096, 2'000'000 },
+        { 65536, 2'000'000 }
+    };
+
+    for (const auto& [commit_operations, jobs_count] : cases) {
+        std::cout << std::left << std::setw(20) << commit_operations
+            << std::right << std::setw(14) << jobs_count
+            << std::fixed << std::setprecision(3)
+            << std::setw(14) << measure(directory / "journal", commit_operations, jobs_count)
+            << '\n';
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Compares a backlog queue in my::deque and in my::spill_deque, which keeps only blocks near the ends in RAM
+// Whole backlog is pushed first and then drained, so every cold block is written to a segment file and read back
+
+#include "toy_stl/deque.hpp"
+#include "toy_stl/spill_deque.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace
+{
+    volatile long long sink = 0;
+
+    struct Message
+    {
+        long long id;
+        double payload[7];
+    };
+
+    template <typename Queue>
+    long long fill_and_drain(Queue& queue, std::size_t messages_count)
+    {
+        for (std::size_t i = 0; i < messages_count; i += 1) {
+            queue.push_back(Message { static_cast<long long>(i), { } });
+        }
+
+        long long sum = 0;
+        while (!queue.empty()) {
+            sum += queue.front().id;
+            queue.pop_front();
+        }
+
+        return sum;
+    }
+
+    // Returns best time of several runs in nanoseconds per message
+    template <typename MakeQueue>
+    double measure(std::size_t messages_count, int runs, MakeQueue make_queue)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; run += 1) {
+            auto queue = make_queue();
+
+            const auto start = std::chrono::steady_clock::now();
+            sink = sink + fill_and_drain(*queue, messages_count);
+            const auto end = std::chrono::steady_clock::now();
+
+            const std::chrono::duration<double, std::nano> elapsed = end - start;
+            best = std::min(best, elapsed.count() / messages_count);
+        }
+
+        return best;
+    }
+}
+
+int main()
+{
+    constexpr std::size_t messages_count = 1'000'000;
+    constexpr int runs = 3;
+    const auto directory = std::filesystem::temp_directory_path();
+
+    std::cout << messages_count << " messages of " << sizeof(Message) << " bytes, ns per message\n";
+    std::cout << std::left << std::setw(28) << "queue"
+        << std::right << std::setw(14) << "time"
+        << '\n';
+
+    const auto print_row = [](const char* name, double time) {
+        std::cout << std::left << std::setw(28) << name
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(14) << time
+            << '\n';
+    };
+
+    print_row("my::deque", measure(messages_count, runs, [] {
+        return std::make_unique<my::deque<Message>>();
+    }));
+    print_row("my::spill_deque", measure(messages_count, runs, [&directory] {
+        return std::make_unique<my::spill_deque<Message>>(directory);
+    }));
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+// Measures throughput of spsc_queue with producer and consumer in different threads
+// Batched operations publish many elements with one atomic store, so they should be much faster on multicore machines
+
+#include "toy_stl/spsc_queue.hpp"
+
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <limits>
+
+namespace
+{
+    constexpr long messages_count = 20'000'000;
+
+    // Returns millions of messages per second
+    template <typename Produce, typename Consume>
+    double measure(Produce produce, Consume consume)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::thread producer(produce);
+        const long long sum = consume();
+        producer.join();
+
+        const auto end = std::chrono::steady_clock::now();
+
+        if (sum != static_cast<long long>(messages_count) * (messages_count - 1) / 2) {
+            std::cerr << "Wrong sum of messages\n";
+        }
+
+        const std::chrono::duration<double> elapsed = end - start;
+        return messages_count / elapsed.count() / 1e6;
+    }
+
+    double single(std::size_t capacity)
+    {
+        my::spsc_queue<long> queue(capacity);
+
+        return measure(
+            [&] {
+                for (long i = 0; i < messages_count; ++i) {
+                    while (!queue.try_push(i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            },
+            [&] {
+                long long sum = 0;
+                long value = 0;
+                for (long received = 0; received < messages_count;) {
+                    if (queue.try_pop(value)) {
+                        sum += value;
+                        ++received;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                return sum;
+            }
+        );
+    }
+
+    double batched(std::size_t capacity, std::size_t batch_size)
+    {
+        my::spsc_queue<long> queue(capacity);
+
+        return measure(
+            [&] {
+                std::vector<long> batch(batch_size);
+                for (long i = 0; i < messages_count;) {
+                    const auto size = std::min<long>(batch_size, messages_count - i);
+                    for (long j = 0; j < size; ++j) {
+                        batch[j] = i + j;
+                    }
+
+                    auto first = batch.begin();
+                    for (long pushed = 0; pushed < size;) {
+                        const auto n = queue.try_push_n(first + pushed, size - pushed);
+                        if (n == 0) {
+                            std::this_thread::yield();
+                        }
+                        pushed += n;
+                    }
+                    i += size;
+                }
+            },
+            [&] {
+                std::vector<long> batch(batch_size);
+                long long sum = 0;
+                for (long received = 0; received < messages_count;) {
+                    const auto n = queue.try_pop_n(batch.begin(), batch_size);
+                    if (n == 0) {
+                        std::this_thread::yield();
+                    }
+                    for (std::size_t j = 0; j < n; ++j) {
+                        sum += batch[j];
+                    }
+                    received += n;
+                }
+                return sum;
+            }
+        );
+    }
+
+    double unbounded(std::size_t batch_size)
+    {
+        my::unbounded_spsc_queue<long> queue;
+
+        return measure(
+            [&] {
+                for (long i = 0; i < messages_count; ++i) {
+                    queue.push(i);
+                }
+            },
+            [&] {
+                std::vector<long> batch(batch_size);
+                long long sum = 0;
+                for (long received = 0; received < messages_count;) {
+                    const auto n = queue.try_pop_n(batch.begin(), batch_size);
+                    if (n == 0) {
+                        std::this_thread::yield();
+                    }
+                    for (std::size_t j = 0; j < n; ++j) {
+                        sum += batch[j];
+                    }
+                    received += n;
+                }
+                return sum;
+            }
+        );
+    }
+
+    template <typename Run>
+    void print_row(const char* name, int runs, Run run)
+    {
+        double best = 0;
+        for (int i = 0; i < runs; ++i) {
+            best = std::max(best, run());
+        }
+
+        std::cout << std::left << std::setw(28) << name
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(14) << best
+            << '\n';
+    }
+}
+
+int main()
+{
+    constexpr int runs = 3;
+
+    std::cout << std::left << std::setw(28) << "operation"
+        << std::right << std::setw(14) << "Mmsg/s"
+        << '\n';
+
+    print_row("try_push / try_pop", runs, [] { return single(1 << 16); });
+    print_row("try_push_n / try_pop_n 64", runs, [] { return batched(1 << 16, 64); });
+    print_row("try_push_n / try_pop_n 1024", runs, [] { return batched(1 << 16, 1024); });
+    print_row("unbounded push / pop_n 64", runs, [] { return unbounded(64); });
+
+    return 0;
+}
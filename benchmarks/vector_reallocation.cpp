@@ -0,0 +1,98 @@
+// Compares cost of reallocation in my::vector and std::vector
+// Element types with noexcept move constructor should be as fast as in std::vector,
+// because move_if_noexcept is resolved at compile time
+// Types with throwing move constructor are copied on reallocation (in both implementations)
+
+#include "toy_stl/vector.hpp"
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    struct Record
+    {
+        long long key;
+        long long value;
+    };
+
+    struct NoexceptMove
+    {
+        NoexceptMove(int value) : payload(std::to_string(value)) { }
+        NoexceptMove(const NoexceptMove& other) = default;
+        NoexceptMove(NoexceptMove&& other) noexcept = default;
+
+        std::string payload;
+    };
+
+    struct ThrowingMove
+    {
+        ThrowingMove(int value) : payload(std::to_string(value)) { }
+        ThrowingMove(const ThrowingMove& other) = default;
+        ThrowingMove(ThrowingMove&& other) noexcept(false) : payload(std::move(other.payload)) { }
+
+        std::string payload;
+    };
+
+    // Returns best time of several runs in nanoseconds per element
+    template <typename Vector>
+    double measure_push_back(std::size_t elements_count, int runs)
+    {
+        using value_type = typename Vector::value_type;
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; run += 1) {
+            const auto start = std::chrono::steady_clock::now();
+
+            Vector vec;
+            for (std::size_t i = 0; i < elements_count; i += 1) {
+                if constexpr (std::is_same_v<value_type, Record>) {
+                    vec.push_back(Record { static_cast<long long>(i), static_cast<long long>(i) });
+                } else {
+                    vec.emplace_back(static_cast<int>(i));
+                }
+            }
+
+            const auto end = std::chrono::steady_clock::now();
+            const std::chrono::duration<double, std::nano> elapsed = end - start;
+            best = std::min(best, elapsed.count() / elements_count);
+        }
+
+        return best;
+    }
+
+    template <typename T>
+    void print_row(const char* name, std::size_t elements_count, int runs)
+    {
+        const auto my_time = measure_push_back<my::vector<T>>(elements_count, runs);
+        const auto std_time = measure_push_back<std::vector<T>>(elements_count, runs);
+
+        std::cout << std::left << std::setw(16) << name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(14) << my_time
+            << std::setw(14) << std_time
+            << '\n';
+    }
+}
+
+int main()
+{
+    constexpr std::size_t elements_count = 1'000'000;
+    constexpr int runs = 5;
+
+    std::cout << "push_back of " << elements_count << " elements, ns per element\n";
+    std::cout << std::left << std::setw(16) << "element type"
+        << std::right << std::setw(14) << "my::vector"
+        << std::setw(14) << "std::vector"
+        << '\n';
+
+    print_row<int>("int", elements_count, runs);
+    print_row<Record>("Record", elements_count, runs);
+    print_row<NoexceptMove>("noexcept move", elements_count, runs);
+    print_row<ThrowingMove>("throwing move", elements_count, runs);
+}
@@ -0,0 +1,95 @@
+// Compares owner-side operations of work_stealing_deque with std::deque behind a mutex, which is the usual simple task queue
+// Owner does not take any lock, only pop of the last element needs compare and swap
+
+#include "toy_stl/work_stealing_deque.hpp"
+
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    volatile long long sink = 0;
+
+    class locked_deque
+    {
+    public:
+        void push_bottom(long value)
+        {
+            std::lock_guard lock(mutex);
+            elements.push_back(value);
+        }
+
+        std::optional<long> pop_bottom()
+        {
+            std::lock_guard lock(mutex);
+            if (elements.empty()) {
+                return std::nullopt;
+            }
+
+            const auto value = elements.back();
+            elements.pop_back();
+            return value;
+        }
+
+    private:
+        std::mutex mutex;
+        std::deque<long> elements;
+    };
+
+    // Returns best time of several runs in nanoseconds per push and pop pair
+    // Tasks are pushed in bursts of burst_size and then popped, like in recursive fork-join
+    template <typename Deque>
+    double measure(int runs, std::size_t burst_size)
+    {
+        constexpr std::size_t operations_count = 10'000'000;
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; run += 1) {
+            Deque deq;
+            long long sum = 0;
+
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < operations_count; i += burst_size) {
+                for (std::size_t j = 0; j < burst_size; j += 1) {
+                    deq.push_bottom(static_cast<long>(i + j));
+                }
+                while (auto value = deq.pop_bottom()) {
+                    sum += *value;
+                }
+            }
+            const auto end = std::chrono::steady_clock::now();
+
+            sink = sink + sum;
+            const std::chrono::duration<double, std::nano> elapsed = end - start;
+            best = std::min(best, elapsed.count() / operations_count);
+        }
+
+        return best;
+    }
+}
+
+int main()
+{
+    constexpr int runs = 5;
+
+    std::cout << std::left << std::setw(12) << "burst"
+        << std::right << std::setw(20) << "work_stealing_deque"
+        << std::setw(20) << "mutex + std::deque"
+        << '\n';
+
+    for (std::size_t burst_size : { 1, 16, 1024 }) {
+        std::cout << std::left << std::setw(12) << burst_size
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(20) << measure<my::work_stealing_deque<long>>(runs, burst_size)
+            << std::setw(20) << measure<locked_deque>(runs, burst_size)
+            << '\n';
+    }
+
+    return 0;
+}
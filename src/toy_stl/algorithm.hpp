@@ -1,8 +1,15 @@
 #ifndef TOY_SDL_ALGORITHM_HPP
 #define TOY_SDL_ALGORITHM_HPP
 
+#include "type_traits.hpp"
+
 #include <algorithm>
 #include <compare>
+#include <cstring>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
 
 namespace my
 {
@@ -33,8 +40,9 @@ namespace my
     template <typename T, typename U = T>
     using synth_three_way_result = decltype(synth_three_way{ }(std::declval<T&>(), std::declval<U&>()));
 
+    // Compares element by element, used when neither range is segmented
     template <class InputIt1, class InputIt2, class Cmp>
-    constexpr auto lexicographical_compare_three_way(
+    constexpr auto elementwise_compare_three_way(
         InputIt1 first1, InputIt1 last1,
         InputIt2 first2, InputIt2 last2,
         Cmp comp
@@ -63,6 +71,272 @@ namespace my
         // If mismatch was found we compare it
         return comp(*mismatch1, *mismatch2);
     }
+
+    // Comparisons of contiguous ranges of bitwise comparable types that use memcmp
+    // memcmp is vectorized by the C library, so this is much faster than comparing element by element
+    // Not usable in constant evaluation
+    template <typename T>
+        requires is_bitwise_comparable_v<T>
+    bool bitwise_equal(const T* first1, const T* first2, std::size_t count)
+    {
+        // memcmp with nullptr is undefined even for 0 bytes
+        return count == 0 || std::memcmp(first1, first2, count * sizeof(T)) == 0;
+    }
+
+    template <typename T>
+        requires is_bitwise_comparable_v<T> && std::three_way_comparable<T>
+    std::compare_three_way_result_t<T> bitwise_compare_three_way(
+        const T* first1, std::size_t count1,
+        const T* first2, std::size_t count2
+    )
+    {
+        using ordering = std::compare_three_way_result_t<T>;
+        const auto common_count = std::min(count1, count2);
+
+        // Order of bytes is the same as order of values only for unsigned single byte types
+        constexpr bool is_bytewise_ordered =
+            sizeof(T) == 1 && (std::is_unsigned_v<T> || std::is_same_v<T, std::byte>);
+
+        if constexpr (is_bytewise_ordered) {
+            if (common_count != 0) {
+                if (const auto result = std::memcmp(first1, first2, common_count); result != 0) {
+                    return result < 0 ? ordering::less : ordering::greater;
+                }
+            }
+        } else {
+            // Equal chunks are skipped with memcmp, then first mismatching element of a chunk is compared with <=>
+            constexpr std::size_t chunk_size = std::max(std::size_t { 256 } / sizeof(T), std::size_t { 1 });
+
+            for (std::size_t i = 0; i < common_count; i += chunk_size) {
+                const auto count = std::min(chunk_size, common_count - i);
+                if (std::memcmp(first1 + i, first2 + i, count * sizeof(T)) == 0) {
+                    continue;
+                }
+
+                for (std::size_t j = i; j < i + count; ++j) {
+                    if (first1[j] != first2[j]) {
+                        return first1[j] <=> first2[j];
+                    }
+                }
+            }
+        }
+
+        return static_cast<ordering>(count1 <=> count2);
+    }
+
+    // Segmented iterators walk over a sequence of contiguous parts, like blocks of deque
+    // Containers specialize this trait with segments(first, last) which returns range of std::span covering [first, last) in order
+    // Then algorithms below run on pointers inside of every segment, which can be vectorized or turned into memcpy and memcmp
+    template <typename It>
+    struct segmented_iterator_traits
+    {
+        constexpr static bool is_segmented = false;
+    };
+
+    template <typename It>
+    concept segmented_iterator = std::random_access_iterator<It> && segmented_iterator_traits<It>::is_segmented;
+
+    // Splits [first1, first1 + count) and [first2, first2 + count) into the largest pieces that are contiguous in both ranges
+    // Calls f(piece1, piece2, size) for every piece, where piece is a pointer for segmented range and iterator otherwise
+    // Stops when f returns false, returns false in that case
+    template <std::random_access_iterator It1, std::random_access_iterator It2, typename F>
+    constexpr bool for_each_common_segment(It1 first1, It2 first2, std::iter_difference_t<It1> count, F f)
+    {
+        if constexpr (segmented_iterator<It1> && segmented_iterator<It2>) {
+            auto segments1 = segmented_iterator_traits<It1>::segments(first1, first1 + count);
+            auto segments2 = segmented_iterator_traits<It2>::segments(first2, first2 + count);
+            auto current1 = segments1.begin();
+            auto current2 = segments2.begin();
+
+            if (count == 0) {
+                return true;
+            }
+
+            auto piece1 = *current1;
+            auto piece2 = *current2;
+            while (true) {
+                const auto size = std::min(piece1.size(), piece2.size());
+                if (!f(piece1.data(), piece2.data(), size)) {
+                    return false;
+                }
+
+                piece1 = piece1.subspan(size);
+                piece2 = piece2.subspan(size);
+
+                if (piece1.empty()) {
+                    if (++current1 == segments1.end()) {
+                        return true;
+                    }
+                    piece1 = *current1;
+                }
+
+                if (piece2.empty()) {
+                    piece2 = *++current2;
+                }
+            }
+        } else if constexpr (segmented_iterator<It1>) {
+            for (const auto segment : segmented_iterator_traits<It1>::segments(first1, first1 + count)) {
+                const auto size = static_cast<std::iter_difference_t<It2>>(segment.size());
+                if (!f(segment.data(), first2, segment.size())) {
+                    return false;
+                }
+                first2 += size;
+            }
+
+            return true;
+        } else if constexpr (segmented_iterator<It2>) {
+            for (const auto segment : segmented_iterator_traits<It2>::segments(first2, first2 + count)) {
+                const auto size = static_cast<std::iter_difference_t<It1>>(segment.size());
+                if (!f(first1, segment.data(), segment.size())) {
+                    return false;
+                }
+                first1 += size;
+            }
+
+            return true;
+        } else {
+            return f(first1, first2, static_cast<std::size_t>(count));
+        }
+    }
+
+    template <std::input_iterator InputIt, typename F>
+    constexpr F for_each(InputIt first, InputIt last, F f)
+    {
+        if constexpr (segmented_iterator<InputIt>) {
+            for (const auto segment : segmented_iterator_traits<InputIt>::segments(first, last)) {
+                // Function object is passed by reference, so its state is kept between segments
+                std::for_each(segment.data(), segment.data() + segment.size(), std::ref(f));
+            }
+
+            return f;
+        } else {
+            return std::for_each(first, last, std::move(f));
+        }
+    }
+
+    template <std::input_iterator InputIt, std::weakly_incrementable OutputIt>
+    constexpr OutputIt copy(InputIt first, InputIt last, OutputIt out)
+    {
+        if constexpr (segmented_iterator<InputIt>) {
+            // Every segment is copied with std::copy on pointers, which is memmove for trivially copyable types
+            for (const auto segment : segmented_iterator_traits<InputIt>::segments(first, last)) {
+                out = std::copy(segment.data(), segment.data() + segment.size(), out);
+            }
+
+            return out;
+        } else {
+            return std::copy(first, last, out);
+        }
+    }
+
+    template <std::forward_iterator ForwardIt, typename T>
+    constexpr void fill(ForwardIt first, ForwardIt last, const T& value)
+    {
+        if constexpr (segmented_iterator<ForwardIt>) {
+            for (const auto segment : segmented_iterator_traits<ForwardIt>::segments(first, last)) {
+                std::fill(segment.data(), segment.data() + segment.size(), value);
+            }
+        } else {
+            std::fill(first, last, value);
+        }
+    }
+
+    template <std::input_iterator InputIt, typename T>
+    constexpr InputIt find(InputIt first, InputIt last, const T& value)
+    {
+        if constexpr (segmented_iterator<InputIt>) {
+            std::iter_difference_t<InputIt> skipped = 0;
+            for (const auto segment : segmented_iterator_traits<InputIt>::segments(first, last)) {
+                const auto segment_end = segment.data() + segment.size();
+                const auto found = std::find(segment.data(), segment_end, value);
+                if (found != segment_end) {
+                    return first + (skipped + (found - segment.data()));
+                }
+
+                skipped += static_cast<std::iter_difference_t<InputIt>>(segment.size());
+            }
+
+            return last;
+        } else {
+            return std::find(first, last, value);
+        }
+    }
+
+    template <std::input_iterator InputIt1, std::input_iterator InputIt2>
+    constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2)
+    {
+        if constexpr ((segmented_iterator<InputIt1> || segmented_iterator<InputIt2>)
+            && std::random_access_iterator<InputIt1> && std::random_access_iterator<InputIt2>) {
+            // std::equal on pointers to the same integral type is memcmp
+            return for_each_common_segment(first1, first2, last1 - first1, [](auto piece1, auto piece2, std::size_t size) {
+                return std::equal(piece1, piece1 + size, piece2);
+            });
+        } else {
+            return std::equal(first1, last1, first2);
+        }
+    }
+
+    template <std::input_iterator InputIt1, std::input_iterator InputIt2>
+    constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2)
+    {
+        if constexpr (std::random_access_iterator<InputIt1> && std::random_access_iterator<InputIt2>) {
+            if (last1 - first1 != last2 - first2) {
+                return false;
+            }
+
+            return my::equal(first1, last1, first2);
+        } else {
+            return std::equal(first1, last1, first2, last2);
+        }
+    }
+
+    template <class InputIt1, class InputIt2, class Cmp>
+    constexpr auto lexicographical_compare_three_way(
+        InputIt1 first1, InputIt1 last1,
+        InputIt2 first2, InputIt2 last2,
+        Cmp comp
+    ) -> decltype(comp(*first1, *first2))
+    {
+        using ordering = decltype(comp(*first1, *first2));
+
+        if constexpr ((segmented_iterator<InputIt1> || segmented_iterator<InputIt2>)
+            && std::random_access_iterator<InputIt1> && std::random_access_iterator<InputIt2>) {
+            const auto count1 = last1 - first1;
+            const auto count2 = last2 - first2;
+            const auto common_count = std::min<std::iter_difference_t<InputIt1>>(count1, count2);
+
+            ordering result = std::strong_ordering::equal;
+            for_each_common_segment(first1, first2, common_count, [&](auto piece1, auto piece2, std::size_t size) {
+                using piece1_type = decltype(piece1);
+                using element_type = std::remove_cvref_t<decltype(*piece1)>;
+
+                // Contiguous pieces of bitwise comparable types are compared with memcmp
+                constexpr bool is_default_comparison =
+                    std::is_same_v<Cmp, synth_three_way> || std::is_same_v<Cmp, std::compare_three_way>;
+                constexpr bool is_bitwise_piece =
+                    std::is_pointer_v<piece1_type> && std::is_same_v<piece1_type, decltype(piece2)>
+                    && is_bitwise_comparable_v<element_type>;
+
+                if constexpr (is_default_comparison && is_bitwise_piece) {
+                    if (!std::is_constant_evaluated()) {
+                        result = bitwise_compare_three_way(piece1, size, piece2, size);
+                        return result == 0;
+                    }
+                }
+
+                result = elementwise_compare_three_way(piece1, piece1 + size, piece2, piece2 + size, comp);
+                return result == 0;
+            });
+
+            if (result != 0) {
+                return result;
+            }
+
+            return count1 <=> count2;
+        } else {
+            return elementwise_compare_three_way(first1, last1, first2, last2, comp);
+        }
+    }
 }
 
 #endif /* TOY_SDL_ALGORITHM_HPP */
@@ -0,0 +1,13 @@
+#ifndef TOY_SDL_CACHE_LINE_HPP
+#define TOY_SDL_CACHE_LINE_HPP
+
+#include <cstddef>
+
+namespace my
+{
+    // Fixed instead of std::hardware_destructive_interference_size, which changes with compiler flags
+    // Data written by different threads is aligned to it, so that threads do not invalidate each other's cache lines
+    constexpr std::size_t cache_line_size = 64;
+}
+
+#endif /* TOY_SDL_CACHE_LINE_HPP */
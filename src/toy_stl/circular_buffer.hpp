@@ -0,0 +1,534 @@
+#ifndef TOY_SDL_CIRCULAR_BUFFER_HPP
+#define TOY_SDL_CIRCULAR_BUFFER_HPP
+
+#include "circular_buffer_data.hpp"
+#include "circular_buffer_iterator.hpp"
+#include "iterator.hpp"
+#include "algorithm.hpp"
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+namespace my
+{
+    // Keeps the last capacity elements, for example recent events for telemetry
+    // Memory is allocated once in constructor, push_back into full buffer assigns over the oldest element in place,
+    // so there is no destruction, construction or allocation on the hot path
+    // Elements occupy at most two contiguous parts of the ring, segments() gives them for bulk processing
+    template <typename T, typename Allocator = std::allocator<T>>
+    class circular_buffer
+    {
+    public:
+        // Member types
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = std::allocator_traits<Allocator>::pointer;
+        using const_pointer = std::allocator_traits<Allocator>::const_pointer;
+
+        // Implementation specific type aliases
+        using circular_buffer_data_type = circular_buffer_data<value_type, size_type>;
+
+        // Iterator types
+        using iterator = circular_buffer_iterator<circular_buffer>;
+        using const_iterator = my::const_iterator<iterator>;
+        using reverse_iterator = my::reverse_iterator<iterator>;
+        using const_reverse_iterator = my::const_iterator<reverse_iterator>;
+
+        // Older elements first, second segment is empty if elements do not wrap around the end of memory
+        using segments_type = std::array<std::span<T>, 2>;
+        using const_segments_type = std::array<std::span<const T>, 2>;
+
+        // Constructors
+        constexpr explicit circular_buffer(size_type capacity, const Allocator& allocator = Allocator());
+
+        // Rule of 5
+        constexpr circular_buffer(const circular_buffer& other);
+        constexpr circular_buffer& operator=(const circular_buffer& other);
+
+        // Moved from buffer has no capacity and can only be assigned to or destroyed
+        constexpr circular_buffer(circular_buffer&& other) noexcept;
+        constexpr circular_buffer& operator=(circular_buffer&& other) noexcept;
+
+        constexpr ~circular_buffer();
+
+        // Other
+        constexpr allocator_type get_allocator() const noexcept;
+        constexpr void swap(circular_buffer& other) noexcept;
+
+        // Element access
+        constexpr reference operator[](size_type index);
+        constexpr const_reference operator[](size_type index) const;
+
+        constexpr reference at(size_type index);
+        constexpr const_reference at(size_type index) const;
+
+        constexpr reference front();
+        constexpr const_reference front() const;
+
+        constexpr reference back();
+        constexpr const_reference back() const;
+
+        constexpr segments_type segments() noexcept;
+        constexpr const_segments_type segments() const noexcept;
+
+        // Capacity
+        [[nodiscard]] constexpr bool empty() const noexcept;
+        constexpr bool full() const noexcept;
+        constexpr size_type size() const noexcept;
+        constexpr size_type capacity() const noexcept;
+
+        // Modifiers
+        constexpr void clear() noexcept;
+
+        // When buffer is full, the oldest element is overwritten and becomes the newest
+        constexpr void push_back(const T& value);
+        constexpr void push_back(T&& value);
+        template <typename ... Args>
+        constexpr reference emplace_back(Args&& ... args);
+
+        constexpr void pop_front();
+        constexpr void pop_back();
+        // Removes count oldest elements, usually after they were processed through segments()
+        constexpr void pop_front_n(size_type count);
+
+        // Iterators
+        constexpr iterator begin() noexcept;
+        constexpr const_iterator begin() const noexcept;
+        constexpr const_iterator cbegin() const noexcept;
+
+        constexpr iterator end() noexcept;
+        constexpr const_iterator end() const noexcept;
+        constexpr const_iterator cend() const noexcept;
+
+        constexpr reverse_iterator rbegin() noexcept;
+        constexpr const_reverse_iterator rbegin() const noexcept;
+        constexpr const_reverse_iterator crbegin() const noexcept;
+
+        constexpr reverse_iterator rend() noexcept;
+        constexpr const_reverse_iterator rend() const noexcept;
+        constexpr const_reverse_iterator crend() const noexcept;
+
+    private:
+        constexpr size_type calculate_end_index() const;
+        // Assigns value to the oldest element and makes it the newest one
+        template <typename U>
+        constexpr reference overwrite_oldest(U&& value);
+        constexpr void destroy_all_elements() noexcept;
+        constexpr void deallocate_memory() noexcept;
+
+        [[no_unique_address]] Allocator allocator;
+        circular_buffer_data_type data;
+    };
+
+
+    // Constructors
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::circular_buffer(size_type capacity, const Allocator& allocator) :
+        allocator(allocator)
+    {
+        assert((capacity > 0) && "Circular buffer must be able to hold at least one element");
+
+        data.elements = std::allocator_traits<Allocator>::allocate(this->allocator, capacity);
+        data.capacity = capacity;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::circular_buffer(const circular_buffer& other) :
+        circular_buffer(other.capacity(), std::allocator_traits<Allocator>::select_on_container_copy_construction(other.allocator))
+    {
+        // Elements are copied to the start of memory
+        // Destructor is called if this throws, because delegated constructor has already finished
+        for (const auto& element : other) {
+            std::allocator_traits<Allocator>::construct(allocator, data.elements + data.elements_count, element);
+            ++data.elements_count;
+        }
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>& circular_buffer<T, Allocator>::operator=(const circular_buffer& other)
+    {
+        if (this != &other) {
+            circular_buffer copy(other);
+            swap(copy);
+        }
+
+        return *this;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::circular_buffer(circular_buffer&& other) noexcept :
+        allocator(std::move(other.allocator)),
+        data(std::exchange(other.data, circular_buffer_data_type { }))
+    {
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>& circular_buffer<T, Allocator>::operator=(circular_buffer&& other) noexcept
+    {
+        if (this != &other) {
+            circular_buffer moved(std::move(other));
+            swap(moved);
+        }
+
+        return *this;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::~circular_buffer()
+    {
+        destroy_all_elements();
+        deallocate_memory();
+    }
+
+
+    // Other
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::allocator_type circular_buffer<T, Allocator>::get_allocator() const noexcept
+    {
+        return allocator;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr void circular_buffer<T, Allocator>::swap(circular_buffer& other) noexcept
+    {
+        using std::swap;
+        swap(allocator, other.allocator);
+        swap(data, other.data);
+    }
+
+
+    // Element access
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::reference circular_buffer<T, Allocator>::operator[](size_type index)
+    {
+        assert((index < data.elements_count) && "Invalid element index");
+        return data.elements[data.calculate_next_index(data.begin_index, index)];
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_reference circular_buffer<T, Allocator>::operator[](size_type index) const
+    {
+        assert((index < data.elements_count) && "Invalid element index");
+        return data.elements[data.calculate_next_index(data.begin_index, index)];
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::reference circular_buffer<T, Allocator>::at(size_type index)
+    {
+        if (index >= data.elements_count) {
+            throw std::out_of_range("Invalid element index");
+        }
+
+        return (*this)[index];
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_reference circular_buffer<T, Allocator>::at(size_type index) const
+    {
+        if (index >= data.elements_count) {
+            throw std::out_of_range("Invalid element index");
+        }
+
+        return (*this)[index];
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::reference circular_buffer<T, Allocator>::front()
+    {
+        assert((!empty()) && "Buffer is empty");
+        return data.elements[data.begin_index];
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_reference circular_buffer<T, Allocator>::front() const
+    {
+        assert((!empty()) && "Buffer is empty");
+        return data.elements[data.begin_index];
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::reference circular_buffer<T, Allocator>::back()
+    {
+        assert((!empty()) && "Buffer is empty");
+        return (*this)[data.elements_count - 1];
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_reference circular_buffer<T, Allocator>::back() const
+    {
+        assert((!empty()) && "Buffer is empty");
+        return (*this)[data.elements_count - 1];
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::segments_type circular_buffer<T, Allocator>::segments() noexcept
+    {
+        const auto first_size = std::min(data.elements_count, data.capacity - data.begin_index);
+        return segments_type {
+            std::span<T>(data.elements + data.begin_index, first_size),
+            std::span<T>(data.elements, data.elements_count - first_size)
+        };
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_segments_type circular_buffer<T, Allocator>::segments() const noexcept
+    {
+        const auto first_size = std::min(data.elements_count, data.capacity - data.begin_index);
+        return const_segments_type {
+            std::span<const T>(data.elements + data.begin_index, first_size),
+            std::span<const T>(data.elements, data.elements_count - first_size)
+        };
+    }
+
+
+    // Capacity
+    template <typename T, typename Allocator>
+    constexpr bool circular_buffer<T, Allocator>::empty() const noexcept
+    {
+        return data.elements_count == 0;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr bool circular_buffer<T, Allocator>::full() const noexcept
+    {
+        return data.elements_count == data.capacity;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::size_type circular_buffer<T, Allocator>::size() const noexcept
+    {
+        return data.elements_count;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::size_type circular_buffer<T, Allocator>::capacity() const noexcept
+    {
+        return data.capacity;
+    }
+
+
+    // Modifiers
+    template <typename T, typename Allocator>
+    constexpr void circular_buffer<T, Allocator>::clear() noexcept
+    {
+        destroy_all_elements();
+        data.begin_index = 0;
+        data.elements_count = 0;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr void circular_buffer<T, Allocator>::push_back(const T& value)
+    {
+        if (full()) {
+            overwrite_oldest(value);
+        } else {
+            emplace_back(value);
+        }
+    }
+
+    template <typename T, typename Allocator>
+    constexpr void circular_buffer<T, Allocator>::push_back(T&& value)
+    {
+        if (full()) {
+            overwrite_oldest(std::move(value));
+        } else {
+            emplace_back(std::move(value));
+        }
+    }
+
+    template <typename T, typename Allocator>
+    template <typename ... Args>
+    constexpr circular_buffer<T, Allocator>::reference circular_buffer<T, Allocator>::emplace_back(Args&& ... args)
+    {
+        if (full()) {
+            // Arguments may refer to elements, so the new value is made before anything is overwritten
+            T value(std::forward<Args>(args) ...);
+            return overwrite_oldest(std::move(value));
+        }
+
+        const auto end_index = calculate_end_index();
+        std::allocator_traits<Allocator>::construct(allocator, data.elements + end_index, std::forward<Args>(args) ...);
+        ++data.elements_count;
+
+        return data.elements[end_index];
+    }
+
+    template <typename T, typename Allocator>
+    constexpr void circular_buffer<T, Allocator>::pop_front()
+    {
+        assert((!empty()) && "Buffer is empty");
+
+        std::allocator_traits<Allocator>::destroy(allocator, data.elements + data.begin_index);
+        data.begin_index = data.calculate_next_index(data.begin_index);
+        --data.elements_count;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr void circular_buffer<T, Allocator>::pop_back()
+    {
+        assert((!empty()) && "Buffer is empty");
+
+        std::allocator_traits<Allocator>::destroy(allocator, std::addressof(back()));
+        --data.elements_count;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr void circular_buffer<T, Allocator>::pop_front_n(size_type count)
+    {
+        assert((count <= data.elements_count) && "Buffer has less elements");
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < count; ++i) {
+                std::allocator_traits<Allocator>::destroy(allocator, data.elements + data.calculate_next_index(data.begin_index, i));
+            }
+        }
+
+        data.begin_index = data.calculate_next_index(data.begin_index, count);
+        data.elements_count -= count;
+    }
+
+
+    // Iterators
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::iterator circular_buffer<T, Allocator>::begin() noexcept
+    {
+        return iterator(&data, 0);
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_iterator circular_buffer<T, Allocator>::begin() const noexcept
+    {
+        // Same trick as in deque
+        return const_iterator(iterator(const_cast<circular_buffer_data_type*>(&data), 0));
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_iterator circular_buffer<T, Allocator>::cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::iterator circular_buffer<T, Allocator>::end() noexcept
+    {
+        return iterator(&data, data.elements_count);
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_iterator circular_buffer<T, Allocator>::end() const noexcept
+    {
+        return const_iterator(iterator(const_cast<circular_buffer_data_type*>(&data), data.elements_count));
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_iterator circular_buffer<T, Allocator>::cend() const noexcept
+    {
+        return end();
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::reverse_iterator circular_buffer<T, Allocator>::rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_reverse_iterator circular_buffer<T, Allocator>::rbegin() const noexcept
+    {
+        return const_reverse_iterator(reverse_iterator(iterator(const_cast<circular_buffer_data_type*>(&data), data.elements_count)));
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_reverse_iterator circular_buffer<T, Allocator>::crbegin() const noexcept
+    {
+        return rbegin();
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::reverse_iterator circular_buffer<T, Allocator>::rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_reverse_iterator circular_buffer<T, Allocator>::rend() const noexcept
+    {
+        return const_reverse_iterator(reverse_iterator(iterator(const_cast<circular_buffer_data_type*>(&data), 0)));
+    }
+
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::const_reverse_iterator circular_buffer<T, Allocator>::crend() const noexcept
+    {
+        return rend();
+    }
+
+
+    // Non-member functions
+    template <class T, class Allocator>
+    constexpr bool operator==(const circular_buffer<T, Allocator>& a, const circular_buffer<T, Allocator>& b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+
+    template <class T, class Allocator>
+    constexpr my::synth_three_way_result<T> operator<=>(const circular_buffer<T, Allocator>& a, const circular_buffer<T, Allocator>& b)
+    {
+        return my::lexicographical_compare_three_way(
+            a.begin(), a.end(),
+            b.begin(), b.end(),
+            my::synth_three_way { }
+        );
+    }
+
+
+    // Implementation details
+    template <typename T, typename Allocator>
+    constexpr circular_buffer<T, Allocator>::size_type circular_buffer<T, Allocator>::calculate_end_index() const
+    {
+        assert((!full()) && "Buffer is full, end index would be equal to begin index");
+        return data.calculate_next_index(data.begin_index, data.elements_count);
+    }
+
+    template <typename T, typename Allocator>
+    template <typename U>
+    constexpr circular_buffer<T, Allocator>::reference circular_buffer<T, Allocator>::overwrite_oldest(U&& value)
+    {
+        assert((full()) && "Only full buffer overwrites elements");
+
+        // Begin moves only after assignment, so if it throws, the element is still the oldest one and order is kept
+        auto& oldest = data.elements[data.begin_index];
+        oldest = std::forward<U>(value);
+        data.begin_index = data.calculate_next_index(data.begin_index);
+        return oldest;
+    }
+
+    template <typename T, typename Allocator>
+    constexpr void circular_buffer<T, Allocator>::destroy_all_elements() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < data.elements_count; ++i) {
+                std::allocator_traits<Allocator>::destroy(allocator, data.elements + data.calculate_next_index(data.begin_index, i));
+            }
+        }
+    }
+
+    template <typename T, typename Allocator>
+    constexpr void circular_buffer<T, Allocator>::deallocate_memory() noexcept
+    {
+        if (data.elements != nullptr) {
+            std::allocator_traits<Allocator>::deallocate(allocator, data.elements, data.capacity);
+        }
+    }
+}
+
+#endif /* TOY_SDL_CIRCULAR_BUFFER_HPP */
@@ -0,0 +1,47 @@
+#ifndef TOY_SDL_CIRCULAR_BUFFER_DATA_HPP
+#define TOY_SDL_CIRCULAR_BUFFER_DATA_HPP
+
+#include <cassert>
+
+namespace my
+{
+    template <typename value_type, typename size_type>
+    struct circular_buffer_data
+    {
+        // Single array of capacity elements, used as a ring
+        // Unlike deque_data capacity is not rounded to power of two, because "last N elements" should mean exactly N
+        value_type* elements { nullptr };
+        size_type capacity { 0 };
+        // Range is exclusive - [begin_index, begin_index + elements_count) and supports wrapping around
+        size_type begin_index { 0 };
+        size_type elements_count { 0 };
+
+        // Maps index in range [0, 2 * capacity) to range [0, capacity)
+        constexpr size_type wrap_index(size_type index) const;
+        constexpr size_type calculate_next_index(size_type current_index, size_type offset = 1) const;
+        constexpr size_type calculate_previous_index(size_type current_index, size_type offset = 1) const;
+    };
+
+    template <typename value_type, typename size_type>
+    constexpr size_type circular_buffer_data<value_type, size_type>::wrap_index(size_type index) const
+    {
+        assert((index < 2 * capacity) && "Index is too far from the ring");
+        return index >= capacity ? index - capacity : index;
+    }
+
+    template <typename value_type, typename size_type>
+    constexpr size_type circular_buffer_data<value_type, size_type>::calculate_next_index(size_type current_index, size_type offset) const
+    {
+        assert((offset <= capacity) && "Invalid offset");
+        return wrap_index(current_index + offset);
+    }
+
+    template <typename value_type, typename size_type>
+    constexpr size_type circular_buffer_data<value_type, size_type>::calculate_previous_index(size_type current_index, size_type offset) const
+    {
+        assert((offset <= capacity) && "Invalid offset");
+        return wrap_index(current_index + capacity - offset);
+    }
+}
+
+#endif /* TOY_SDL_CIRCULAR_BUFFER_DATA_HPP */
@@ -0,0 +1,167 @@
+#ifndef TOY_SDL_CIRCULAR_BUFFER_ITERATOR_HPP
+#define TOY_SDL_CIRCULAR_BUFFER_ITERATOR_HPP
+
+#include "circular_buffer_data.hpp"
+
+#include <compare>
+#include <iterator>
+
+namespace my
+{
+    template <typename Buf>
+    class circular_buffer_iterator
+    {
+    private:
+        using circular_buffer_data_type = typename Buf::circular_buffer_data_type;
+        using size_type = typename Buf::size_type;
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+
+        using value_type = typename Buf::value_type;
+        using difference_type = typename Buf::difference_type;
+        using pointer = typename Buf::pointer;
+        using reference = typename Buf::reference;
+        using element_type = value_type;
+
+        constexpr circular_buffer_iterator() = default;
+        constexpr circular_buffer_iterator(circular_buffer_data_type* data, size_type index);
+
+        constexpr bool operator==(const circular_buffer_iterator& other) const;
+        constexpr std::strong_ordering operator<=>(const circular_buffer_iterator& other) const;
+
+        constexpr circular_buffer_iterator& operator++();
+        constexpr circular_buffer_iterator operator++(int);
+
+        constexpr circular_buffer_iterator& operator--();
+        constexpr circular_buffer_iterator operator--(int);
+
+        constexpr circular_buffer_iterator& operator+=(difference_type n);
+        constexpr circular_buffer_iterator& operator-=(difference_type n);
+
+        constexpr circular_buffer_iterator operator+(difference_type n) const;
+        constexpr circular_buffer_iterator operator-(difference_type n) const;
+        constexpr difference_type operator-(const circular_buffer_iterator& other) const;
+        friend constexpr circular_buffer_iterator operator+(difference_type n, const circular_buffer_iterator& i)
+        {
+            return i + n;
+        }
+
+        constexpr reference operator[](difference_type n) const;
+        constexpr reference operator*() const;
+        constexpr pointer operator->() const;
+
+    private:
+        circular_buffer_data_type* data { nullptr };
+        // Index is relative to begin_index, so comparisons do not depend on wrapping
+        size_type index { 0 };
+    };
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf>::circular_buffer_iterator(circular_buffer_data_type* data, size_type index) :
+        data(data),
+        index(index)
+    {
+    }
+
+    template <typename Buf>
+    constexpr bool circular_buffer_iterator<Buf>::operator==(const circular_buffer_iterator& other) const
+    {
+        assert((data == other.data) && "Iterators point to different containers");
+        return index == other.index;
+    }
+
+    template <typename Buf>
+    constexpr std::strong_ordering circular_buffer_iterator<Buf>::operator<=>(const circular_buffer_iterator& other) const
+    {
+        assert((data == other.data) && "Iterators point to different containers");
+        return index <=> other.index;
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf>& circular_buffer_iterator<Buf>::operator++()
+    {
+        ++index;
+        return *this;
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf> circular_buffer_iterator<Buf>::operator++(int)
+    {
+        const auto copy = *this;
+        ++index;
+        return copy;
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf>& circular_buffer_iterator<Buf>::operator--()
+    {
+        --index;
+        return *this;
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf> circular_buffer_iterator<Buf>::operator--(int)
+    {
+        const auto copy = *this;
+        --index;
+        return copy;
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf>& circular_buffer_iterator<Buf>::operator+=(difference_type n)
+    {
+        index += n;
+        return *this;
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf>& circular_buffer_iterator<Buf>::operator-=(difference_type n)
+    {
+        index -= n;
+        return *this;
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf> circular_buffer_iterator<Buf>::operator+(difference_type n) const
+    {
+        auto copy = *this;
+        copy += n;
+        return copy;
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf> circular_buffer_iterator<Buf>::operator-(difference_type n) const
+    {
+        auto copy = *this;
+        copy -= n;
+        return copy;
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf>::difference_type circular_buffer_iterator<Buf>::operator-(const circular_buffer_iterator& other) const
+    {
+        return static_cast<difference_type>(index - other.index);
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf>::reference circular_buffer_iterator<Buf>::operator[](difference_type n) const
+    {
+        return *(*this + n);
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf>::reference circular_buffer_iterator<Buf>::operator*() const
+    {
+        return data->elements[data->calculate_next_index(data->begin_index, index)];
+    }
+
+    template <typename Buf>
+    constexpr circular_buffer_iterator<Buf>::pointer circular_buffer_iterator<Buf>::operator->() const
+    {
+        return data->elements + data->calculate_next_index(data->begin_index, index);
+    }
+}
+
+#endif /* TOY_SDL_CIRCULAR_BUFFER_ITERATOR_HPP */
@@ -3,12 +3,19 @@
 
 #include "deque_data.hpp"
 #include "deque_iterator.hpp"
+#include "deque_block_pool.hpp"
+#include "deque_segments.hpp"
 #include "iterator.hpp"
 #include "algorithm.hpp"
+#include "ranges.hpp"
 
 #include <memory>
 #include <cassert>
 #include <stdexcept>
+#include <new>
+#include <algorithm>
+#include <bit>
+#include <limits>
 
 namespace my
 {
@@ -18,13 +25,23 @@ namespace my
         return (a + b - 1) / b;
     }
 
-    template <typename T, typename Allocator = std::allocator<T>>
+    // Snapshot of how deque uses its circular array of blocks
+    struct deque_block_map_stats
+    {
+        std::size_t map_size; // Number of slots in array of blocks
+        std::size_t allocated_blocks; // Blocks with or without elements
+        std::size_t used_blocks; // Blocks between begin block and the block of the last element
+        std::size_t map_reallocations; // How many times array of blocks was replaced by growth or shrink_to_fit
+    };
+
+    template <typename T, typename Allocator = std::allocator<T>, block_size_policy BlockSizePolicy = default_block_size>
     class deque
     {
     public:
         // Member types
         using value_type = T;
         using allocator_type = Allocator;
+        using block_size_policy_type = BlockSizePolicy;
         using size_type = std::size_t;
         using difference_type = std::ptrdiff_t;
         using reference = value_type&;
@@ -33,7 +50,7 @@ namespace my
         using const_pointer = std::allocator_traits<Allocator>::const_pointer;
     
         // Implementation specific type aliases
-        using deque_data_type = deque_data<value_type, size_type>;
+        using deque_data_type = deque_data<value_type, size_type, BlockSizePolicy>;
         using block_type = typename deque_data_type::block_type; // Chunk of memory with size = block_size
 
         // Implementation specific constants
@@ -68,6 +85,8 @@ namespace my
 
         // Other
         constexpr allocator_type get_allocator() const noexcept;
+        template <container_compatible_range<T> R>
+        constexpr void assign_range(R&& range);
 
         // Element access
         constexpr reference operator[](size_type index);
@@ -83,10 +102,23 @@ namespace my
         constexpr const_reference back() const;
 
         // Capacity
-        constexpr [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] constexpr bool empty() const noexcept;
         constexpr size_type size() const noexcept;
         constexpr size_type max_size() const noexcept;
         constexpr void shrink_to_fit();
+        // Blocks without elements are kept allocated, so that following insertions do not allocate
+        // When there are more than high_watermark of them after elements are removed, blocks are released until low_watermark are left
+        // By default spare blocks are never released
+        constexpr void set_spare_blocks_limits(size_type low_watermark, size_type high_watermark);
+        // Array of blocks is circular, so elements can move between front and back without growing it
+        // It grows only when every slot is used, which can be checked here for long-living queues
+        constexpr deque_block_map_stats block_map_stats() const noexcept;
+        // Allocate array of blocks and blocks, so that next n insertions at the back (front) do not allocate
+        constexpr void reserve_back(size_type n);
+        constexpr void reserve_front(size_type n);
+        // Number of elements that can be inserted at the back (front) without any allocation
+        constexpr size_type capacity_back() const noexcept;
+        constexpr size_type capacity_front() const noexcept;
 
         // Modifiers
         constexpr void clear() noexcept;
@@ -100,12 +132,22 @@ namespace my
         constexpr void push_front(T&& value);
         template <typename ... Args>
         constexpr reference emplace_front(Args&& ... args);
+        // Construct n elements from results of generator() with one capacity check and block by block
+        // If construction throws, elements added by the call are destroyed and deque is unchanged
+        // After emplace_front_n elements are in the same order in which they were generated
+        template <std::invocable Generator>
+        constexpr void emplace_back_n(size_type n, Generator generator);
+        template <std::invocable Generator>
+        constexpr void emplace_front_n(size_type n, Generator generator);
 
         constexpr void pop_back();
         constexpr void pop_front();
 
         constexpr void resize(size_type new_size);
         constexpr void resize(size_type new_size, const value_type& value);
+        // Same as resize, but new elements are default-initialized instead of value-initialized
+        // So trivial types (like char or int) are left uninitialized and can be overwritten without zeroing memory first
+        constexpr void resize_for_overwrite(size_type new_size);
 
         constexpr void swap(deque& other) noexcept;
 
@@ -115,6 +157,12 @@ namespace my
         template <std::input_iterator InputIt>
         constexpr iterator insert(const_iterator pos, InputIt first, InputIt last);
         constexpr iterator insert(const_iterator pos, std::initializer_list<T> init_list);
+        template <container_compatible_range<T> R>
+        constexpr iterator insert_range(const_iterator pos, R&& range);
+        template <container_compatible_range<T> R>
+        constexpr void append_range(R&& range);
+        template <container_compatible_range<T> R>
+        constexpr void prepend_range(R&& range);
 
         template< class... Args >
         constexpr iterator emplace(const_iterator pos, Args&&... args);
@@ -142,18 +190,35 @@ namespace my
         constexpr const_reverse_iterator crbegin() const noexcept;
         constexpr const_reverse_iterator crend() const noexcept;
 
+        // Contiguous parts of blocks in the order of elements, see deque_segments
+        using segments_type = deque_segments<deque, false>;
+        using const_segments_type = deque_segments<deque, true>;
+
+        segments_type segments() noexcept;
+        const_segments_type segments() const noexcept;
+
     private:
         using element_allocator_type = allocator_type;
         using block_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<block_type>;
 
+        // Elements can be copied with memcpy only if allocator does not customize their construction
+        constexpr static bool is_bitwise_copyable =
+            std::is_trivially_copyable_v<T> &&
+            !requires (Allocator& allocator, T* p, const T& value) { allocator.construct(p, value); };
+        // Destruction is skipped only if destructor does nothing and allocator does not customize it
+        constexpr static bool is_trivially_destroyable =
+            std::is_trivially_destructible_v<T> &&
+            !requires (Allocator& allocator, T* p) { allocator.destroy(p); };
+
         // Implementation specific member functions
         constexpr void grow_capacity();
-        constexpr void grow_capacity_to_fit(size_type new_size);
 
         constexpr size_type capacity() const;
         constexpr bool is_memory_filled() const;
 
         constexpr size_type calculate_end_index() const;
+        // Unlike calculate_end_index works when memory is filled
+        constexpr size_type calculate_last_index() const;
 
         // Functions for converting indices from range [0, capacity) to block index and offset and back
         constexpr size_type calculate_block_index(size_type element_index) const;
@@ -164,20 +229,37 @@ namespace my
         constexpr size_type calculate_previous_index(size_type current_index, size_type offset = 1) const;
         constexpr size_type calculate_next_index(size_type current_index, size_type offset = 1) const;
 
-        constexpr size_type calculate_free_back_elements_count() const; // TODO: Maybe replace this with capacity_back and remove?
-
         constexpr bool adding_back_element_would_break_invariant() const;
         constexpr bool adding_front_element_would_break_invariant() const;
 
         constexpr void destroy_all_elements();
+        // All blocks are allocated and deallocated here, so that number of allocated blocks is always known
+        constexpr block_type allocate_block();
+        constexpr void deallocate_block(block_type block);
         constexpr void deallocate_all_blocks();
         constexpr void deallocate_blocks_array();
 
+        // Calls f(pointer, count) for every part of the range that lies in one block
+        template <typename F>
+        constexpr void for_each_block_part(size_type range_begin, size_type range_size, F f);
+        // Calls f(source, destination, count) for every part where neither of two ranges crosses block boundary
+        // Parts are visited from front to back, so ranges can overlap if destination is before source
+        template <typename F>
+        constexpr void for_each_common_block_part(size_type source_begin, size_type destination_begin, size_type range_size, F f);
+        // Same, but parts are visited from back to front and ranges are given by their ends
+        // Ranges can overlap if destination is after source
+        template <typename F>
+        constexpr void for_each_common_block_part_backwards(size_type source_end, size_type destination_end, size_type range_size, F f);
+
         constexpr void destroy_range(size_type range_begin, size_type range_size);
         constexpr void default_construct_range(size_type range_begin, size_type range_size);
+        constexpr void default_initialize_range(size_type range_begin, size_type range_size);
         constexpr void copy_construct_range_values(size_type range_begin, size_type range_size, const value_type& value);
         template <std::input_iterator InputIt>
         constexpr void copy_construct_range_values(size_type range_begin, size_type range_size, InputIt first, InputIt last);
+        // Memory must be reserved, elements are destroyed if construction throws
+        template <typename Generator>
+        constexpr void emplace_range_from_generator(size_type range_begin, size_type range_size, Generator& generator);
 
         constexpr void move_assign_range(size_type source_begin, size_type source_end, size_type destination_begin);
         constexpr void move_assign_range_backwards(size_type source_begin, size_type source_end, size_type destination_end);
@@ -188,6 +270,11 @@ namespace my
 
         constexpr bool all_blocks_are_allocated() const;
 
+        // Number of blocks between begin block and the block of the last element
+        constexpr size_type used_blocks_count() const;
+        // Releases spare blocks if there are more than high watermark of them
+        constexpr void release_spare_blocks();
+
         constexpr size_type next_block_index(size_type block_index) const;
         constexpr size_type previous_block_index(size_type block_index) const;
 
@@ -195,8 +282,16 @@ namespace my
         constexpr size_type potential_capacity_back() const;
         constexpr size_type potential_capacity_front() const;
 
-        constexpr void reserve_back(size_type n);
-        constexpr void reserve_front(size_type n);
+        // Moves block pointers to new array so that begin block is the first one, new blocks are not allocated
+        constexpr void reallocate_blocks_array(size_type new_blocks_count);
+
+        // Bulk insertion behind insert and range modifiers
+        // Counted version knows number of elements in advance, so memory is reserved only once
+        template <std::forward_iterator I>
+        constexpr iterator insert_counted(const_iterator pos, I first, size_type count);
+        // Single pass ranges are appended to the back and then rotated into place
+        template <std::input_iterator I, std::sentinel_for<I> S>
+        constexpr iterator insert_single_pass(const_iterator pos, I first, S last);
 
         constexpr void move_construct_range(size_type source_begin, size_type source_end, size_type destination_begin);
         constexpr void copy_assign_range_values(size_type destination_begin, size_type destination_end, const value_type& value);
@@ -209,48 +304,51 @@ namespace my
         block_allocator_type block_allocator { }; // Name is a bit confusing, because it allocated arrays of pointers to blocks and not actual blocks
         
         deque_data_type data;
+
+        size_type spare_blocks_low_watermark { std::numeric_limits<size_type>::max() };
+        size_type spare_blocks_high_watermark { std::numeric_limits<size_type>::max() };
+
+        size_type map_reallocations { 0 };
     };
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::deque()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::deque()
     {
 
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::deque(const Allocator& allocator) :
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::deque(const Allocator& allocator) :
         element_allocator(allocator),
         block_allocator(allocator)
     {
 
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::deque(size_type count, const_reference value, const Allocator& allocator) :
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::deque(size_type count, const_reference value, const Allocator& allocator) :
         deque(allocator)
     {
         resize(count, value);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::deque(size_type count, const Allocator& allocator) :
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::deque(size_type count, const Allocator& allocator) :
         deque(allocator)
     {
         resize(count);
     }
 
-    template <typename T, typename Allocator>
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
     template <std::input_iterator InputIt>
-    constexpr deque<T, Allocator>::deque(InputIt first, InputIt last, const Allocator& allocator) :
+    constexpr deque<T, Allocator, BlockSizePolicy>::deque(InputIt first, InputIt last, const Allocator& allocator) :
         deque(allocator)
     {
-        for (; first != last; ++first) {
-            emplace_back(*first);
-        }
+        insert(cend(), first, last);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::deque(std::initializer_list<T> init_list, const Allocator& allocator) :
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::deque(std::initializer_list<T> init_list, const Allocator& allocator) :
         deque(std::begin(init_list), std::end(init_list), allocator)
     {
 
@@ -258,63 +356,85 @@ namespace my
 
 
     // Rule of 5
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::deque(const deque& other) :
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::deque(const deque& other) :
         element_allocator(std::allocator_traits<element_allocator_type>::select_on_container_copy_construction(other.get_allocator())),
         block_allocator(std::allocator_traits<element_allocator_type>::select_on_container_copy_construction(other.get_allocator())),
-        data()
-    {
-        data.elements_count = other.data.elements_count;
-        data.blocks_count = (data.elements_count + block_size - 1) / block_size; // Ceil division
-        
-        if (data.blocks_count > 0) {
-            // Allocate just enough blocks to store all elements
-            data.blocks = std::allocator_traits<block_allocator_type>::allocate(block_allocator, data.blocks_count);
-            for (size_type i = 0; i < data.blocks_count; ++i) {
-                data.blocks[i] = std::allocator_traits<element_allocator_type>::allocate(element_allocator, block_size);
-            }
-
-            // Copy all elements
-            for (size_type i = 0; i < data.elements_count; ++i) {
-                const auto block_index = calculate_block_index(i);
-                const auto block_offset = calculate_block_offset(i);
+        data(),
+        spare_blocks_low_watermark(other.spare_blocks_low_watermark),
+        spare_blocks_high_watermark(other.spare_blocks_high_watermark)
+    {
+        const auto used_blocks = ceil_division(other.data.elements_count, block_size);
+        // Number of blocks must be power of two, so the rest of the slots are left empty
+        const auto blocks_count = std::bit_ceil(used_blocks);
+
+        if (blocks_count > 0) {
+            data.blocks = std::allocator_traits<block_allocator_type>::allocate(block_allocator, blocks_count);
+            data.blocks_count = blocks_count;
+            std::fill(data.blocks, data.blocks + data.blocks_count, nullptr);
+
+            try {
+                // Allocate just enough blocks to store all elements
+                for (size_type i = 0; i < used_blocks; ++i) {
+                    data.blocks[i] = allocate_block();
+                }
 
-                std::allocator_traits<element_allocator_type>::construct(
-                    element_allocator,
-                    data.blocks[block_index] + block_offset,
-                    other[i]
-                );
+                // Elements start at the beginning of the first block, whole blocks are copied at once if possible
+                copy_construct_range_values(0, other.size(), other.begin(), other.end());
+                data.elements_count = other.data.elements_count;
+            } catch (...) {
+                // Destructor is not called if constructor throws
+                deallocate_all_blocks();
+                deallocate_blocks_array();
+                throw;
             }
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>& deque<T, Allocator>::operator=(const deque& other)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>& deque<T, Allocator, BlockSizePolicy>::operator=(const deque& other)
     {
-        // Can be optimized
-        deque copy(other);
-        copy.swap(*this);
+        constexpr bool propagates_allocator =
+            std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value &&
+            !std::allocator_traits<allocator_type>::is_always_equal::value;
+
+        // Copying of such elements can not throw, so blocks that are already allocated can be reused
+        // Only reserve_back can throw and then deque is left empty, like after clear
+        if constexpr (is_bitwise_copyable && !propagates_allocator) {
+            if (this != &other) {
+                clear();
+                insert_counted(cend(), other.begin(), other.size());
+            }
+        } else {
+            deque copy(other);
+            copy.swap(*this);
+        }
+
         return *this;
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::deque(deque&& other) :
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::deque(deque&& other) :
         element_allocator(std::move(other.element_allocator)),
         block_allocator(std::move(other.block_allocator)),
-        data(other.data)
+        data(other.data),
+        spare_blocks_low_watermark(other.spare_blocks_low_watermark),
+        spare_blocks_high_watermark(other.spare_blocks_high_watermark),
+        map_reallocations(other.map_reallocations)
     {
         other.data = {};
+        other.map_reallocations = 0;
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>& deque<T, Allocator>::operator=(deque&& other)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>& deque<T, Allocator, BlockSizePolicy>::operator=(deque&& other)
     {
         this->swap(other);
         return *this;
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::~deque()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::~deque()
     {
         destroy_all_elements();
         deallocate_all_blocks();
@@ -323,16 +443,42 @@ namespace my
 
 
     // Other
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::allocator_type deque<T, Allocator>::get_allocator() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::allocator_type deque<T, Allocator, BlockSizePolicy>::get_allocator() const noexcept
     {
         return element_allocator;
     }
 
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <container_compatible_range<T> R>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::assign_range(R&& range)
+    {
+        if constexpr (std::ranges::forward_range<R>) {
+            const auto count = static_cast<size_type>(std::ranges::distance(range));
+            auto first = std::ranges::begin(range);
+
+            if (count <= size()) {
+                // Assign new values to existing elements and destroy the rest
+                const auto last = std::next(first, count);
+                copy_assign_range(first, last, data.begin_index);
+                destroy_range(calculate_next_index(data.begin_index, count), size() - count);
+                data.elements_count = count;
+            } else {
+                // Assign new values to existing elements and construct the rest at the back
+                const auto middle = std::next(first, size());
+                copy_assign_range(first, middle, data.begin_index);
+                insert_counted(cend(), middle, count - size());
+            }
+        } else {
+            clear();
+            insert_single_pass(cend(), std::ranges::begin(range), std::ranges::end(range));
+        }
+    }
+
 
     // Element access
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::reference deque<T, Allocator>::operator[](size_type index)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::reference deque<T, Allocator, BlockSizePolicy>::operator[](size_type index)
     {
         const auto physical_index = calculate_next_index(data.begin_index, index);
         const auto block_index = calculate_block_index(physical_index);
@@ -340,8 +486,8 @@ namespace my
         return data.blocks[block_index][block_offset];
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_reference deque<T, Allocator>::operator[](size_type index) const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_reference deque<T, Allocator, BlockSizePolicy>::operator[](size_type index) const
     {
         const auto physical_index = calculate_next_index(data.begin_index, index);
         const auto block_index = calculate_block_index(physical_index);
@@ -350,8 +496,8 @@ namespace my
     }
 
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::reference deque<T, Allocator>::at(size_type index)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::reference deque<T, Allocator, BlockSizePolicy>::at(size_type index)
     {
         if (index >= data.elements_count) {
             throw std::out_of_range("Invalid element index");
@@ -360,8 +506,8 @@ namespace my
         return (*this)[index];
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_reference deque<T, Allocator>::at(size_type index) const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_reference deque<T, Allocator, BlockSizePolicy>::at(size_type index) const
     {
         if (index >= data.elements_count) {
             throw std::out_of_range("Invalid element index");
@@ -371,8 +517,8 @@ namespace my
     }
 
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::reference deque<T, Allocator>::front()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::reference deque<T, Allocator, BlockSizePolicy>::front()
     {
         const auto block_index = calculate_block_index(data.begin_index);
         const auto block_offset = calculate_block_offset(data.begin_index);
@@ -380,8 +526,8 @@ namespace my
         return data.blocks[block_index][block_offset];
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_reference deque<T, Allocator>::front() const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_reference deque<T, Allocator, BlockSizePolicy>::front() const
     {
         const auto block_index = calculate_block_index(data.begin_index);
         const auto block_offset = calculate_block_offset(data.begin_index);
@@ -390,20 +536,20 @@ namespace my
     }
 
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::reference deque<T, Allocator>::back()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::reference deque<T, Allocator, BlockSizePolicy>::back()
     {
-        const auto last_element_index = calculate_previous_index(calculate_end_index());
+        const auto last_element_index = calculate_last_index();
         auto block_index = calculate_block_index(last_element_index);
         auto block_offset = calculate_block_offset(last_element_index);
 
         return data.blocks[block_index][block_offset];
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_reference deque<T, Allocator>::back() const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_reference deque<T, Allocator, BlockSizePolicy>::back() const
     {
-        const auto last_element_index = calculate_previous_index(calculate_end_index());
+        const auto last_element_index = calculate_last_index();
         auto block_index = calculate_block_index(last_element_index);
         auto block_offset = calculate_block_offset(last_element_index);
 
@@ -412,59 +558,168 @@ namespace my
 
 
     // Capacity
-    template <typename T, typename Allocator>
-    constexpr [[nodiscard]] bool deque<T, Allocator>::empty() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    [[nodiscard]] constexpr bool deque<T, Allocator, BlockSizePolicy>::empty() const noexcept
     {
         return size() == 0;
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::size() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::size() const noexcept
     {
         return data.elements_count;
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::max_size() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::max_size() const noexcept
     {
         const auto max_bytes = std::numeric_limits<difference_type>::max();
         const auto max_blocks = max_bytes / (block_size * sizeof(value_type) + sizeof(block_type));
         return max_blocks * block_size;
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::shrink_to_fit()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::shrink_to_fit()
+    {
+        if (data.blocks_count == 0) {
+            return;
+        }
+
+        const auto used_blocks = used_blocks_count();
+        if (used_blocks == 0) {
+            deallocate_all_blocks();
+            deallocate_blocks_array();
+            data = {};
+            return;
+        }
+
+        // Release every block after the used ones, elements themselves are not moved
+        const auto begin_block_index = calculate_block_index(data.begin_index);
+        for (size_type i = used_blocks; i < data.blocks_count; ++i) {
+            auto& block = data.blocks[(begin_block_index + i) & (data.blocks_count - 1)];
+            if (block != nullptr) {
+                deallocate_block(block);
+                block = nullptr;
+            }
+        }
+
+        // Compact array of blocks, so that begin block becomes the first one like in reallocate_blocks_array
+        const auto new_blocks_count = std::bit_ceil(used_blocks);
+        if (new_blocks_count == data.blocks_count) {
+            return;
+        }
+
+        auto new_blocks = std::allocator_traits<block_allocator_type>::allocate(block_allocator, new_blocks_count);
+        for (size_type i = 0; i < used_blocks; ++i) {
+            new_blocks[i] = data.blocks[(begin_block_index + i) & (data.blocks_count - 1)];
+        }
+        std::fill(new_blocks + used_blocks, new_blocks + new_blocks_count, nullptr);
+
+        deallocate_blocks_array();
+
+        data.begin_index = calculate_block_offset(data.begin_index);
+        data.blocks = new_blocks;
+        data.blocks_count = new_blocks_count;
+        ++map_reallocations;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::set_spare_blocks_limits(size_type low_watermark, size_type high_watermark)
+    {
+        assert((low_watermark <= high_watermark) && "Low watermark must not be greater than high watermark");
+
+        spare_blocks_low_watermark = low_watermark;
+        spare_blocks_high_watermark = high_watermark;
+        release_spare_blocks();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque_block_map_stats deque<T, Allocator, BlockSizePolicy>::block_map_stats() const noexcept
+    {
+        return {
+            .map_size = data.blocks_count,
+            .allocated_blocks = data.allocated_blocks_count,
+            .used_blocks = used_blocks_count(),
+            .map_reallocations = map_reallocations
+        };
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::capacity_back() const noexcept
+    {
+        if (data.blocks_count == 0 || is_memory_filled()) {
+            return 0;
+        }
+
+        // Free elements of allocated blocks after the end, until the first unallocated block
+        const auto available = potential_capacity_back();
+        const auto end_index = calculate_end_index();
+        auto block = calculate_block_index(end_index);
+        auto free_in_block = block_size - calculate_block_offset(end_index);
+        size_type result = 0;
+
+        while (result < available && data.blocks[block] != nullptr) {
+            result += free_in_block;
+            free_in_block = block_size;
+            block = next_block_index(block);
+        }
+
+        return std::min(result, available);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::capacity_front() const noexcept
     {
-        // This is valid implementation, although a bit lazy
-        return;
+        if (data.blocks_count == 0 || is_memory_filled()) {
+            return 0;
+        }
+
+        // Free elements of allocated blocks before the begin, until the first unallocated block
+        const auto available = potential_capacity_front();
+        auto block = calculate_block_index(data.begin_index);
+        auto free_in_block = calculate_block_offset(data.begin_index);
+        if (free_in_block == 0) {
+            block = previous_block_index(block);
+            free_in_block = block_size;
+        }
+        size_type result = 0;
+
+        while (result < available && data.blocks[block] != nullptr) {
+            result += free_in_block;
+            free_in_block = block_size;
+            block = previous_block_index(block);
+        }
+
+        return std::min(result, available);
     }
 
 
     // Modifiers
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::clear() noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::clear() noexcept
     {
         destroy_all_elements();
         // Begin index remains the same to utilize memory of already allocated blocks
         data.elements_count = 0;
+        release_spare_blocks();
     }
 
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::push_back(const T& value)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::push_back(const T& value)
     {
         emplace_back(value);
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::push_back(T&& value)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::push_back(T&& value)
     {
         emplace_back(std::move(value));
     }
 
-    template <typename T, typename Allocator>
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
     template <typename ... Args>
-    constexpr deque<T, Allocator>::reference deque<T, Allocator>::emplace_back(Args&& ... args)
+    constexpr deque<T, Allocator, BlockSizePolicy>::reference deque<T, Allocator, BlockSizePolicy>::emplace_back(Args&& ... args)
     {
         if (is_memory_filled() || adding_back_element_would_break_invariant()) {
             grow_capacity();
@@ -476,8 +731,8 @@ namespace my
 
         // Allocate if we step into unallocated block
         // Should not overwrite old blocks
-        if (data.blocks[end_index] == nullptr) {
-            data.blocks[end_index] = std::allocator_traits<element_allocator_type>::allocate(element_allocator, block_size);
+        if (data.blocks[end_block] == nullptr) {
+            data.blocks[end_block] = allocate_block();
         }
         std::allocator_traits<element_allocator_type>::construct(
             element_allocator,
@@ -491,21 +746,21 @@ namespace my
     }
 
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::push_front(const T& value)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::push_front(const T& value)
     {
         emplace_front(value);
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::push_front(T&& value)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::push_front(T&& value)
     {
         emplace_front(std::move(value));
     }
 
-    template <typename T, typename Allocator>
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
     template <typename ... Args>
-    constexpr deque<T, Allocator>::reference deque<T, Allocator>::emplace_front(Args&& ... args)
+    constexpr deque<T, Allocator, BlockSizePolicy>::reference deque<T, Allocator, BlockSizePolicy>::emplace_front(Args&& ... args)
     {
         if (is_memory_filled() || adding_front_element_would_break_invariant()) {
             grow_capacity();
@@ -518,7 +773,7 @@ namespace my
         // Allocate if we step into unallocated block
         // Should not overwrite old blocks
         if (data.blocks[new_begin_block] == nullptr) {
-            data.blocks[new_begin_block] = std::allocator_traits<element_allocator_type>::allocate(element_allocator, block_size);
+            data.blocks[new_begin_block] = allocate_block();
         }
         std::allocator_traits<element_allocator_type>::construct(
             element_allocator,
@@ -532,13 +787,41 @@ namespace my
         return data.blocks[new_begin_block][new_begin_offset];
     }
 
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <std::invocable Generator>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::emplace_back_n(size_type n, Generator generator)
+    {
+        if (n == 0) {
+            return;
+        }
+
+        reserve_back(n);
+        emplace_range_from_generator(calculate_end_index(), n, generator);
+        data.elements_count += n;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <std::invocable Generator>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::emplace_front_n(size_type n, Generator generator)
+    {
+        if (n == 0) {
+            return;
+        }
+
+        reserve_front(n);
+        const auto new_begin_index = calculate_previous_index(data.begin_index, n);
+        emplace_range_from_generator(new_begin_index, n, generator);
+        data.begin_index = new_begin_index;
+        data.elements_count += n;
+    }
+
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::pop_back()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::pop_back()
     {
         assert((data.elements_count > 0) && "Trying to remove last element of empty deque is undefined behavior");
 
-        const auto last_element_index = calculate_previous_index(calculate_end_index());
+        const auto last_element_index = calculate_last_index();
         const auto last_element_block = calculate_block_index(last_element_index);
         const auto last_element_offset = calculate_block_offset(last_element_index);
 
@@ -548,10 +831,15 @@ namespace my
         );
 
         --data.elements_count;
+
+        // Last element of the block was removed
+        if (last_element_offset == 0) {
+            release_spare_blocks();
+        }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::pop_front()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::pop_front()
     {
         assert((data.elements_count > 0) && "Trying to remove first element of empty deque is undefined behavior");
 
@@ -565,40 +853,63 @@ namespace my
 
         data.begin_index = calculate_next_index(data.begin_index);
         --data.elements_count;
+
+        // Last element of the block was removed
+        if (calculate_block_offset(data.begin_index) == 0) {
+            release_spare_blocks();
+        }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::resize(size_type new_size)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::resize(size_type new_size)
     {
         if (new_size <= size()) {
             const auto number_of_elements_to_destroy = size() - new_size;
             destroy_range(calculate_next_index(data.begin_index, new_size), number_of_elements_to_destroy);
         } else {
             const auto number_of_new_elements = new_size - size();
-            grow_capacity_to_fit(new_size);
+            reserve_back(number_of_new_elements);
             default_construct_range(calculate_end_index(), number_of_new_elements);
         }
 
         data.elements_count = new_size;
+        release_spare_blocks();
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::resize(size_type new_size, const value_type& value)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::resize(size_type new_size, const value_type& value)
     {
         if (new_size <= size()) {
             const auto number_of_elements_to_destroy = size() - new_size;
             destroy_range(calculate_next_index(data.begin_index, new_size), number_of_elements_to_destroy);
         } else {
             const auto number_of_new_elements = new_size - size();
-            grow_capacity_to_fit(new_size);
+            reserve_back(number_of_new_elements);
             copy_construct_range_values(calculate_end_index(), number_of_new_elements, value);
         }
 
         data.elements_count = new_size;
+        release_spare_blocks();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::resize_for_overwrite(size_type new_size)
+    {
+        if (new_size <= size()) {
+            const auto number_of_elements_to_destroy = size() - new_size;
+            destroy_range(calculate_next_index(data.begin_index, new_size), number_of_elements_to_destroy);
+        } else {
+            const auto number_of_new_elements = new_size - size();
+            reserve_back(number_of_new_elements);
+            default_initialize_range(calculate_end_index(), number_of_new_elements);
+        }
+
+        data.elements_count = new_size;
+        release_spare_blocks();
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::swap(deque& other) noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::swap(deque& other) noexcept
     {
         using std::swap;
 
@@ -611,27 +922,41 @@ namespace my
         std::swap(data.blocks_count, other.data.blocks_count);
         std::swap(data.begin_index, other.data.begin_index);
         std::swap(data.elements_count, other.data.elements_count);
+        std::swap(data.allocated_blocks_count, other.data.allocated_blocks_count);
+        std::swap(spare_blocks_low_watermark, other.spare_blocks_low_watermark);
+        std::swap(spare_blocks_high_watermark, other.spare_blocks_high_watermark);
+        std::swap(map_reallocations, other.map_reallocations);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::iterator deque<T, Allocator>::insert(const_iterator pos, const T& value)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::insert(const_iterator pos, const T& value)
     {
         return emplace(pos, value);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::iterator deque<T, Allocator>::insert(const_iterator pos, T&& value)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::insert(const_iterator pos, T&& value)
     {
         return emplace(pos, std::move(value));
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::iterator deque<T, Allocator>::insert(const_iterator pos, size_type count, const T& value)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::insert(const_iterator pos, size_type count, const T& value)
     {
         if (count == 0) {
             return begin() + (pos - cbegin());
         }
 
+        // Checked first, so empty deque is filled from the back
+        // Filling all blocks from the front would need begin_index to move by whole capacity
+        if (pos == cend()) {
+            reserve_back(count);
+            copy_construct_range_values(calculate_end_index(), count, value);
+            data.elements_count += count;
+
+            return end() - count;
+        }
+
         if (pos == cbegin()) {
             reserve_front(count);
             copy_construct_range_values(calculate_previous_index(data.begin_index, count), count, value);
@@ -640,14 +965,6 @@ namespace my
             
             return begin();
         }
-        
-        if (pos == cend()) {
-            reserve_back(count);
-            copy_construct_range_values(calculate_end_index(), count, value);
-            data.elements_count += count;
-
-            return end();
-        }
 
         bool is_pos_closer_to_begin = pos - cbegin() < cend() - pos;
         if (is_pos_closer_to_begin) {
@@ -734,10 +1051,11 @@ namespace my
                 );
 
                 // Move other (elements_to_move - count) elements to the end
-                move_assign_range(
+                // Ranges overlap and destination is after source, so elements are moved from the back
+                move_assign_range_backwards(
                     calculate_previous_index(end_index, elements_to_move),
                     calculate_previous_index(end_index, count),
-                    calculate_previous_index(end_index, elements_to_move - count)
+                    end_index
                 );
 
                 // Fill the gap with the copies of value
@@ -792,250 +1110,124 @@ namespace my
         }
     }
 
-    template <typename T, typename Allocator>
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
     template <std::input_iterator InputIt>
-    constexpr deque<T, Allocator>::iterator deque<T, Allocator>::insert(const_iterator pos, InputIt first, InputIt last)
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::insert(const_iterator pos, InputIt first, InputIt last)
     {
-        const auto count = std::distance(first, last);
-        if (count == 0) {
-            return begin() + (pos - cbegin());
+        if constexpr (std::forward_iterator<InputIt>) {
+            return insert_counted(pos, first, static_cast<size_type>(std::distance(first, last)));
+        } else {
+            return insert_single_pass(pos, first, last);
         }
+    }
 
-        if (pos == cbegin()) {
-            reserve_front(count);
-            copy_construct_range_values(calculate_previous_index(data.begin_index, count), count, first, last);
-            data.elements_count += count;
-            data.begin_index = calculate_previous_index(data.begin_index, count);
-            
-            return begin();
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::insert(const_iterator pos, std::initializer_list<T> init_list)
+    {
+        return insert(pos, std::begin(init_list), std::end(init_list));
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <container_compatible_range<T> R>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::insert_range(const_iterator pos, R&& range)
+    {
+        if constexpr (std::ranges::forward_range<R>) {
+            return insert_counted(pos, std::ranges::begin(range), static_cast<size_type>(std::ranges::distance(range)));
+        } else {
+            return insert_single_pass(pos, std::ranges::begin(range), std::ranges::end(range));
         }
-        
-        if (pos == cend()) {
-            reserve_back(count);
-            copy_construct_range_values(calculate_end_index(), count, first, last);
-            data.elements_count += count;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <container_compatible_range<T> R>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::append_range(R&& range)
+    {
+        insert_range(cend(), std::forward<R>(range));
+    }
 
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <container_compatible_range<T> R>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::prepend_range(R&& range)
+    {
+        insert_range(cbegin(), std::forward<R>(range));
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template< class... Args >
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::emplace(const_iterator pos, Args&&... args)
+    {
+        if (pos == cbegin()) {
+            emplace_front(std::forward<Args>(args) ...);
+            return begin();
+        } else if (pos == cend()) {
+            emplace_back(std::forward<Args>(args) ...);
             return end();
-        }
+        } else {
+            if (is_memory_filled()) {
+                grow_capacity();
+            }
 
-        bool is_pos_closer_to_begin = pos - cbegin() < cend() - pos;
-        if (is_pos_closer_to_begin) {
-            reserve_front(count);
-            const auto elements_to_move = pos - cbegin();
+            if (pos - begin() < end() - pos) {
+                // Move elements before pos
+                if (adding_front_element_would_break_invariant()) {
+                    grow_capacity();
+                }
 
-            if (count < elements_to_move) {
-                // First count elements are moved into uninitialized memory
-                move_construct_range(
-                    data.begin_index,
-                    calculate_next_index(data.begin_index, count),
-                    calculate_previous_index(data.begin_index, count)
-                );
+                const auto new_begin = calculate_previous_index(data.begin_index);
+                const auto new_begin_block = calculate_block_index(new_begin);
+                const auto new_begin_offset = calculate_block_offset(new_begin);
 
-                // Other elements are moved to begin
+                // Allocate if we step into unallocated block
+                if (data.blocks[new_begin_block] == nullptr) {
+                    data.blocks[new_begin_block] = allocate_block();
+                }
+                std::allocator_traits<element_allocator_type>::construct(
+                    element_allocator,
+                    data.blocks[new_begin_block] + new_begin_offset,
+                    std::move(front())
+                );
+                // Front element is already moved to the new slot, so only the ones after it are shifted
                 move_assign_range(
-                    calculate_next_index(data.begin_index, count),
-                    calculate_next_index(data.begin_index, elements_to_move),
+                    calculate_next_index(data.begin_index),
+                    calculate_next_index(data.begin_index, pos - begin()),
                     data.begin_index
                 );
 
-                // Fill the gap with elements from iterator range
-                copy_assign_range(
-                    first,
-                    last,
-                    calculate_next_index(data.begin_index, elements_to_move - count)
+                const auto insert_position = calculate_previous_index(calculate_next_index(data.begin_index, pos - begin()));
+                const auto insert_position_block = calculate_block_index(insert_position);
+                const auto insert_position_offset = calculate_block_offset(insert_position);
+                // Destroy moved-from object
+                std::allocator_traits<element_allocator_type>::destroy(
+                    element_allocator,
+                    data.blocks[insert_position_block] + insert_position_offset
                 );
-            }
-
-            if (count == elements_to_move) {
-                // Trivial case
-                // All elements before pos are moved to uninitialized memory
-                move_construct_range(
-                    data.begin_index, 
-                    calculate_next_index(data.begin_index, elements_to_move),
-                    calculate_previous_index(data.begin_index, elements_to_move)
+                // Create new one
+                std::allocator_traits<element_allocator_type>::construct(
+                    element_allocator,
+                    data.blocks[insert_position_block] + insert_position_offset,
+                    std::forward<Args>(args) ...
                 );
+            
+                data.begin_index = new_begin;
+                ++data.elements_count;
+            } else {
+                // Move elements after pos (including pos)
+                if (adding_back_element_would_break_invariant()) {
+                    grow_capacity();
+                }
 
-                // Assign copies of elements from iterator range to moved-from objects
-                copy_assign_range(
-                    first,
-                    last,
-                    data.begin_index
-                );
-            }
+                const auto new_element_position = calculate_end_index();
+                const auto new_element_block = calculate_block_index(new_element_position);
+                const auto new_element_offset = calculate_block_offset(new_element_position);
 
-            if (count > elements_to_move) {
-                // Move first (elements_to_move) elements to uninitialized memory
-                move_construct_range(
-                    data.begin_index,
-                    calculate_next_index(data.begin_index, elements_to_move),
-                    calculate_previous_index(data.begin_index, count)
-                );
-
-                // Construct (count - elements_to_move) elements from iterator range in uninitialized memory
-                copy_construct_range_values(
-                    calculate_previous_index(data.begin_index, count - elements_to_move),
-                    count - elements_to_move,
-                    first,
-                    last
-                );
-
-                // Fill moved-from elements with copies of elements from iterator range
-                copy_assign_range(
-                    first + (count - elements_to_move),
-                    last,
-                    data.begin_index
-                );
-            }
-
-            data.begin_index = calculate_previous_index(data.begin_index, count);
-            data.elements_count += count;
-            return begin() + elements_to_move;
-        } else {
-            reserve_back(count);
-            const auto elements_to_move = cend() - pos;
-            const auto end_index = calculate_end_index();
-
-            if (count < elements_to_move) {
-                // Move last (count) elements to uninitialized memory
-                move_construct_range(
-                    calculate_previous_index(end_index, count),
-                    end_index,
-                    end_index
-                );
-
-                // Move other (elements_to_move - count) elements to the end
-                move_assign_range(
-                    calculate_previous_index(end_index, elements_to_move),
-                    calculate_previous_index(end_index, count),
-                    calculate_previous_index(end_index, elements_to_move - count)
-                );
-
-                // Copy values from iterator range
-                copy_assign_range(
-                    first,
-                    last,
-                    calculate_previous_index(end_index, elements_to_move)
-                );
-            }
-
-            if (count == elements_to_move) {
-                // Move all elements after pos (including pos) to uninitialized memory
-                move_construct_range(
-                    calculate_previous_index(end_index, count),
-                    end_index,
-                    end_index
-                );
-
-                // Copy values from iterator range
-                copy_assign_range(
-                    first,
-                    last,
-                    calculate_previous_index(end_index, count)
-                );
-            }
-
-            if (count > elements_to_move) {
-                // Move all elements after pos (including pos) (count) places forward to make space for new values
-                move_construct_range(
-                    calculate_previous_index(end_index, elements_to_move),
-                    end_index,
-                    calculate_next_index(end_index, count - elements_to_move)
-                );
-
-                // Construct (count - elements_to_move) values from iterator range in uninitialized memory
-                copy_construct_range_values(
-                    end_index,
-                    count - elements_to_move, // Number of elements
-                    first + elements_to_move,
-                    last
-                );
-
-                // Assign copies of value to moved-from elements
-                copy_assign_range(
-                    first,
-                    first + elements_to_move,
-                    calculate_previous_index(end_index, elements_to_move)
-                );
-            }
-
-            data.elements_count += count;
-            return end() - (count + elements_to_move);
-        }
-    }
-
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::iterator deque<T, Allocator>::insert(const_iterator pos, std::initializer_list<T> init_list)
-    {
-        return insert(pos, std::begin(init_list), std::end(init_list));
-    }
-
-    template <typename T, typename Allocator>
-    template< class... Args >
-    constexpr deque<T, Allocator>::iterator deque<T, Allocator>::emplace(const_iterator pos, Args&&... args)
-    {
-        if (pos == cbegin()) {
-            emplace_front(std::forward<Args>(args) ...);
-            return begin();
-        } else if (pos == cend()) {
-            emplace_back(std::forward<Args>(args) ...);
-            return end();
-        } else {
-            if (is_memory_filled()) {
-                grow_capacity();
-            }
-
-            if (pos - begin() < end() - pos) {
-                // Move elements before pos
-                if (adding_front_element_would_break_invariant()) {
-                    grow_capacity();
-                }
-
-                const auto new_begin = calculate_previous_index(data.begin_index);
-                const auto new_begin_block = calculate_block_index(new_begin);
-                const auto new_begin_offset = calculate_block_offset(new_begin);
-                
-                std::allocator_traits<element_allocator_type>::construct(
-                    element_allocator,
-                    data.blocks[new_begin_block] + new_begin_offset,
-                    std::move(front())
-                );
-                move_assign_range(
-                    data.begin_index,
-                    calculate_next_index(data.begin_index, pos - begin()),
-                    calculate_previous_index(data.begin_index)
-                );
-
-                const auto insert_position = calculate_previous_index(calculate_next_index(data.begin_index, pos - begin()));
-                const auto insert_position_block = calculate_block_index(insert_position);
-                const auto insert_position_offset = calculate_block_offset(insert_position);
-                // Destroy moved-from object
-                std::allocator_traits<element_allocator_type>::destroy(
-                    element_allocator,
-                    data.blocks[insert_position_block] + insert_position_offset
-                );
-                // Create new one
-                std::allocator_traits<element_allocator_type>::construct(
-                    element_allocator,
-                    data.blocks[insert_position_block] + insert_position_offset,
-                    std::forward<Args>(args) ...
-                );
-            
-                data.begin_index = new_begin;
-                ++data.elements_count;
-            } else {
-                // Move elements after pos (including pos)
-                if (adding_back_element_would_break_invariant()) {
-                    grow_capacity();
-                }
-
-                const auto new_element_position = calculate_end_index();
-                const auto new_element_block = calculate_block_index(new_element_position);
-                const auto new_element_offset = calculate_block_offset(new_element_position);
-                
-                std::allocator_traits<element_allocator_type>::construct(
-                    element_allocator,
-                    data.blocks[new_element_block] + new_element_offset,
-                    std::move(back())
+                // Allocate if we step into unallocated block
+                if (data.blocks[new_element_block] == nullptr) {
+                    data.blocks[new_element_block] = allocate_block();
+                }
+                std::allocator_traits<element_allocator_type>::construct(
+                    element_allocator,
+                    data.blocks[new_element_block] + new_element_offset,
+                    std::move(back())
                 );
                 move_assign_range_backwards(
                     calculate_next_index(data.begin_index, pos - begin()),
@@ -1068,18 +1260,18 @@ namespace my
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::iterator deque<T, Allocator>::erase(const_iterator pos)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::erase(const_iterator pos)
     {
         assert((pos != cend()) && "The iterator pos must be valid and dereferenceable"); // From cppreference
         return erase(pos, pos + 1);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::iterator deque<T, Allocator>::erase(const_iterator first, const_iterator last)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::erase(const_iterator first, const_iterator last)
     {
         if (first == last) {
-            return last;
+            return begin() + (last - cbegin());
         }
 
         const auto count = last - first;
@@ -1088,12 +1280,14 @@ namespace my
             destroy_range(data.begin_index, count);
             data.begin_index = calculate_next_index(data.begin_index, count);
             data.elements_count -= count;
+            release_spare_blocks();
             return begin();
         }
 
         if (last == cend()) {
             destroy_range(calculate_next_index(data.begin_index, first - cbegin()), count);
             data.elements_count -= count;
+            release_spare_blocks();
             return end();
         }
 
@@ -1111,119 +1305,125 @@ namespace my
             data.begin_index = calculate_next_index(data.begin_index, count);
             data.elements_count -= count;
         } else {
+            // Memory can be filled here, so end index is wrapped directly, like in for_each_block_part
+            const auto end_index = data.wrap_index(data.begin_index + data.elements_count);
             move_assign_range(
                 calculate_next_index(data.begin_index, last - cbegin()),
-                calculate_end_index(),
+                end_index,
                 calculate_next_index(data.begin_index, first - cbegin())
             );
 
-            destroy_range(calculate_previous_index(calculate_end_index(), count), count);
+            destroy_range(calculate_previous_index(end_index, count), count);
             data.elements_count -= count; 
         }
 
+        release_spare_blocks();
         return begin() + elements_before;
     }
 
 
     // Iterators
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::iterator deque<T, Allocator>::begin() noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::begin() noexcept
     {
         return iterator(&data, 0);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::iterator deque<T, Allocator>::end() noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::end() noexcept
     {
         return iterator(&data, data.elements_count);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_iterator deque<T, Allocator>::begin() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_iterator deque<T, Allocator, BlockSizePolicy>::begin() const noexcept
     {
         // I know const_cast is bad, but i don't know if there is a safe way to do this
         // (i don't want to implement const_iterator from scratch after spending so much time on basic_const_iterator)
         return const_iterator(iterator(const_cast<deque_data_type*>(&data), 0));
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_iterator deque<T, Allocator>::end() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_iterator deque<T, Allocator, BlockSizePolicy>::end() const noexcept
     {
         return const_iterator(iterator(const_cast<deque_data_type*>(&data),  data.elements_count));
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_iterator deque<T, Allocator>::cbegin() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_iterator deque<T, Allocator, BlockSizePolicy>::cbegin() const noexcept
     {
         return begin();
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_iterator deque<T, Allocator>::cend() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_iterator deque<T, Allocator, BlockSizePolicy>::cend() const noexcept
     {
         return end();
     }
 
 
     // Reverse iterators
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::reverse_iterator deque<T, Allocator>::rbegin() noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::reverse_iterator deque<T, Allocator, BlockSizePolicy>::rbegin() noexcept
     {
         return reverse_iterator(end());
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::reverse_iterator deque<T, Allocator>::rend() noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::reverse_iterator deque<T, Allocator, BlockSizePolicy>::rend() noexcept
     {
         return reverse_iterator(begin());
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_reverse_iterator deque<T, Allocator>::rbegin() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_reverse_iterator deque<T, Allocator, BlockSizePolicy>::rbegin() const noexcept
     {
         return const_reverse_iterator(reverse_iterator(const_cast<deque*>(this)->end()));
     }
     
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_reverse_iterator deque<T, Allocator>::rend() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_reverse_iterator deque<T, Allocator, BlockSizePolicy>::rend() const noexcept
     {
         return const_reverse_iterator(reverse_iterator(const_cast<deque*>(this)->begin()));
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_reverse_iterator deque<T, Allocator>::crbegin() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_reverse_iterator deque<T, Allocator, BlockSizePolicy>::crbegin() const noexcept
     {
         return rbegin();
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::const_reverse_iterator deque<T, Allocator>::crend() const noexcept
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::const_reverse_iterator deque<T, Allocator, BlockSizePolicy>::crend() const noexcept
     {
         return rend();
     }
 
 
-    // Non-member functions
-    template <class T, class Allocator>
-    constexpr bool operator==(const deque<T, Allocator>& a, const deque<T, Allocator>& b)
+    // Segments
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    deque<T, Allocator, BlockSizePolicy>::segments_type deque<T, Allocator, BlockSizePolicy>::segments() noexcept
     {
-        if (a.size() != b.size()) {
-            return false;
-        }
+        return segments_type(&data, 0, size());
+    }
 
-        auto i = a.begin();
-        auto j = b.begin();
-        for (; i != a.end(); ++i, ++j) {
-            if (*i != *j) {
-                return false;
-            }
-        }
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    deque<T, Allocator, BlockSizePolicy>::const_segments_type deque<T, Allocator, BlockSizePolicy>::segments() const noexcept
+    {
+        return const_segments_type(&data, 0, size());
+    }
 
-        return true;
+
+    // Non-member functions
+    template <class T, class Allocator, block_size_policy BlockSizePolicy>
+    constexpr bool operator==(const deque<T, Allocator, BlockSizePolicy>& a, const deque<T, Allocator, BlockSizePolicy>& b)
+    {
+        // Blocks of both deques are compared piece by piece, see my::equal
+        return a.size() == b.size() && my::equal(a.begin(), a.end(), b.begin());
     }
 
-    template <class T, class Allocator>
-    constexpr my::synth_three_way_result<T> operator<=>(const deque<T, Allocator>& a, const deque<T, Allocator>& b)
+    template <class T, class Allocator, block_size_policy BlockSizePolicy>
+    constexpr my::synth_three_way_result<T> operator<=>(const deque<T, Allocator, BlockSizePolicy>& a, const deque<T, Allocator, BlockSizePolicy>& b)
     {
         return my::lexicographical_compare_three_way(
             a.begin(), a.end(),
@@ -1234,150 +1434,66 @@ namespace my
 
 
     // Implementation details
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::grow_capacity()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::grow_capacity()
     {
-        size_type new_blocks_count;
-        if (data.blocks_count == 0) {
-            new_blocks_count = 2; // Minimum 2 blocks, number is arbitrary
-        } else {
-            new_blocks_count = data.blocks_count * 2;
-        }
-
-        auto new_blocks = std::allocator_traits<block_allocator_type>::allocate(block_allocator, new_blocks_count);
-        auto begin_block_index = calculate_block_index(data.begin_index);
-        auto begin_block_offset = calculate_block_offset(data.begin_index);
-        // We copy blocks before begin block to the start of the new memory
-        std::copy(data.blocks, data.blocks + begin_block_index, new_blocks);
-        // And all blocks after (including begin block) to the end
-        // Backwards because calculating d_first is more complicated than d_last
-        std::copy_backward(data.blocks + begin_block_index, data.blocks + data.blocks_count, new_blocks + new_blocks_count);
-
-        auto new_begin_block_index = new_blocks_count - (data.blocks_count - begin_block_index);
-
-        // Don't forget to fill the gap between the two with nullptrs
-        std::fill(new_blocks + begin_block_index, new_blocks + new_begin_block_index, nullptr);
-
-        // Clear block pointers array
-        std::allocator_traits<block_allocator_type>::deallocate(block_allocator, data.blocks, data.blocks_count);
-
-        data.begin_index = calculate_element_index(new_begin_block_index, begin_block_offset) % (new_blocks_count * block_size);
-        data.blocks = new_blocks;
-        data.blocks_count = new_blocks_count;
-        // elements_count is not changed
+        // Called only when every slot of array of blocks is used, so there is nothing to compact and array is doubled
+        // Minimum 2 blocks, number is arbitrary
+        reallocate_blocks_array(data.blocks_count == 0 ? 2 : data.blocks_count * 2);
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::grow_capacity_to_fit(size_type new_size)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::capacity() const
     {
-        const auto new_elements_count = new_size - size();
-        const auto free_elements_count = calculate_free_back_elements_count();
-
-        if (new_elements_count <= free_elements_count) {
-            // No need to iterate all blocks, but i don't feel like calculating which ones are/aren't allocated
-            allocate_blocks_if_not_allocated(data.blocks, data.blocks + data.blocks_count);
-            return;
-        }
-
-        const auto extra_elements_count = new_elements_count - free_elements_count;
-        const auto extra_blocks_count = (extra_elements_count + block_size - 1) / block_size;
-        const auto new_blocks_count = data.blocks_count + extra_blocks_count;
-
-        auto new_blocks = std::allocator_traits<block_allocator_type>::allocate(block_allocator, new_blocks_count);
-        
-        auto begin_block_index = calculate_block_index(data.begin_index);
-        if (data.blocks == nullptr) {
-            allocate_blocks_unsafe(new_blocks, new_blocks + new_blocks_count);
-        } else {
-            if (data.begin_index < calculate_end_index()) {
-                // Deque looks like this:
-                //    begin      end
-                //      v         v
-                // [ | |#|#|#|#|#| ]
-                const auto front_empty_blocks_count = begin_block_index;
-                const auto back_empty_blocks_count = data.blocks_count - ceil_division(calculate_end_index(), block_size);
-                const auto filled_blocks_count = data.blocks_count - (front_empty_blocks_count + back_empty_blocks_count);
-
-                // Copy all blocks
-                std::copy(data.blocks, data.blocks + data.blocks_count, new_blocks);
-                allocate_blocks_if_not_allocated(new_blocks, new_blocks + front_empty_blocks_count);
-                allocate_blocks_if_not_allocated(new_blocks + front_empty_blocks_count + filled_blocks_count, new_blocks + data.blocks_count);
-                allocate_blocks(new_blocks + data.blocks_count, new_blocks + new_blocks_count);
-            } else {
-                // And here we deal with this case:
-                //       end    begin
-                //        v       v
-                // [#|#|#| | | | |#]
-                const auto back_blocks_count = data.blocks_count - begin_block_index;
-                const auto front_blocks_count = ceil_division(calculate_end_index(), block_size);
-                std::copy(data.blocks + begin_block_index, data.blocks + data.blocks_count, new_blocks);
-                std::copy(data.blocks, data.blocks + front_blocks_count, new_blocks + back_blocks_count);
-                std::copy(
-                    data.blocks + front_blocks_count,
-                    data.blocks + back_blocks_count,
-                    new_blocks + back_blocks_count + front_blocks_count
-                ); // Copy free blocks, because they can be empty but allocated and we don't want to leak
-                allocate_blocks_if_not_allocated(new_blocks + back_blocks_count + front_blocks_count, new_blocks + data.blocks_count);
-                allocate_blocks(new_blocks + data.blocks_count, new_blocks + new_blocks_count);
-            }
-            deallocate_blocks_array();
-        }
-
-        data.begin_index = data.begin_index % block_size;
-        data.blocks = new_blocks;
-        data.blocks_count = new_blocks_count;
-
-        assert((all_blocks_are_allocated()) && "All blocks must be allocated. It should be safe to construct element in any block after call to this function");
+        return block_size * data.blocks_count;
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::capacity() const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::calculate_end_index() const
     {
-        return block_size * data.blocks_count;
+        assert((data.elements_count < capacity()) && "Memory is filled. End index would end up equal to begin index. You should handle this case separately using is_memory_filled");
+        return data.wrap_index(data.begin_index + data.elements_count);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::calculate_end_index() const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::calculate_last_index() const
     {
-        assert((data.elements_count < capacity()) && "Memory is filled. End index would end up equal to begin index. You should handle this case separately using is_memory_filled");
-        return (data.begin_index + data.elements_count) % capacity();
+        assert((data.elements_count > 0) && "Empty deque has no last element");
+        return calculate_next_index(data.begin_index, data.elements_count - 1);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::calculate_block_index(size_type element_index) const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::calculate_block_index(size_type element_index) const
     {
-        return element_index / block_size;
+        return data.calculate_block_index(element_index);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::calculate_block_offset(size_type element_index) const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::calculate_block_offset(size_type element_index) const
     {
-        return element_index % block_size;
+        return data.calculate_block_offset(element_index);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::calculate_element_index(size_type block_index, size_type block_offset) const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::calculate_element_index(size_type block_index, size_type block_offset) const
     {
         return block_index * block_size + block_offset;
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::calculate_previous_index(size_type current_index, size_type offset) const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::calculate_previous_index(size_type current_index, size_type offset) const
     {
-        assert((0 <= offset && offset < capacity()) && "Invalid offset");
-        // + capacity to not wrap around
-        return (current_index + capacity() - offset) % capacity();
+        return data.calculate_previous_index(current_index, offset);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::calculate_next_index(size_type current_index, size_type offset) const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::calculate_next_index(size_type current_index, size_type offset) const
     {
-        assert((0 <= offset && offset < capacity()) && "Invalid offset");
-        return (current_index + offset) % capacity();
+        return data.calculate_next_index(current_index, offset);
     }
 
-    template <typename T, typename Allocator>
-    constexpr bool deque<T, Allocator>::adding_front_element_would_break_invariant() const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr bool deque<T, Allocator, BlockSizePolicy>::adding_front_element_would_break_invariant() const
     {
         // Blocks like this one are ok:
         //    begin      end
@@ -1398,15 +1514,8 @@ namespace my
         return (new_begin_index > end_index) && (new_begin_block == end_block);
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::calculate_free_back_elements_count() const
-    {
-        const auto number_of_free_elements_in_first_block = calculate_block_offset(data.begin_index);
-        return capacity() - number_of_free_elements_in_first_block; // FIXME: What about all filled elements?
-    }
-
-    template <typename T, typename Allocator>
-    constexpr bool deque<T, Allocator>::adding_back_element_would_break_invariant() const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr bool deque<T, Allocator, BlockSizePolicy>::adding_back_element_would_break_invariant() const
     {
         auto end_index = calculate_end_index();
         auto new_end_index = calculate_next_index(end_index);
@@ -1417,15 +1526,19 @@ namespace my
         return (new_end_index < data.begin_index) && (new_end_block == begin_block);
     }
 
-    template <typename T, typename Allocator>
-    constexpr bool deque<T, Allocator>::is_memory_filled() const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr bool deque<T, Allocator, BlockSizePolicy>::is_memory_filled() const
     {
         return data.elements_count == capacity();
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::destroy_all_elements()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::destroy_all_elements()
     {
+        if constexpr (is_trivially_destroyable) {
+            return;
+        }
+
         auto current_index = data.begin_index;
 
         for (size_type i = 0; i < data.elements_count; ++i) {
@@ -1441,77 +1554,116 @@ namespace my
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::deallocate_all_blocks()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::block_type deque<T, Allocator, BlockSizePolicy>::allocate_block()
+    {
+        auto block = std::allocator_traits<element_allocator_type>::allocate(element_allocator, block_size);
+        ++data.allocated_blocks_count;
+        return block;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::deallocate_block(block_type block)
+    {
+        std::allocator_traits<element_allocator_type>::deallocate(element_allocator, block, block_size);
+        --data.allocated_blocks_count;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::deallocate_all_blocks()
     {
         for (size_type i = 0; i < data.blocks_count; ++i) {
             if (data.blocks[i] != nullptr) {
-                std::allocator_traits<element_allocator_type>::deallocate(element_allocator, data.blocks[i], block_size);
+                deallocate_block(data.blocks[i]);
             }
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::deallocate_blocks_array()
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::deallocate_blocks_array()
     {
         std::allocator_traits<block_allocator_type>::deallocate(block_allocator, data.blocks, data.blocks_count);
     }
 
     
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::destroy_range(size_type range_begin, size_type range_size)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <typename F>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::for_each_block_part(size_type range_begin, size_type range_size, F f)
     {
-        for (size_type i = 0; i < range_size; ++i) {
-            auto current_block = calculate_block_index(range_begin);
-            auto current_offset = calculate_block_offset(range_begin);
+        // range_begin is the same type of index as begin_index
+        while (range_size > 0) {
+            const auto block_offset = calculate_block_offset(range_begin);
+            const auto count = std::min(block_size - block_offset, range_size);
 
-            std::allocator_traits<element_allocator_type>::destroy(
-                element_allocator,
-                data.blocks[current_block] + current_offset
-            );
+            f(data.blocks[calculate_block_index(range_begin)] + block_offset, count);
 
-            range_begin = calculate_next_index(range_begin);
+            // Count can be equal to capacity when there is only one block, so index is wrapped directly
+            range_begin = data.wrap_index(range_begin + count);
+            range_size -= count;
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::default_construct_range(size_type range_begin, size_type range_size)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <typename F>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::for_each_common_block_part(size_type source_begin, size_type destination_begin, size_type range_size, F f)
     {
-        // range_begin is the same type of index as begin_index
-        for (size_type i = 0; i < range_size; ++i) {
-            auto current_block = calculate_block_index(range_begin);
-            auto current_offset = calculate_block_offset(range_begin);
+        while (range_size > 0) {
+            const auto source_offset = calculate_block_offset(source_begin);
+            const auto destination_offset = calculate_block_offset(destination_begin);
+            const auto count = std::min({ block_size - source_offset, block_size - destination_offset, range_size });
 
-            std::allocator_traits<element_allocator_type>::construct(
-                element_allocator,
-                data.blocks[current_block] + current_offset
+            f(
+                data.blocks[calculate_block_index(source_begin)] + source_offset,
+                data.blocks[calculate_block_index(destination_begin)] + destination_offset,
+                count
             );
 
-            range_begin = calculate_next_index(range_begin);
+            source_begin = data.wrap_index(source_begin + count);
+            destination_begin = data.wrap_index(destination_begin + count);
+            range_size -= count;
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::copy_construct_range_values(size_type range_begin, size_type range_size, const value_type& value)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <typename F>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::for_each_common_block_part_backwards(size_type source_end, size_type destination_end, size_type range_size, F f)
     {
-        // range_begin is the same type of index as begin_index
-        for (size_type i = 0; i < range_size; ++i) {
-            auto current_block = calculate_block_index(range_begin);
-            auto current_offset = calculate_block_offset(range_begin);
+        while (range_size > 0) {
+            // End can be at the start of the next block, so the part is found by the last element
+            const auto source_last = data.wrap_index(source_end - 1);
+            const auto destination_last = data.wrap_index(destination_end - 1);
+            const auto source_part_size = calculate_block_offset(source_last) + 1;
+            const auto destination_part_size = calculate_block_offset(destination_last) + 1;
+            const auto count = std::min({ source_part_size, destination_part_size, range_size });
 
-            std::allocator_traits<element_allocator_type>::construct(
-                element_allocator,
-                data.blocks[current_block] + current_offset,
-                value
+            f(
+                data.blocks[calculate_block_index(source_last)] + (source_part_size - count),
+                data.blocks[calculate_block_index(destination_last)] + (destination_part_size - count),
+                count
             );
 
-            range_begin = calculate_next_index(range_begin);
+            source_end = data.wrap_index(source_end - count);
+            destination_end = data.wrap_index(destination_end - count);
+            range_size -= count;
         }
     }
 
-    template <typename T, typename Allocator>
-    template <std::input_iterator InputIt>
-    constexpr void deque<T, Allocator>::copy_construct_range_values(size_type range_begin, size_type range_size, InputIt first, InputIt last)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::destroy_range(size_type range_begin, size_type range_size)
+    {
+        if constexpr (is_trivially_destroyable) {
+            return;
+        }
+
+        for_each_block_part(range_begin, range_size, [this](pointer part, size_type count) {
+            for (size_type i = 0; i < count; ++i) {
+                std::allocator_traits<element_allocator_type>::destroy(element_allocator, part + i);
+            }
+        });
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::default_construct_range(size_type range_begin, size_type range_size)
     {
         // range_begin is the same type of index as begin_index
         for (size_type i = 0; i < range_size; ++i) {
@@ -1520,89 +1672,228 @@ namespace my
 
             std::allocator_traits<element_allocator_type>::construct(
                 element_allocator,
-                data.blocks[current_block] + current_offset,
-                *first
+                data.blocks[current_block] + current_offset
             );
 
-            ++first;
             range_begin = calculate_next_index(range_begin);
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::move_assign_range(size_type source_begin, size_type source_end, size_type destination_begin)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::default_initialize_range(size_type range_begin, size_type range_size)
     {
-        while (source_begin != source_end) {
-            auto source_block = calculate_block_index(source_begin);
-            auto source_offset = calculate_block_offset(source_begin);
+        // Default-initialization bypasses allocator, so it is used only if allocator does not customize construction
+        // Reading uninitialized memory is not allowed in constant evaluation, so elements are value-initialized there
+        constexpr bool is_default_initializable = !requires (element_allocator_type& allocator, T* p) { allocator.construct(p); };
 
-            auto destination_block = calculate_block_index(destination_begin);
-            auto destination_offset = calculate_block_offset(destination_begin);
+        if (!is_default_initializable || std::is_constant_evaluated()) {
+            default_construct_range(range_begin, range_size);
+            return;
+        }
+
+        if constexpr (std::is_trivially_default_constructible_v<T>) {
+            // Default-initialization of trivial types does nothing, so there is no need to even visit the elements
+            return;
+        } else {
+            for (size_type i = 0; i < range_size; ++i) {
+                auto current_block = calculate_block_index(range_begin);
+                auto current_offset = calculate_block_offset(range_begin);
 
-            data.blocks[destination_block][destination_offset] = std::move(data.blocks[source_block][source_offset]);
+                ::new (static_cast<void*>(data.blocks[current_block] + current_offset)) T;
 
-            source_begin = calculate_next_index(source_begin);
-            destination_begin = calculate_next_index(destination_begin);
+                range_begin = calculate_next_index(range_begin);
+            }
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::move_assign_range_backwards(size_type source_begin, size_type source_end, size_type destination_end)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::copy_construct_range_values(size_type range_begin, size_type range_size, const value_type& value)
     {
-        while (source_end != source_begin) {
-            source_end = calculate_next_index(source_end);
-            destination_end = calculate_next_index(destination_end);
-
-            auto source_block = calculate_block_index(source_end);
-            auto source_offset = calculate_block_offset(source_end);
+        if constexpr (is_bitwise_copyable) {
+            // Copy can't throw, so every part of a block is filled at once
+            // Assignment does not start lifetime of objects during constant evaluation, so elements are constructed one by one there
+            if (!std::is_constant_evaluated()) {
+                for_each_block_part(range_begin, range_size, [&value](pointer part, size_type count) {
+                    std::fill_n(part, count, value);
+                });
+                return;
+            }
+        }
+
+        // range_begin is the same type of index as begin_index
+        for (size_type i = 0; i < range_size; ++i) {
+            auto current_block = calculate_block_index(range_begin);
+            auto current_offset = calculate_block_offset(range_begin);
+
+            std::allocator_traits<element_allocator_type>::construct(
+                element_allocator,
+                data.blocks[current_block] + current_offset,
+                value
+            );
+
+            range_begin = calculate_next_index(range_begin);
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <std::input_iterator InputIt>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::copy_construct_range_values(size_type range_begin, size_type range_size, InputIt first, InputIt last)
+    {
+        if constexpr (is_bitwise_copyable && std::forward_iterator<InputIt>) {
+            // Copy can't throw, so every part of a block is copied at once
+            // my::copy turns this into memmove if source is contiguous or segmented (like another deque)
+            if (!std::is_constant_evaluated()) {
+                for_each_block_part(range_begin, range_size, [&first](pointer part, size_type count) {
+                    const auto part_end = std::next(first, count);
+                    my::copy(first, part_end, part);
+                    first = part_end;
+                });
+                return;
+            }
+        }
+
+        // range_begin is the same type of index as begin_index
+        const auto first_index = range_begin;
+        size_type i = 0;
+
+        try {
+            for (; i < range_size; ++i) {
+                auto current_block = calculate_block_index(range_begin);
+                auto current_offset = calculate_block_offset(range_begin);
+
+                std::allocator_traits<element_allocator_type>::construct(
+                    element_allocator,
+                    data.blocks[current_block] + current_offset,
+                    *first
+                );
 
-            auto destination_block = calculate_block_index(destination_end);
-            auto destination_offset = calculate_block_offset(destination_end);
+                ++first;
+                range_begin = calculate_next_index(range_begin);
+            }
+        } catch (...) {
+            // Elements outside of [begin, end) would never be destroyed otherwise
+            destroy_range(first_index, i);
+            throw;
+        }
+    }
 
-            data.blocks[destination_block][destination_offset] = std::move(data.blocks[source_block][source_offset]);
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <typename Generator>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::emplace_range_from_generator(size_type range_begin, size_type range_size, Generator& generator)
+    {
+        // Blocks are already allocated, so elements are constructed by runs without looking into array of blocks
+        size_type constructed = 0;
+
+        try {
+            for_each_block_part(range_begin, range_size, [this, &generator, &constructed](pointer part, size_type count) {
+                for (const auto part_end = part + count; part != part_end; ++part) {
+                    std::allocator_traits<element_allocator_type>::construct(element_allocator, part, generator());
+                    ++constructed;
+                }
+            });
+        } catch (...) {
+            // Elements outside of [begin, end) would never be destroyed otherwise
+            destroy_range(range_begin, constructed);
+            throw;
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::allocate_blocks(block_type* begin_block, block_type* end_block)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::move_assign_range(size_type source_begin, size_type source_end, size_type destination_begin)
+    {
+        // Elements are moved by runs that lie in one block, for trivially copyable types std::move of a run is memmove
+        for_each_common_block_part(source_begin, destination_begin, data.wrap_index(source_end - source_begin), [](pointer source, pointer destination, size_type count) {
+            std::move(source, source + count, destination);
+        });
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::move_assign_range_backwards(size_type source_begin, size_type source_end, size_type destination_end)
+    {
+        for_each_common_block_part_backwards(source_end, destination_end, data.wrap_index(source_end - source_begin), [](pointer source, pointer destination, size_type count) {
+            std::move_backward(source, source + count, destination + count);
+        });
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::allocate_blocks(block_type* begin_block, block_type* end_block)
     {
         for (auto current_block = begin_block; current_block != end_block; ++current_block) {
             assert((*current_block == nullptr) && "Block is already allocated. You should use this function only with ranges of not allocated blocks");
-            *current_block = std::allocator_traits<element_allocator_type>::allocate(element_allocator, block_size);
+            *current_block = allocate_block();
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::allocate_blocks_unsafe(block_type* begin_block, block_type* end_block)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::allocate_blocks_unsafe(block_type* begin_block, block_type* end_block)
     {
         // Should only be used if you are 100% sure that you will only overwrite garbage pointers
         // For example when you just allocated array of block pointers, but not initialized it with nulls yet
         for (auto current_block = begin_block; current_block != end_block; ++current_block) {
-            *current_block = std::allocator_traits<element_allocator_type>::allocate(element_allocator, block_size);
+            *current_block = allocate_block();
         }
     }
     
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::allocate_blocks_if_not_allocated(block_type* begin_block, block_type* end_block)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::allocate_blocks_if_not_allocated(block_type* begin_block, block_type* end_block)
     {
         for (auto current_block = begin_block; current_block != end_block; ++current_block) {
             if (*current_block == nullptr) {
-                *current_block = std::allocator_traits<element_allocator_type>::allocate(element_allocator, block_size);
+                *current_block = allocate_block();
             }
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr bool deque<T, Allocator>::all_blocks_are_allocated() const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr bool deque<T, Allocator, BlockSizePolicy>::all_blocks_are_allocated() const
     {
         return std::all_of(data.blocks, data.blocks + data.blocks_count, [](block_type block){ return block != nullptr; });
     }
 
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::used_blocks_count() const
+    {
+        if (data.elements_count == 0) {
+            return 0;
+        }
+
+        // Elements can wrap around into the begin block, then all blocks are used
+        const auto used_blocks = ceil_division(calculate_block_offset(data.begin_index) + data.elements_count, block_size);
+        return std::min(used_blocks, data.blocks_count);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::release_spare_blocks()
+    {
+        const auto used_blocks = used_blocks_count();
+        if (data.allocated_blocks_count - used_blocks <= spare_blocks_high_watermark) {
+            return;
+        }
+
+        // Blocks right after the last used one are kept, because push_back reaches them first
+        // Walking all the way around ends at the begin block, so blocks before it are released first
+        const auto begin_block_index = calculate_block_index(data.begin_index);
+        size_type kept_blocks = 0;
+        for (size_type i = used_blocks; i < data.blocks_count; ++i) {
+            auto& block = data.blocks[(begin_block_index + i) & (data.blocks_count - 1)];
+            if (block == nullptr) {
+                continue;
+            }
+
+            if (kept_blocks < spare_blocks_low_watermark) {
+                ++kept_blocks;
+            } else {
+                deallocate_block(block);
+                block = nullptr;
+            }
+        }
+    }
+
 
     
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::potential_capacity_back() const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::potential_capacity_back() const
     {
         if (is_memory_filled()) {
             return 0;
@@ -1613,206 +1904,359 @@ namespace my
         return capacity() - data.elements_count - unavailable_elements;
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::potential_capacity_front() const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::potential_capacity_front() const
     {
         if (is_memory_filled()) {
             return 0;
         }
 
         // Elements after end_index in the same block are reserved for insertion to the back only
-        const auto unavailable_elements = data.block_size - calculate_block_offset(calculate_end_index());
-        return capacity() - data.elements_count - unavailable_elements;
+        // When end_index is in begin block (behind begin_index) all free elements are there
+        const auto free_elements = capacity() - data.elements_count;
+        const auto unavailable_elements = std::min(free_elements, data.block_size - calculate_block_offset(calculate_end_index()));
+        return free_elements - unavailable_elements;
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::reserve_back(size_type n)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::reserve_back(size_type n)
     {
+        if (n == 0) {
+            return;
+        }
+
         if (potential_capacity_back() < n) { // Allocate larger array of blocks
-            // Calculate required number of new blocks
-            const auto extra_elements_count = n - potential_capacity_back();
-            const auto extra_blocks_count = ceil_division(extra_elements_count, block_size);
-            const auto new_blocks_count = std::max<size_type>(data.blocks_count + extra_blocks_count, 2);
-
-            // Allocate new array for block and copy old data
-            auto new_blocks = std::allocator_traits<block_allocator_type>::allocate(block_allocator, new_blocks_count);
-            auto begin_block_index = calculate_block_index(data.begin_index);
-
-            if (data.blocks == nullptr) {
-                allocate_blocks_unsafe(new_blocks, new_blocks + new_blocks_count);
-            } else if (data.begin_index < calculate_end_index()) {
-                // Deque looks like this:
-                //    begin      end
-                //      v         v
-                // [ | |#|#|#|#|#| ]
-                const auto front_empty_blocks_count = begin_block_index;
-                const auto back_empty_blocks_count = data.blocks_count - ceil_division(calculate_end_index(), block_size);
-                const auto filled_blocks_count = data.blocks_count - (front_empty_blocks_count + back_empty_blocks_count);
-
-                // Copy all blocks
-                std::copy(data.blocks, data.blocks + data.blocks_count, new_blocks);
-                allocate_blocks_if_not_allocated(new_blocks, new_blocks + front_empty_blocks_count);
-                allocate_blocks_if_not_allocated(new_blocks + front_empty_blocks_count + filled_blocks_count, new_blocks + data.blocks_count);
-                allocate_blocks(new_blocks + data.blocks_count, new_blocks + new_blocks_count);
-            } else {
-                // And here we deal with this case:
-                //       end    begin
-                //        v       v
-                // [#|#|#| | | | |#]
-                const auto back_blocks_count = data.blocks_count - begin_block_index;
-                const auto front_blocks_count = ceil_division(calculate_end_index(), block_size);
-                std::copy(data.blocks + begin_block_index, data.blocks + data.blocks_count, new_blocks);
-                std::copy(data.blocks, data.blocks + front_blocks_count, new_blocks + back_blocks_count);
-                std::copy(
-                    data.blocks + front_blocks_count,
-                    data.blocks + back_blocks_count,
-                    new_blocks + back_blocks_count + front_blocks_count
-                ); // Copy free blocks, because they can be empty but allocated and we don't want to leak
-                allocate_blocks_if_not_allocated(new_blocks + back_blocks_count + front_blocks_count, new_blocks + data.blocks_count);
-                allocate_blocks(new_blocks + data.blocks_count, new_blocks + new_blocks_count);
-            }
-            
-            deallocate_blocks_array();
-            data.blocks = new_blocks;
-            data.blocks_count = new_blocks_count;
-        } else {
-            const auto free_elements_in_last_block = data.block_size - calculate_block_offset(calculate_end_index());
-            auto allocated_elements = free_elements_in_last_block;
+            // After blocks are moved elements start at the same offset in the first block
+            // Elements before begin_index in the same block are reserved for insertion to the front only
+            const auto required_capacity = calculate_block_offset(data.begin_index) + data.elements_count + n;
+            // At least doubled, so repeated insertions do not reallocate array of blocks every time
+            // Only pointers are allocated here, blocks themselves are allocated when needed
+            const auto new_blocks_count = std::bit_ceil(std::max<size_type>({ ceil_division(required_capacity, block_size), data.blocks_count * 2, 2 }));
+
+            reallocate_blocks_array(new_blocks_count);
+        }
 
-            size_type block;
-            if (free_elements_in_last_block > 0) {
-                block = next_block_index(calculate_block_index(calculate_end_index()));
-            } else {
-                block = calculate_block_index(calculate_end_index());
+        // Allocate only blocks that will hold new elements
+        const auto end_index = calculate_end_index();
+        const auto first_block = calculate_block_index(end_index);
+        const auto last_block = calculate_block_index(calculate_next_index(end_index, n - 1));
+
+        for (auto block = first_block; ; block = next_block_index(block)) {
+            if (data.blocks[block] == nullptr) {
+                data.blocks[block] = allocate_block();
             }
 
-            for (; allocated_elements < n; block = next_block_index(block), allocated_elements += data.block_size) {
-                if (data.blocks[block] == nullptr) {
-                    data.blocks[block] = std::allocator_traits<element_allocator_type>::allocate(element_allocator, data.block_size);
-                }
+            if (block == last_block) {
+                break;
             }
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::reserve_front(size_type n)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::reserve_front(size_type n)
     {
+        if (n == 0) {
+            return;
+        }
+
         if (potential_capacity_front() < n) { // Allocate larger array of blocks
-            // Calculate required number of new blocks
-            const auto extra_elements_count = n - potential_capacity_front();
-            const auto extra_blocks_count = ceil_division(extra_elements_count, block_size);
-            const auto new_blocks_count = std::max<size_type>(data.blocks_count + extra_blocks_count, 2);
-
-            // Allocate new array for block and copy old data
-            auto new_blocks = std::allocator_traits<block_allocator_type>::allocate(block_allocator, new_blocks_count);
-            auto begin_block_index = calculate_block_index(data.begin_index);
-            
-            if (data.blocks == nullptr) {
-                allocate_blocks_unsafe(new_blocks, new_blocks + new_blocks_count);
-            } else if (data.begin_index < calculate_end_index()) {
-                // Deque looks like this:
-                //    begin      end
-                //      v         v
-                // [ | |#|#|#|#|#| ]
-                const auto front_empty_blocks_count = begin_block_index;
-                const auto back_empty_blocks_count = data.blocks_count - ceil_division(calculate_end_index(), block_size);
-                const auto filled_blocks_count = data.blocks_count - (front_empty_blocks_count + back_empty_blocks_count);
-
-                // Copy all blocks
-                std::copy(data.blocks, data.blocks + data.blocks_count, new_blocks);
-                allocate_blocks_if_not_allocated(new_blocks, new_blocks + front_empty_blocks_count);
-                allocate_blocks_if_not_allocated(new_blocks + front_empty_blocks_count + filled_blocks_count, new_blocks + data.blocks_count);
-                allocate_blocks(new_blocks + data.blocks_count, new_blocks + new_blocks_count);
-            } else {
-                // And here we deal with this case:
-                //       end    begin
-                //        v       v
-                // [#|#|#| | | | |#]
-                const auto back_blocks_count = data.blocks_count - begin_block_index;
-                const auto front_blocks_count = ceil_division(calculate_end_index(), block_size);
-                std::copy(data.blocks + begin_block_index, data.blocks + data.blocks_count, new_blocks);
-                std::copy(data.blocks, data.blocks + front_blocks_count, new_blocks + back_blocks_count);
-                std::copy(
-                    data.blocks + front_blocks_count,
-                    data.blocks + back_blocks_count,
-                    new_blocks + back_blocks_count + front_blocks_count
-                ); // Copy free blocks, because they can be empty but allocated and we don't want to leak
-                allocate_blocks_if_not_allocated(new_blocks + back_blocks_count + front_blocks_count, new_blocks + data.blocks_count);
-                allocate_blocks(new_blocks + data.blocks_count, new_blocks + new_blocks_count);
+            // After blocks are moved elements start at the same offset in the first block
+            // Elements after end_index in the same block are reserved for insertion to the back only
+            const auto end_offset = calculate_block_offset(calculate_block_offset(data.begin_index) + data.elements_count);
+            const auto required_capacity = data.elements_count + n + (block_size - end_offset);
+            // At least doubled, so repeated insertions do not reallocate array of blocks every time
+            // Only pointers are allocated here, blocks themselves are allocated when needed
+            const auto new_blocks_count = std::bit_ceil(std::max<size_type>({ ceil_division(required_capacity, block_size), data.blocks_count * 2, 2 }));
+
+            reallocate_blocks_array(new_blocks_count);
+        }
+
+        // Allocate only blocks that will hold new elements
+        const auto first_block = calculate_block_index(calculate_previous_index(data.begin_index, n));
+        const auto last_block = calculate_block_index(calculate_previous_index(data.begin_index));
+
+        for (auto block = first_block; ; block = next_block_index(block)) {
+            if (data.blocks[block] == nullptr) {
+                data.blocks[block] = allocate_block();
             }
-            
-            deallocate_blocks_array();
-            data.blocks = new_blocks;
-            data.blocks_count = new_blocks_count;
-        } else {
-            const auto free_elements_in_first_block = calculate_block_offset(data.begin_index);
-            auto allocated_elements = free_elements_in_first_block;
-            for (
-                auto block = previous_block_index(calculate_block_index(data.begin_index));
-                allocated_elements < n;
-                block = previous_block_index(block), allocated_elements += data.block_size
-            ) {
-                if (data.blocks[block] == nullptr) {
-                    data.blocks[block] = std::allocator_traits<element_allocator_type>::allocate(element_allocator, data.block_size);
-                }
+
+            if (block == last_block) {
+                break;
             }
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::next_block_index(size_type block_index) const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::reallocate_blocks_array(size_type new_blocks_count)
     {
-        return (block_index + 1) % data.blocks_count;
+        assert((new_blocks_count > data.blocks_count) && "Array of blocks can only grow");
+        assert(std::has_single_bit(new_blocks_count) && "Number of blocks must be power of two");
+
+        auto new_blocks = std::allocator_traits<block_allocator_type>::allocate(block_allocator, new_blocks_count);
+        const auto begin_block_index = calculate_block_index(data.begin_index);
+
+        // Begin block becomes the first one, so both of these cases end up with elements in one piece
+        //    begin      end            end    begin
+        //      v         v              v       v
+        // [ | |#|#|#|#|#| ]      [#|#|#| | | | |#]
+        // And new blocks can be placed after all old ones
+        std::rotate_copy(data.blocks, data.blocks + begin_block_index, data.blocks + data.blocks_count, new_blocks);
+        std::fill(new_blocks + data.blocks_count, new_blocks + new_blocks_count, nullptr);
+
+        if (data.blocks != nullptr) {
+            deallocate_blocks_array();
+        }
+
+        data.begin_index = calculate_block_offset(data.begin_index);
+        data.blocks = new_blocks;
+        data.blocks_count = new_blocks_count;
+        ++map_reallocations;
     }
 
-    template <typename T, typename Allocator>
-    constexpr deque<T, Allocator>::size_type deque<T, Allocator>::previous_block_index(size_type block_index) const
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <std::forward_iterator I>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::insert_counted(const_iterator pos, I first, size_type count)
     {
-        return (data.blocks_count + block_index - 1) % data.blocks_count;
-    }
+        if (count == 0) {
+            return begin() + (pos - cbegin());
+        }
 
+        const I last = std::next(first, count);
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::move_construct_range(size_type source_begin, size_type source_end, size_type destination_begin)
-    {
-        while (source_begin != source_end) {
-            auto source_block = calculate_block_index(source_begin);
-            auto source_offset = calculate_block_offset(source_begin);
+        // Checked first, so empty deque is filled from the back
+        // Filling all blocks from the front would need begin_index to move by whole capacity
+        if (pos == cend()) {
+            reserve_back(count);
+            copy_construct_range_values(calculate_end_index(), count, first, last);
+            data.elements_count += count;
 
-            auto destination_block = calculate_block_index(destination_begin);
-            auto destination_offset = calculate_block_offset(destination_begin);
+            return end() - count;
+        }
 
-            std::allocator_traits<element_allocator_type>::construct(
-                element_allocator,
-                data.blocks[destination_block] + destination_offset,
-                std::move(data.blocks[source_block][source_offset])
-            );
+        if (pos == cbegin()) {
+            reserve_front(count);
+            copy_construct_range_values(calculate_previous_index(data.begin_index, count), count, first, last);
+            data.elements_count += count;
+            data.begin_index = calculate_previous_index(data.begin_index, count);
+            
+            return begin();
+        }
 
-            source_begin = calculate_next_index(source_begin);
-            destination_begin = calculate_next_index(destination_begin);
+        bool is_pos_closer_to_begin = pos - cbegin() < cend() - pos;
+        if (is_pos_closer_to_begin) {
+            const auto elements_to_move = static_cast<size_type>(pos - cbegin());
+            reserve_front(count);
+
+            if (count < elements_to_move) {
+                // First count elements are moved into uninitialized memory
+                move_construct_range(
+                    data.begin_index,
+                    calculate_next_index(data.begin_index, count),
+                    calculate_previous_index(data.begin_index, count)
+                );
+
+                // Other elements are moved to begin
+                move_assign_range(
+                    calculate_next_index(data.begin_index, count),
+                    calculate_next_index(data.begin_index, elements_to_move),
+                    data.begin_index
+                );
+
+                // Fill the gap with elements from iterator range
+                copy_assign_range(
+                    first,
+                    last,
+                    calculate_next_index(data.begin_index, elements_to_move - count)
+                );
+            }
+
+            if (count == elements_to_move) {
+                // Trivial case
+                // All elements before pos are moved to uninitialized memory
+                move_construct_range(
+                    data.begin_index, 
+                    calculate_next_index(data.begin_index, elements_to_move),
+                    calculate_previous_index(data.begin_index, elements_to_move)
+                );
+
+                // Assign copies of elements from iterator range to moved-from objects
+                copy_assign_range(
+                    first,
+                    last,
+                    data.begin_index
+                );
+            }
+
+            if (count > elements_to_move) {
+                // Move first (elements_to_move) elements to uninitialized memory
+                move_construct_range(
+                    data.begin_index,
+                    calculate_next_index(data.begin_index, elements_to_move),
+                    calculate_previous_index(data.begin_index, count)
+                );
+
+                // Construct (count - elements_to_move) elements from iterator range in uninitialized memory
+                copy_construct_range_values(
+                    calculate_previous_index(data.begin_index, count - elements_to_move),
+                    count - elements_to_move,
+                    first,
+                    last
+                );
+
+                // Fill moved-from elements with copies of elements from iterator range
+                copy_assign_range(
+                    std::next(first, count - elements_to_move),
+                    last,
+                    data.begin_index
+                );
+            }
+
+            data.begin_index = calculate_previous_index(data.begin_index, count);
+            data.elements_count += count;
+            return begin() + elements_to_move;
+        } else {
+            const auto elements_to_move = static_cast<size_type>(cend() - pos);
+            reserve_back(count);
+            const auto end_index = calculate_end_index();
+
+            if (count < elements_to_move) {
+                // Move last (count) elements to uninitialized memory
+                move_construct_range(
+                    calculate_previous_index(end_index, count),
+                    end_index,
+                    end_index
+                );
+
+                // Move other (elements_to_move - count) elements to the end
+                // Ranges overlap and destination is after source, so elements are moved from the back
+                move_assign_range_backwards(
+                    calculate_previous_index(end_index, elements_to_move),
+                    calculate_previous_index(end_index, count),
+                    end_index
+                );
+
+                // Copy values from iterator range
+                copy_assign_range(
+                    first,
+                    last,
+                    calculate_previous_index(end_index, elements_to_move)
+                );
+            }
+
+            if (count == elements_to_move) {
+                // Move all elements after pos (including pos) to uninitialized memory
+                move_construct_range(
+                    calculate_previous_index(end_index, count),
+                    end_index,
+                    end_index
+                );
+
+                // Copy values from iterator range
+                copy_assign_range(
+                    first,
+                    last,
+                    calculate_previous_index(end_index, count)
+                );
+            }
+
+            if (count > elements_to_move) {
+                // Move all elements after pos (including pos) (count) places forward to make space for new values
+                move_construct_range(
+                    calculate_previous_index(end_index, elements_to_move),
+                    end_index,
+                    calculate_next_index(end_index, count - elements_to_move)
+                );
+
+                // Construct (count - elements_to_move) values from iterator range in uninitialized memory
+                copy_construct_range_values(
+                    end_index,
+                    count - elements_to_move, // Number of elements
+                    std::next(first, elements_to_move),
+                    last
+                );
+
+                // Assign copies of value to moved-from elements
+                copy_assign_range(
+                    first,
+                    std::next(first, elements_to_move),
+                    calculate_previous_index(end_index, elements_to_move)
+                );
+            }
+
+            data.elements_count += count;
+            return end() - (count + elements_to_move);
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::copy_assign_range(size_type source_begin, size_type source_end, size_type destination_begin)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <std::input_iterator I, std::sentinel_for<I> S>
+    constexpr deque<T, Allocator, BlockSizePolicy>::iterator deque<T, Allocator, BlockSizePolicy>::insert_single_pass(const_iterator pos, I first, S last)
     {
-        while (source_begin != source_end) {
-            auto source_block = calculate_block_index(source_begin);
-            auto source_offset = calculate_block_offset(source_begin);
+        const auto insert_position = pos - cbegin();
+        const auto old_size = size();
 
-            auto destination_block = calculate_block_index(destination_begin);
-            auto destination_offset = calculate_block_offset(destination_begin);
+        try {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        } catch (...) {
+            // Remove what was appended, so old elements stay in their places
+            destroy_range(calculate_next_index(data.begin_index, old_size), size() - old_size);
+            data.elements_count = old_size;
+            throw;
+        }
 
-            data.blocks[destination_block][destination_offset] = data.blocks[source_block][source_offset];
+        std::rotate(begin() + insert_position, begin() + old_size, end());
 
-            source_begin = calculate_next_index(source_begin);
-            destination_begin = calculate_next_index(destination_begin);
+        return begin() + insert_position;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::next_block_index(size_type block_index) const
+    {
+        return (block_index + 1) & (data.blocks_count - 1);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr deque<T, Allocator, BlockSizePolicy>::size_type deque<T, Allocator, BlockSizePolicy>::previous_block_index(size_type block_index) const
+    {
+        return (block_index - 1) & (data.blocks_count - 1);
+    }
+
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::move_construct_range(size_type source_begin, size_type source_end, size_type destination_begin)
+    {
+        const auto range_size = data.wrap_index(source_end - source_begin);
+
+        if constexpr (is_bitwise_copyable) {
+            // Same as in copy_construct_range_values, every run is copied at once
+            if (!std::is_constant_evaluated()) {
+                for_each_common_block_part(source_begin, destination_begin, range_size, [](pointer source, pointer destination, size_type count) {
+                    std::copy(source, source + count, destination);
+                });
+                return;
+            }
         }
+
+        for_each_common_block_part(source_begin, destination_begin, range_size, [this](pointer source, pointer destination, size_type count) {
+            for (size_type i = 0; i < count; ++i) {
+                std::allocator_traits<element_allocator_type>::construct(element_allocator, destination + i, std::move(source[i]));
+            }
+        });
     }
 
-    template <typename T, typename Allocator>
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::copy_assign_range(size_type source_begin, size_type source_end, size_type destination_begin)
+    {
+        for_each_common_block_part(source_begin, destination_begin, data.wrap_index(source_end - source_begin), [](pointer source, pointer destination, size_type count) {
+            std::copy(source, source + count, destination);
+        });
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
     template <std::input_iterator InputIt>
-    constexpr void deque<T, Allocator>::copy_assign_range(InputIt source_begin, InputIt source_end, size_type destination_begin)
+    constexpr void deque<T, Allocator, BlockSizePolicy>::copy_assign_range(InputIt source_begin, InputIt source_end, size_type destination_begin)
     {
         while (source_begin != source_end) {
             auto destination_block = calculate_block_index(destination_begin);
@@ -1825,17 +2269,12 @@ namespace my
         }
     }
 
-    template <typename T, typename Allocator>
-    constexpr void deque<T, Allocator>::copy_assign_range_values(size_type destination_begin, size_type destination_end, const value_type& value)
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    constexpr void deque<T, Allocator, BlockSizePolicy>::copy_assign_range_values(size_type destination_begin, size_type destination_end, const value_type& value)
     {
-        while (destination_begin != destination_end) {
-            auto destination_block = calculate_block_index(destination_begin);
-            auto destination_offset = calculate_block_offset(destination_begin);
-
-            data.blocks[destination_block][destination_offset] = value;
-
-            destination_begin = calculate_next_index(destination_begin);
-        }
+        for_each_block_part(destination_begin, data.wrap_index(destination_end - destination_begin), [&value](pointer part, size_type count) {
+            std::fill_n(part, count, value);
+        });
     }
 }
 
@@ -0,0 +1,155 @@
+#ifndef TOY_SDL_DEQUE_BLOCK_POOL_HPP
+#define TOY_SDL_DEQUE_BLOCK_POOL_HPP
+
+#include "deque_block_size_policy.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace my
+{
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    class deque;
+
+    // Allocator that keeps freed deque blocks in a thread-local free list and hands them out again
+    // Only allocations of exactly one block go through the pool, everything else goes to std::allocator
+    // Deque rebinds allocator to T* for array of blocks, so arrays of length block_size(sizeof(T*)) are pooled too,
+    // in the separate pool of T*
+    // Pool is shared by all deques of the same T and BlockSizePolicy on the same thread
+    // Block can be freed on another thread, then it just ends up in the pool of that thread
+    // Pool is thread_local and is destroyed before objects with static storage duration,
+    // blocks freed after that (for example by a static pooled_deque) go directly to std::allocator
+    template <typename T, block_size_policy BlockSizePolicy = default_block_size, std::size_t MaxCachedBlocks = 1024>
+    class block_pool_allocator
+    {
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = block_pool_allocator<U, BlockSizePolicy, MaxCachedBlocks>;
+        };
+
+        // Same formula as in deque_data
+        constexpr static std::size_t block_size = BlockSizePolicy::block_size(sizeof(T));
+
+        block_pool_allocator() = default;
+        template <typename U>
+        constexpr block_pool_allocator(const block_pool_allocator<U, BlockSizePolicy, MaxCachedBlocks>&) noexcept { }
+
+        constexpr T* allocate(std::size_t n);
+        constexpr void deallocate(T* p, std::size_t n);
+
+        // Number of blocks in the pool of the current thread
+        static std::size_t cached_blocks() noexcept;
+
+        template <typename U>
+        constexpr bool operator==(const block_pool_allocator<U, BlockSizePolicy, MaxCachedBlocks>&) const noexcept
+        {
+            return true;
+        }
+
+    private:
+        // Free list is stored inside of the free blocks themselves
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        struct pool
+        {
+            free_block* head { nullptr };
+            std::size_t size { 0 };
+
+            ~pool();
+        };
+
+        // Returns nullptr after pool of the current thread is destroyed
+        static pool* thread_pool() noexcept;
+        // Trivially destructible, so it can still be read after the pool is gone
+        inline static thread_local bool pool_destroyed = false;
+
+        // Blocks come from operator new, so they are always aligned enough for free_block
+        // Too small blocks are never pooled
+        constexpr static bool can_pool = block_size * sizeof(T) >= sizeof(free_block);
+    };
+
+    // Deque which takes blocks from thread-local pool instead of calling allocator every time
+    template <typename T, block_size_policy BlockSizePolicy = default_block_size>
+    using pooled_deque = deque<T, block_pool_allocator<T, BlockSizePolicy>, BlockSizePolicy>;
+
+    template <typename T, block_size_policy BlockSizePolicy, std::size_t MaxCachedBlocks>
+    constexpr T* block_pool_allocator<T, BlockSizePolicy, MaxCachedBlocks>::allocate(std::size_t n)
+    {
+        if constexpr (can_pool) {
+            if (!std::is_constant_evaluated() && n == block_size) {
+                auto free_blocks = thread_pool();
+                if (free_blocks != nullptr && free_blocks->head != nullptr) {
+                    auto block = free_blocks->head;
+                    free_blocks->head = block->next;
+                    free_blocks->size -= 1;
+
+                    std::destroy_at(block);
+                    return static_cast<T*>(static_cast<void*>(block));
+                }
+            }
+        }
+
+        return std::allocator<T>{ }.allocate(n);
+    }
+
+    template <typename T, block_size_policy BlockSizePolicy, std::size_t MaxCachedBlocks>
+    constexpr void block_pool_allocator<T, BlockSizePolicy, MaxCachedBlocks>::deallocate(T* p, std::size_t n)
+    {
+        if constexpr (can_pool) {
+            if (!std::is_constant_evaluated() && n == block_size) {
+                auto free_blocks = thread_pool();
+                if (free_blocks != nullptr && free_blocks->size < MaxCachedBlocks) {
+                    free_blocks->head = ::new (static_cast<void*>(p)) free_block { free_blocks->head };
+                    free_blocks->size += 1;
+                    return;
+                }
+            }
+        }
+
+        std::allocator<T>{ }.deallocate(p, n);
+    }
+
+    template <typename T, block_size_policy BlockSizePolicy, std::size_t MaxCachedBlocks>
+    std::size_t block_pool_allocator<T, BlockSizePolicy, MaxCachedBlocks>::cached_blocks() noexcept
+    {
+        const auto free_blocks = thread_pool();
+        return free_blocks != nullptr ? free_blocks->size : 0;
+    }
+
+    template <typename T, block_size_policy BlockSizePolicy, std::size_t MaxCachedBlocks>
+    block_pool_allocator<T, BlockSizePolicy, MaxCachedBlocks>::pool::~pool()
+    {
+        // Blocks are returned to std::allocator when thread exits
+        pool_destroyed = true;
+        while (head != nullptr) {
+            auto block = head;
+            head = block->next;
+
+            std::destroy_at(block);
+            std::allocator<T>{ }.deallocate(static_cast<T*>(static_cast<void*>(block)), block_size);
+        }
+    }
+
+    template <typename T, block_size_policy BlockSizePolicy, std::size_t MaxCachedBlocks>
+    block_pool_allocator<T, BlockSizePolicy, MaxCachedBlocks>::pool* block_pool_allocator<T, BlockSizePolicy, MaxCachedBlocks>::thread_pool() noexcept
+    {
+        if (pool_destroyed) {
+            return nullptr;
+        }
+
+        thread_local pool free_blocks;
+        return &free_blocks;
+    }
+}
+
+#endif /* TOY_SDL_DEQUE_BLOCK_POOL_HPP */
@@ -0,0 +1,61 @@
+#ifndef TOY_SDL_DEQUE_BLOCK_SIZE_POLICY_HPP
+#define TOY_SDL_DEQUE_BLOCK_SIZE_POLICY_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <type_traits>
+
+namespace my
+{
+    // Block size policy decides how many elements are stored in one block of deque
+    // It is called with size of one element in bytes at compile time and must return power of two
+    // Larger blocks mean fewer allocations and block crossings, smaller blocks waste less memory in half-empty deques
+    template <typename P>
+    concept block_size_policy = requires
+    {
+        { P::block_size(std::size_t { 1 }) } -> std::convertible_to<std::size_t>;
+        // Fails if block_size can't be called in constant expression
+        typename std::integral_constant<std::size_t, P::block_size(1)>;
+    };
+
+    // Fits as many elements as possible into Bytes, but at least MinElements
+    // Result is rounded down to power of two
+    template <std::size_t Bytes, std::size_t MinElements = 16>
+    struct block_bytes
+    {
+        static_assert(MinElements > 0, "Block must hold at least one element");
+
+        constexpr static std::size_t block_size(std::size_t element_size)
+        {
+            return std::bit_floor(std::max(Bytes / element_size, MinElements));
+        }
+    };
+
+    // Always stores Elements elements in a block
+    template <std::size_t Elements>
+    struct block_elements
+    {
+        static_assert(std::has_single_bit(Elements), "Number of elements in a block must be power of two");
+
+        constexpr static std::size_t block_size(std::size_t /* element_size */)
+        {
+            return Elements;
+        }
+    };
+
+    // Works like clang strategy
+    // When sizeof(value_type) < 256 you get maximum number of elements you can fit in 4096 bytes
+    // Otherwise you always get 16 elements
+    using default_block_size = block_bytes<4096, 16>;
+
+    // For throughput-oriented queues, blocks are allocated and crossed less often
+    using large_block_size = block_bytes<64 * 1024, 16>;
+    // Size of a huge page, alignment of blocks is decided by allocator
+    using huge_page_block_size = block_bytes<2 * 1024 * 1024, 16>;
+    // For many tiny deques, so that single element does not allocate 4 KiB
+    using small_block_size = block_bytes<256, 4>;
+}
+
+#endif /* TOY_SDL_DEQUE_BLOCK_SIZE_POLICY_HPP */
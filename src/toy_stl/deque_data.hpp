@@ -1,27 +1,27 @@
 #ifndef TOY_SDL_DEQUE_DATA_HPP
 #define TOY_SDL_DEQUE_DATA_HPP
 
+#include "deque_block_size_policy.hpp"
+
 #include <cmath>
 #include <cassert>
+#include <algorithm>
+#include <bit>
 
 namespace my
 {
-    template <typename value_type, typename size_type>
-    constexpr size_type calculate_block_size()
-    {
-        // Should work like clang strategy
-        // When sizeof(value_type) < 256 you get maximum number of elements you can fit in 4096 bytes
-        // Otherwise you always get 16 elements
-        return std::max(4096 / sizeof(value_type), std::size_t{ 16 });
-    }
-
-    template <typename value_type, typename size_type>
+    template <typename value_type, typename size_type, block_size_policy BlockSizePolicy = default_block_size>
     struct deque_data
     {
         using block_type = value_type*; // Chunk of memory with size = block_size
-        constexpr static size_type block_size = calculate_block_size<value_type, size_type>();
+        constexpr static size_type block_size = BlockSizePolicy::block_size(sizeof(value_type));
+        static_assert(std::has_single_bit(block_size), "Block size must be power of two");
+
+        constexpr static size_type block_shift = std::countr_zero(block_size);
+        constexpr static size_type block_mask = block_size - 1;
 
         // Circular array of blocks with size = blocks_count
+        // blocks_count is always 0 or power of two, so capacity is power of two too and wraparound is a mask
         block_type* blocks { nullptr };
         size_type blocks_count { 0 };
         // Index like in array of size block_count * block_size
@@ -29,7 +29,11 @@ namespace my
         // And supports wrapping around
         size_type begin_index { 0 }; // Maybe should change to signed type
         size_type elements_count { 0 };
+        // Number of non-null pointers in blocks
+        size_type allocated_blocks_count { 0 };
 
+        // Maps any index to range [0, capacity), deque must have at least one block
+        constexpr size_type wrap_index(size_type index) const;
         constexpr size_type calculate_previous_index(size_type current_index, size_type offset = 1) const;
         constexpr size_type calculate_next_index(size_type current_index, size_type offset = 1) const;
 
@@ -39,35 +43,43 @@ namespace my
         constexpr size_type capacity() const;
     };
 
-    template <typename value_type, typename size_type>
-    constexpr size_type deque_data<value_type, size_type>::calculate_previous_index(size_type current_index, size_type offset) const
+    template <typename value_type, typename size_type, block_size_policy BlockSizePolicy>
+    constexpr size_type deque_data<value_type, size_type, BlockSizePolicy>::wrap_index(size_type index) const
+    {
+        assert((blocks_count > 0) && "Deque has no blocks");
+        assert(std::has_single_bit(blocks_count) && "Number of blocks must be power of two");
+        return index & (capacity() - 1);
+    }
+
+    template <typename value_type, typename size_type, block_size_policy BlockSizePolicy>
+    constexpr size_type deque_data<value_type, size_type, BlockSizePolicy>::calculate_previous_index(size_type current_index, size_type offset) const
     {
         assert((0 <= offset && offset < capacity()) && "Invalid offset");
-        // + capacity to not wrap around
-        return (current_index + capacity() - offset) % capacity();
+        // Unsigned overflow is fine here, because capacity divides 2^N
+        return wrap_index(current_index - offset);
     }
 
-    template <typename value_type, typename size_type>
-    constexpr size_type deque_data<value_type, size_type>::calculate_next_index(size_type current_index, size_type offset) const
+    template <typename value_type, typename size_type, block_size_policy BlockSizePolicy>
+    constexpr size_type deque_data<value_type, size_type, BlockSizePolicy>::calculate_next_index(size_type current_index, size_type offset) const
     {
         assert((0 <= offset && offset < capacity()) && "Invalid offset");
-        return (current_index + offset) % capacity();
+        return wrap_index(current_index + offset);
     }
 
-    template <typename value_type, typename size_type>
-    constexpr size_type deque_data<value_type, size_type>::calculate_block_index(size_type element_index) const
+    template <typename value_type, typename size_type, block_size_policy BlockSizePolicy>
+    constexpr size_type deque_data<value_type, size_type, BlockSizePolicy>::calculate_block_index(size_type element_index) const
     {
-        return element_index / block_size;
+        return element_index >> block_shift;
     }
 
-    template <typename value_type, typename size_type>
-    constexpr size_type deque_data<value_type, size_type>::calculate_block_offset(size_type element_index) const
+    template <typename value_type, typename size_type, block_size_policy BlockSizePolicy>
+    constexpr size_type deque_data<value_type, size_type, BlockSizePolicy>::calculate_block_offset(size_type element_index) const
     {
-        return element_index % block_size;
+        return element_index & block_mask;
     }
 
-    template <typename value_type, typename size_type>
-    constexpr size_type deque_data<value_type, size_type>::capacity() const
+    template <typename value_type, typename size_type, block_size_policy BlockSizePolicy>
+    constexpr size_type deque_data<value_type, size_type, BlockSizePolicy>::capacity() const
     {
         return block_size * blocks_count;
     }
@@ -8,11 +8,18 @@
 
 namespace my
 {
+    template <typename Deq, bool IsConst>
+    class deque_segments;
+
+    // Segmented iterator
+    // Caches position inside of the current block, so increment and dereference are pointer operations
+    // and only crossing block boundary has to look into array of blocks
     template <typename Deq>
     class deque_iterator
     {
     private:
         using deque_data_type = typename Deq::deque_data_type;
+        using block_type = typename Deq::block_type;
         using size_type = typename Deq::size_type;
 
         constexpr static size_type block_size = Deq::block_size;
@@ -52,22 +59,34 @@ namespace my
         reference operator[](difference_type n) const;
         reference operator*() const;
         pointer operator->() const;
-    
+
     private:
+        template <typename, bool>
+        friend class deque_segments;
+
+        // Finds block and element for index, this is the only place with division and modulo
+        void seek(size_type new_index);
+        // Makes block_slot current, block can be not allocated if iterator points past the last element
+        void set_block(block_type* block_slot);
+
         deque_data_type* data { nullptr };
 
         // Index here is relative to begin_index from deque_data
-        // To access data you first need to find absolute index (with wraparound)
-        // Then find block index and offset from it
+        // It is used for comparisons and distances, so these do not depend on layout of blocks
         size_type index { 0 };
+
+        // Cached position of the element at index
+        block_type* block { nullptr }; // Element of circular array of blocks
+        pointer current { nullptr };
+        pointer block_begin { nullptr };
+        pointer block_end { nullptr };
     };
 
     template <typename T>
     deque_iterator<T>::deque_iterator(deque_data_type* data, size_type index) :
-        data(data),
-        index(index)
+        data(data)
     {
-        
+        seek(index);
     }
 
     template <typename T>
@@ -88,6 +107,19 @@ namespace my
     deque_iterator<T>& deque_iterator<T>::operator++()
     {
         ++index;
+        ++current;
+
+        if (current == block_end) {
+            // Array of blocks is circular, so the last block is followed by the first one
+            auto next_block = block + 1;
+            if (next_block == data->blocks + data->blocks_count) {
+                next_block = data->blocks;
+            }
+
+            set_block(next_block);
+            current = block_begin;
+        }
+
         return *this;
     }
 
@@ -103,6 +135,19 @@ namespace my
     deque_iterator<T>& deque_iterator<T>::operator--()
     {
         --index;
+
+        if (current == block_begin) {
+            auto previous_block = block;
+            if (previous_block == data->blocks) {
+                previous_block = data->blocks + data->blocks_count;
+            }
+
+            set_block(previous_block - 1);
+            current = block_end != nullptr ? block_end - 1 : nullptr;
+        } else {
+            --current;
+        }
+
         return *this;
     }
 
@@ -117,7 +162,15 @@ namespace my
     template<typename T>
     deque_iterator<T>& deque_iterator<T>::operator+=(difference_type n)
     {
-        index += n;
+        // Moving inside of the current block does not need to look into array of blocks
+        const auto offset = (current - block_begin) + n;
+        if (block_begin != nullptr && 0 <= offset && offset < static_cast<difference_type>(block_size)) {
+            index += n;
+            current += n;
+        } else {
+            seek(index + n);
+        }
+
         return *this;
     }
 
@@ -138,8 +191,7 @@ namespace my
     template<typename T>
     deque_iterator<T>& deque_iterator<T>::operator-=(difference_type n)
     {
-        index -= n;
-        return *this;
+        return *this += -n;
     }
 
     template <typename T>
@@ -158,28 +210,44 @@ namespace my
     template<typename T>
     deque_iterator<T>::reference deque_iterator<T>::operator[](difference_type n) const
     {
-        const auto absolute_index = data->calculate_next_index(data->begin_index, index + n);
-        const auto block_index = data->calculate_block_index(absolute_index);
-        const auto block_offset = data->calculate_block_offset(absolute_index);
-        return data->blocks[block_index][block_offset];
+        return *(*this + n);
     }
 
     template <typename T>
     deque_iterator<T>::reference deque_iterator<T>::operator*() const
     {
-        const auto absolute_index = data->calculate_next_index(data->begin_index, index);
-        const auto block_index = data->calculate_block_index(absolute_index);
-        const auto block_offset = data->calculate_block_offset(absolute_index);
-        return data->blocks[block_index][block_offset];
+        return *current;
     }
 
     template <typename T>
     deque_iterator<T>::pointer deque_iterator<T>::operator->() const
     {
-        const auto absolute_index = data->calculate_next_index(data->begin_index, index);
-        const auto block_index = data->calculate_block_index(absolute_index);
-        const auto block_offset = data->calculate_block_offset(absolute_index);
-        return data->blocks[block_index] + block_offset;
+        return current;
+    }
+
+    template <typename T>
+    void deque_iterator<T>::seek(size_type new_index)
+    {
+        index = new_index;
+
+        if (data == nullptr || data->blocks_count == 0) {
+            block = nullptr;
+            current = block_begin = block_end = nullptr;
+            return;
+        }
+
+        // Index can be equal to capacity if deque is full, so it is wrapped here instead of calculate_next_index
+        const auto absolute_index = data->wrap_index(data->begin_index + index);
+        set_block(data->blocks + data->calculate_block_index(absolute_index));
+        current = block_begin != nullptr ? block_begin + data->calculate_block_offset(absolute_index) : nullptr;
+    }
+
+    template <typename T>
+    void deque_iterator<T>::set_block(block_type* block_slot)
+    {
+        block = block_slot;
+        block_begin = *block;
+        block_end = block_begin != nullptr ? block_begin + block_size : nullptr;
     }
 }
 
@@ -0,0 +1,183 @@
+#ifndef TOY_SDL_DEQUE_SEGMENTS_HPP
+#define TOY_SDL_DEQUE_SEGMENTS_HPP
+
+#include "deque_iterator.hpp"
+#include "const_iterator.hpp"
+#include "algorithm.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+namespace my
+{
+    // View over contiguous parts of a range of deque elements
+    // Every segment is std::span over a part of one block, segments go in the order of elements
+    template <typename Deq, bool IsConst>
+    class deque_segments
+    {
+    private:
+        using deque_data_type = typename Deq::deque_data_type;
+        using size_type = typename Deq::size_type;
+        using element_type = std::conditional_t<IsConst, const typename Deq::value_type, typename Deq::value_type>;
+
+        constexpr static size_type block_size = Deq::block_size;
+
+    public:
+        using segment_type = std::span<element_type>;
+
+        class iterator
+        {
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = segment_type;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const deque_data_type* data, size_type index, size_type last);
+
+            bool operator==(const iterator& other) const;
+            bool operator==(std::default_sentinel_t) const;
+
+            iterator& operator++();
+            iterator operator++(int);
+
+            segment_type operator*() const;
+
+        private:
+            // Number of elements from index to the end of its block or to last, whichever comes first
+            size_type segment_size() const;
+
+            const deque_data_type* data { nullptr };
+            // Indices relative to begin_index like in deque_iterator
+            size_type index { 0 };
+            size_type last { 0 };
+        };
+
+        deque_segments(const deque_data_type* data, size_type first, size_type last);
+        deque_segments(deque_iterator<Deq> first, deque_iterator<Deq> last);
+
+        iterator begin() const;
+        std::default_sentinel_t end() const;
+
+        bool empty() const;
+
+    private:
+        const deque_data_type* data;
+        size_type first;
+        size_type last;
+    };
+
+    template <typename Deq>
+    struct segmented_iterator_traits<deque_iterator<Deq>>
+    {
+        constexpr static bool is_segmented = true;
+
+        static deque_segments<Deq, false> segments(deque_iterator<Deq> first, deque_iterator<Deq> last)
+        {
+            return { first, last };
+        }
+    };
+
+    template <typename Deq>
+    struct segmented_iterator_traits<basic_const_iterator<deque_iterator<Deq>>>
+    {
+        constexpr static bool is_segmented = true;
+
+        static deque_segments<Deq, true> segments(basic_const_iterator<deque_iterator<Deq>> first, basic_const_iterator<deque_iterator<Deq>> last)
+        {
+            return { first.base(), last.base() };
+        }
+    };
+
+    // deque_segments::iterator
+    template <typename Deq, bool IsConst>
+    deque_segments<Deq, IsConst>::iterator::iterator(const deque_data_type* data, size_type index, size_type last) :
+        data(data),
+        index(index),
+        last(last)
+    {
+
+    }
+
+    template <typename Deq, bool IsConst>
+    bool deque_segments<Deq, IsConst>::iterator::operator==(const iterator& other) const
+    {
+        return index == other.index;
+    }
+
+    template <typename Deq, bool IsConst>
+    bool deque_segments<Deq, IsConst>::iterator::operator==(std::default_sentinel_t) const
+    {
+        return index == last;
+    }
+
+    template <typename Deq, bool IsConst>
+    deque_segments<Deq, IsConst>::iterator& deque_segments<Deq, IsConst>::iterator::operator++()
+    {
+        index += segment_size();
+        return *this;
+    }
+
+    template <typename Deq, bool IsConst>
+    deque_segments<Deq, IsConst>::iterator deque_segments<Deq, IsConst>::iterator::operator++(int)
+    {
+        const auto copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+    template <typename Deq, bool IsConst>
+    deque_segments<Deq, IsConst>::segment_type deque_segments<Deq, IsConst>::iterator::operator*() const
+    {
+        const auto absolute_index = data->wrap_index(data->begin_index + index);
+        const auto block = data->blocks[data->calculate_block_index(absolute_index)];
+        return segment_type(block + data->calculate_block_offset(absolute_index), segment_size());
+    }
+
+    template <typename Deq, bool IsConst>
+    deque_segments<Deq, IsConst>::size_type deque_segments<Deq, IsConst>::iterator::segment_size() const
+    {
+        const auto absolute_index = data->wrap_index(data->begin_index + index);
+        return std::min(block_size - data->calculate_block_offset(absolute_index), last - index);
+    }
+
+    // deque_segments
+    template <typename Deq, bool IsConst>
+    deque_segments<Deq, IsConst>::deque_segments(const deque_data_type* data, size_type first, size_type last) :
+        data(data),
+        first(first),
+        last(last)
+    {
+        assert((first <= last) && "Invalid range");
+    }
+
+    template <typename Deq, bool IsConst>
+    deque_segments<Deq, IsConst>::deque_segments(deque_iterator<Deq> first, deque_iterator<Deq> last) :
+        deque_segments(first.data, first.index, last.index)
+    {
+        assert((first.data == last.data) && "Iterators point to different containers");
+    }
+
+    template <typename Deq, bool IsConst>
+    deque_segments<Deq, IsConst>::iterator deque_segments<Deq, IsConst>::begin() const
+    {
+        return iterator(data, first, last);
+    }
+
+    template <typename Deq, bool IsConst>
+    std::default_sentinel_t deque_segments<Deq, IsConst>::end() const
+    {
+        return std::default_sentinel;
+    }
+
+    template <typename Deq, bool IsConst>
+    bool deque_segments<Deq, IsConst>::empty() const
+    {
+        return first == last;
+    }
+}
+
+#endif /* TOY_SDL_DEQUE_SEGMENTS_HPP */
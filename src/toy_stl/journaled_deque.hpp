@@ -0,0 +1,570 @@
+#ifndef TOY_SDL_JOURNALED_DEQUE_HPP
+#define TOY_SDL_JOURNALED_DEQUE_HPP
+
+#include "deque.hpp"
+#include "deque_block_size_policy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace my
+{
+    struct deque_journal_options
+    {
+        // Buffered operations are written and synced when there are this many of them
+        std::size_t commit_operations { 4096 };
+        // Or when the oldest of them waits this long, checked on every operation
+        std::chrono::microseconds commit_interval { 1000 };
+        // New segment file is started when the current one would grow past this size
+        std::size_t segment_bytes { 64 * 1024 * 1024 };
+        // Without fdatasync commits survive crash of the process, but not of the machine
+        bool sync { true };
+    };
+
+    // Work queue of trivially copyable records that survives crashes
+    // Operations are applied to in-memory deque at once and buffered, commit writes them to the journal as one frame
+    // with one fdatasync, so many enqueues share the cost of one sync (group commit)
+    // Frame holds records pushed to the back and total number of elements popped from the front so far,
+    // so any number of pops is written as one counter instead of a tombstone per record
+    // Journal is a sequence of segment files, segment is removed when every record in it is popped
+    // Only push_back and pop_front are journaled, this is what a work queue needs
+    // Failed automatic commit is not thrown by push_back or pop_front that triggered it, because the operation is already
+    // applied and retrying the call would apply it twice. The error is kept instead: the next push_back or pop_front
+    // rethrows it before changing anything, and operations stay pending until an explicit commit succeeds
+    template <typename T, typename Allocator = std::allocator<T>, block_size_policy BlockSizePolicy = default_block_size>
+    class journaled_deque
+    {
+        // Records are written to files byte by byte
+        static_assert(std::is_trivially_copyable_v<T>, "Elements of journaled deque must be trivially copyable");
+
+    public:
+        using deque_type = deque<T, Allocator, BlockSizePolicy>;
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using const_reference = const value_type&;
+
+        // Rebuilds deque from segment files in directory, directory is created if it does not exist
+        // Incomplete frame at the end of the last segment is a commit interrupted by crash, it is discarded
+        explicit journaled_deque(std::filesystem::path directory, deque_journal_options options = { }, const Allocator& allocator = Allocator());
+
+        journaled_deque(const journaled_deque&) = delete;
+        journaled_deque& operator=(const journaled_deque&) = delete;
+
+        // Commits buffered operations unless a commit already failed, errors are ignored here, call commit to see them
+        ~journaled_deque();
+
+        // Element access
+        const_reference front() const;
+        const_reference back() const;
+        // Contents including operations that are not committed yet
+        const deque_type& items() const noexcept;
+
+        // Capacity
+        [[nodiscard]] bool empty() const noexcept;
+        size_type size() const noexcept;
+        // Operations that are applied, but would be lost on crash
+        size_type pending_operations() const noexcept;
+
+        // Modifiers
+        void push_back(const T& value);
+        void pop_front();
+        // Writes buffered operations and waits until they reach the disk
+        // This is the only way to retry after a failed commit
+        void commit();
+
+    private:
+        // All numbers in files are in native byte order, journal is not meant to be moved between machines
+        struct segment_header
+        {
+            std::uint64_t magic;
+            std::uint64_t record_size;
+            // Sequence number of the first record pushed in this segment, records are numbered from 0 in push order
+            std::uint64_t first_sequence;
+        };
+
+        struct frame_header
+        {
+            // Covers the rest of the header and records
+            std::uint64_t checksum;
+            // Number of records popped since the journal was created, after this frame
+            std::uint64_t popped_total;
+            std::uint64_t records_count;
+        };
+
+        struct segment
+        {
+            std::filesystem::path path;
+            std::uint64_t first_sequence;
+        };
+
+        constexpr static std::uint64_t journal_magic = 0x314C4E524A594F54; // "TOYJRNL1"
+
+        static std::uint64_t checksum(const std::byte* first, std::size_t count, std::uint64_t hash = 0xcbf29ce484222325);
+        static std::filesystem::path segment_path(const std::filesystem::path& directory, std::uint64_t first_sequence);
+        static void write_all(int fd, const std::byte* first, std::size_t count);
+
+        void recover();
+        // Applies frames of one segment and returns size of its valid part
+        std::size_t replay_segment(const std::vector<std::byte>& bytes, const segment& s, bool is_last);
+        void open_segment(std::uint64_t first_sequence);
+        void open_existing_segment(const segment& s, std::size_t valid_bytes);
+        void sync_directory() const;
+        void remove_popped_segments();
+        // Errors are kept in commit_error instead of being thrown
+        void commit_if_needed() noexcept;
+        void throw_if_commit_failed() const;
+        // Starts new frame at the beginning of write buffer
+        void reset_write_buffer();
+
+        deque_type records;
+
+        std::filesystem::path directory;
+        deque_journal_options options;
+
+        // Oldest first, the last one is open for appending
+        std::vector<segment> segments;
+        int segment_fd { -1 };
+        std::size_t segment_size { 0 };
+
+        // Next record gets this sequence number, front of deque has sequence pushed_total - size()
+        std::uint64_t pushed_total { 0 };
+        std::uint64_t popped_total { 0 };
+
+        // Frame that is being built, header is filled in by commit
+        std::vector<std::byte> write_buffer;
+        std::size_t pending_records { 0 };
+        std::size_t pending_pops { 0 };
+        std::chrono::steady_clock::time_point oldest_pending;
+        // Error of automatic commit, cleared when explicit commit succeeds
+        std::exception_ptr commit_error;
+    };
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    journaled_deque<T, Allocator, BlockSizePolicy>::journaled_deque(std::filesystem::path directory, deque_journal_options options, const Allocator& allocator) :
+        records(allocator),
+        directory(std::move(directory)),
+        options(options)
+    {
+        std::filesystem::create_directories(this->directory);
+        reset_write_buffer();
+        recover();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    journaled_deque<T, Allocator, BlockSizePolicy>::~journaled_deque()
+    {
+        try {
+            if (!commit_error) {
+                commit();
+            }
+        } catch (...) {
+            // Operations are lost like on crash, journal itself stays consistent
+        }
+
+        if (segment_fd != -1) {
+            ::close(segment_fd);
+        }
+    }
+
+    // Element access
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    journaled_deque<T, Allocator, BlockSizePolicy>::const_reference journaled_deque<T, Allocator, BlockSizePolicy>::front() const
+    {
+        return records.front();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    journaled_deque<T, Allocator, BlockSizePolicy>::const_reference journaled_deque<T, Allocator, BlockSizePolicy>::back() const
+    {
+        return records.back();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    const journaled_deque<T, Allocator, BlockSizePolicy>::deque_type& journaled_deque<T, Allocator, BlockSizePolicy>::items() const noexcept
+    {
+        return records;
+    }
+
+    // Capacity
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool journaled_deque<T, Allocator, BlockSizePolicy>::empty() const noexcept
+    {
+        return records.empty();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    journaled_deque<T, Allocator, BlockSizePolicy>::size_type journaled_deque<T, Allocator, BlockSizePolicy>::size() const noexcept
+    {
+        return records.size();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    journaled_deque<T, Allocator, BlockSizePolicy>::size_type journaled_deque<T, Allocator, BlockSizePolicy>::pending_operations() const noexcept
+    {
+        return pending_records + pending_pops;
+    }
+
+    // Modifiers
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::push_back(const T& value)
+    {
+        throw_if_commit_failed();
+
+        // Buffer is grown first, so that failure leaves both deque and buffer as they were
+        const auto offset = write_buffer.size();
+        const auto bytes = reinterpret_cast<const std::byte*>(std::addressof(value));
+        write_buffer.insert(write_buffer.end(), bytes, bytes + sizeof(T));
+
+        try {
+            records.push_back(value);
+        } catch (...) {
+            write_buffer.resize(offset);
+            throw;
+        }
+
+        ++pushed_total;
+        ++pending_records;
+        commit_if_needed();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::pop_front()
+    {
+        assert((!empty()) && "Deque is empty");
+        throw_if_commit_failed();
+
+        records.pop_front();
+        ++popped_total;
+        ++pending_pops;
+        commit_if_needed();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::commit()
+    {
+        if (pending_operations() == 0) {
+            return;
+        }
+
+        // Frame never spans two segments, so segment can be removed as a whole
+        // Segments are named by their first record, so frame without new records stays in the current one
+        const auto frame_size = write_buffer.size();
+        const auto first_sequence = pushed_total - pending_records;
+        if (segment_size > sizeof(segment_header) && segment_size + frame_size > options.segment_bytes && first_sequence > segments.back().first_sequence) {
+            open_segment(first_sequence);
+        }
+
+        frame_header header {
+            .checksum = 0,
+            .popped_total = popped_total,
+            .records_count = pending_records
+        };
+        std::memcpy(write_buffer.data(), &header, sizeof(header));
+        header.checksum = checksum(write_buffer.data() + sizeof(header.checksum), frame_size - sizeof(header.checksum));
+        std::memcpy(write_buffer.data(), &header.checksum, sizeof(header.checksum));
+
+        try {
+            write_all(segment_fd, write_buffer.data(), frame_size);
+            if (options.sync && ::fdatasync(segment_fd) == -1) {
+                throw std::system_error(errno, std::generic_category(), "Failed to sync journal segment");
+            }
+        } catch (...) {
+            // Part of the frame may be in the file, it is cut off and file offset is moved back,
+            // so that next frame starts right after the last complete one instead of after a hole
+            [[maybe_unused]] const auto truncated = ::ftruncate(segment_fd, static_cast<off_t>(segment_size));
+            [[maybe_unused]] const auto offset = ::lseek(segment_fd, static_cast<off_t>(segment_size), SEEK_SET);
+            throw;
+        }
+
+        segment_size += frame_size;
+        commit_error = nullptr;
+        reset_write_buffer();
+        remove_popped_segments();
+    }
+
+    // Implementation details
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    std::uint64_t journaled_deque<T, Allocator, BlockSizePolicy>::checksum(const std::byte* first, std::size_t count, std::uint64_t hash)
+    {
+        // FNV-1a, only has to detect frames torn by crash
+        for (std::size_t i = 0; i < count; ++i) {
+            hash ^= static_cast<std::uint64_t>(first[i]);
+            hash *= 0x100000001b3;
+        }
+
+        return hash;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    std::filesystem::path journaled_deque<T, Allocator, BlockSizePolicy>::segment_path(const std::filesystem::path& directory, std::uint64_t first_sequence)
+    {
+        // Fixed width, so that names sort in order of sequence numbers
+        char name[32];
+        std::snprintf(name, sizeof(name), "journal_%016llx.log", static_cast<unsigned long long>(first_sequence));
+        return directory / name;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::write_all(int fd, const std::byte* first, std::size_t count)
+    {
+        while (count > 0) {
+            const auto written = ::write(fd, first, count);
+            if (written == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "Failed to write journal segment");
+            }
+
+            first += written;
+            count -= static_cast<std::size_t>(written);
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::recover()
+    {
+        std::vector<std::filesystem::path> paths;
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            const auto name = entry.path().filename().string();
+            if (entry.is_regular_file() && name.starts_with("journal_") && name.ends_with(".log")) {
+                paths.push_back(entry.path());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+
+        std::size_t last_valid_bytes = 0;
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            std::vector<std::byte> bytes(std::filesystem::file_size(paths[i]));
+            std::ifstream file(paths[i], std::ios::binary);
+            file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!file) {
+                throw std::runtime_error("Failed to read journal segment " + paths[i].string());
+            }
+
+            segment_header header;
+            if (bytes.size() < sizeof(header)) {
+                // Crash right after the segment was created
+                if (i + 1 == paths.size()) {
+                    std::filesystem::remove(paths[i]);
+                    break;
+                }
+                throw std::runtime_error("Journal segment is corrupted " + paths[i].string());
+            }
+            std::memcpy(&header, bytes.data(), sizeof(header));
+
+            if (header.magic != journal_magic || header.record_size != sizeof(T)) {
+                throw std::runtime_error("Journal segment has different format " + paths[i].string());
+            }
+            if (!segments.empty() && header.first_sequence != pushed_total) {
+                throw std::runtime_error("Journal segments are not contiguous " + paths[i].string());
+            }
+            if (segments.empty()) {
+                pushed_total = header.first_sequence;
+                popped_total = header.first_sequence;
+            }
+
+            segments.push_back(segment { paths[i], header.first_sequence });
+            last_valid_bytes = replay_segment(bytes, segments.back(), i + 1 == paths.size());
+        }
+
+        if (segments.empty()) {
+            open_segment(0);
+        } else {
+            open_existing_segment(segments.back(), last_valid_bytes);
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    std::size_t journaled_deque<T, Allocator, BlockSizePolicy>::replay_segment(const std::vector<std::byte>& bytes, const segment& s, bool is_last)
+    {
+        std::size_t offset = sizeof(segment_header);
+
+        while (offset < bytes.size()) {
+            frame_header header;
+            bool is_valid = bytes.size() - offset >= sizeof(header);
+            if (is_valid) {
+                std::memcpy(&header, bytes.data() + offset, sizeof(header));
+                const auto records_bytes = header.records_count * sizeof(T);
+                is_valid = records_bytes / sizeof(T) == header.records_count &&
+                    bytes.size() - offset - sizeof(header) >= records_bytes &&
+                    header.checksum == checksum(bytes.data() + offset + sizeof(header.checksum), sizeof(header) - sizeof(header.checksum) + records_bytes);
+            }
+
+            if (!is_valid) {
+                // Only the last commit can be interrupted, older segments were synced before the next one was started
+                if (!is_last) {
+                    throw std::runtime_error("Journal segment is corrupted " + s.path.string());
+                }
+                break;
+            }
+
+            const auto* record = bytes.data() + offset + sizeof(header);
+            records.emplace_back_n(header.records_count, [&record] {
+                std::array<std::byte, sizeof(T)> raw;
+                std::memcpy(raw.data(), record, sizeof(T));
+                record += sizeof(T);
+                return std::bit_cast<T>(raw);
+            });
+            pushed_total += header.records_count;
+
+            // Early frames of the first segment can refer to records of removed segments, those are already popped
+            while (popped_total < header.popped_total && !records.empty()) {
+                records.pop_front();
+                ++popped_total;
+            }
+            popped_total = std::max(popped_total, header.popped_total);
+
+            offset += sizeof(header) + header.records_count * sizeof(T);
+        }
+
+        return offset;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::open_segment(std::uint64_t first_sequence)
+    {
+        // Previous segment is complete, every frame in it was synced by commit
+        const auto path = segment_path(directory, first_sequence);
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd == -1) {
+            throw std::system_error(errno, std::generic_category(), "Failed to create journal segment " + path.string());
+        }
+
+        const segment_header header {
+            .magic = journal_magic,
+            .record_size = sizeof(T),
+            .first_sequence = first_sequence
+        };
+
+        try {
+            write_all(fd, reinterpret_cast<const std::byte*>(&header), sizeof(header));
+            if (options.sync && ::fdatasync(fd) == -1) {
+                throw std::system_error(errno, std::generic_category(), "Failed to sync journal segment");
+            }
+            segments.push_back(segment { path, first_sequence });
+        } catch (...) {
+            ::close(fd);
+            std::filesystem::remove(path);
+            throw;
+        }
+
+        // File must be found by recovery, so directory entry is synced too
+        sync_directory();
+
+        if (segment_fd != -1) {
+            ::close(segment_fd);
+        }
+        segment_fd = fd;
+        segment_size = sizeof(header);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::open_existing_segment(const segment& s, std::size_t valid_bytes)
+    {
+        const int fd = ::open(s.path.c_str(), O_WRONLY | O_CLOEXEC);
+        if (fd == -1) {
+            throw std::system_error(errno, std::generic_category(), "Failed to open journal segment " + s.path.string());
+        }
+
+        // Torn frame is cut off, new frames are written after the last complete one
+        if (::ftruncate(fd, static_cast<off_t>(valid_bytes)) == -1 || ::lseek(fd, static_cast<off_t>(valid_bytes), SEEK_SET) == -1) {
+            const auto error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Failed to truncate journal segment " + s.path.string());
+        }
+
+        segment_fd = fd;
+        segment_size = valid_bytes;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::sync_directory() const
+    {
+        if (!options.sync) {
+            return;
+        }
+
+        const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd == -1) {
+            throw std::system_error(errno, std::generic_category(), "Failed to open journal directory " + directory.string());
+        }
+
+        const auto result = ::fsync(fd);
+        const auto error = errno;
+        ::close(fd);
+        if (result == -1) {
+            throw std::system_error(error, std::generic_category(), "Failed to sync journal directory " + directory.string());
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::remove_popped_segments()
+    {
+        // Called after commit, so popped_total is durable and records of removed segments are never needed again
+        // The last segment is kept even if it is empty, because new frames go there
+        while (segments.size() > 1 && segments[1].first_sequence <= popped_total) {
+            std::error_code error;
+            std::filesystem::remove(segments.front().path, error);
+            segments.erase(segments.begin());
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::commit_if_needed() noexcept
+    {
+        if (pending_operations() == 1) {
+            oldest_pending = std::chrono::steady_clock::now();
+        }
+
+        if (pending_operations() >= options.commit_operations || std::chrono::steady_clock::now() - oldest_pending >= options.commit_interval) {
+            try {
+                commit();
+            } catch (...) {
+                // Operation that triggered commit is already applied, so the error is thrown by the next one
+                commit_error = std::current_exception();
+            }
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::throw_if_commit_failed() const
+    {
+        // Operations are not applied while the journal does not persist them
+        if (commit_error) {
+            std::rethrow_exception(commit_error);
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void journaled_deque<T, Allocator, BlockSizePolicy>::reset_write_buffer()
+    {
+        write_buffer.resize(sizeof(frame_header));
+        pending_records = 0;
+        pending_pops = 0;
+    }
+}
+
+#endif /* TOY_SDL_JOURNALED_DEQUE_HPP */
@@ -0,0 +1,17 @@
+#ifndef TOY_SDL_RANGES_HPP
+#define TOY_SDL_RANGES_HPP
+
+#include <ranges>
+#include <concepts>
+
+namespace my
+{
+    // Same as exposition-only container-compatible-range from C++23
+    // Range whose elements can be used to construct elements of type T
+    template <typename R, typename T>
+    concept container_compatible_range =
+        std::ranges::input_range<R> &&
+        std::convertible_to<std::ranges::range_reference_t<R>, T>;
+}
+
+#endif /* TOY_SDL_RANGES_HPP */
@@ -0,0 +1,375 @@
+#ifndef TOY_SDL_SMALL_VECTOR_HPP
+#define TOY_SDL_SMALL_VECTOR_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <iterator>
+#include <utility>
+
+namespace my
+{
+    // Allocator that holds memory for N elements inside itself
+    // First request for at most N elements gets inline memory, everything else is forwarded to A
+    // Inline memory moves together with the allocator, so container that uses it must not steal pointers from other containers
+    template <typename T, std::size_t N, typename A = std::allocator<T>>
+    class small_vector_allocator
+    {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+        small_vector_allocator() = default;
+        explicit small_vector_allocator(const A& base) : base_{base} { }
+
+        // Copy gets its own inline memory, only base allocator is copied
+        small_vector_allocator(const small_vector_allocator& other) : base_{other.base_} { }
+        small_vector_allocator& operator= (const small_vector_allocator& other)
+        {
+            base_ = other.base_;
+            return *this;
+        }
+
+        T* allocate(size_type n)
+        {
+            if (n <= N && !is_inline_memory_used_) {
+                is_inline_memory_used_ = true;
+                return inline_data();
+            }
+
+            return std::allocator_traits<A>::allocate(base_, n);
+        }
+
+        void deallocate(T* p, size_type n)
+        {
+            if (p == inline_data()) {
+                is_inline_memory_used_ = false;
+            } else {
+                std::allocator_traits<A>::deallocate(base_, p, n);
+            }
+        }
+
+        // Forwarded only if base allocator has them, otherwise vector could not use memcpy for relocation
+        template <typename ... Args>
+            requires requires (A& base, T* p, Args&& ... args) { base.construct(p, std::forward<Args>(args) ...); }
+        void construct(T* p, Args&& ... args)
+        {
+            base_.construct(p, std::forward<Args>(args) ...);
+        }
+
+        void destroy(T* p)
+            requires requires (A& base, T* p) { base.destroy(p); }
+        {
+            base_.destroy(p);
+        }
+
+        T* inline_data() noexcept
+        {
+            return reinterpret_cast<T*>(storage_);
+        }
+
+        const T* inline_data() const noexcept
+        {
+            return reinterpret_cast<const T*>(storage_);
+        }
+
+        const A& base() const noexcept
+        {
+            return base_;
+        }
+
+        // Inline memory of one allocator can't be released by another one
+        bool operator== (const small_vector_allocator& other) const noexcept
+        {
+            return this == &other;
+        }
+
+    private:
+        [[no_unique_address]] A base_ { };
+        bool is_inline_memory_used_ { false };
+        alignas(T) std::byte storage_[N * sizeof(T)];
+    };
+
+    // Vector that keeps up to N elements inside the object and uses heap only when they don't fit
+    // All modifiers come from vector, only operations that move memory between objects are different
+    template <typename T, std::size_t N, typename A = std::allocator<T>>
+    class small_vector : private vector<T, small_vector_allocator<T, N, A>>
+    {
+        static_assert(N > 0, "small_vector must have inline capacity");
+
+        using base_type = vector<T, small_vector_allocator<T, N, A>>;
+
+    public:
+        // Member types
+        using typename base_type::value_type;
+        using typename base_type::reference;
+        using typename base_type::const_reference;
+        using typename base_type::pointer;
+        using typename base_type::const_pointer;
+        using typename base_type::size_type;
+        using typename base_type::difference_type;
+        using typename base_type::iterator;
+        using typename base_type::const_iterator;
+        using typename base_type::reverse_iterator;
+        using typename base_type::const_reverse_iterator;
+        using allocator_type = A;
+
+        constexpr static size_type inline_capacity = N;
+
+        // Constructors
+        small_vector();
+        explicit small_vector(const A& allocator);
+        explicit small_vector(size_type size, const A& allocator = A());
+        small_vector(size_type size, const T& value, const A& allocator = A());
+        template <std::input_iterator I>
+        small_vector(I first, I last, const A& allocator = A());
+        small_vector(std::initializer_list<T> init_list, const A& allocator = A());
+
+        // Rule of 5
+        small_vector(const small_vector& other);
+        small_vector& operator= (const small_vector& other);
+        small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+        small_vector& operator= (small_vector&& other);
+        ~small_vector() = default;
+
+        // Other
+        small_vector& operator= (std::initializer_list<T> init_list);
+        using base_type::assign;
+        using base_type::assign_range;
+        void swap(small_vector& other);
+        allocator_type get_allocator() const;
+
+        // Propery access
+        using base_type::empty;
+        using base_type::size;
+        using base_type::max_size;
+        using base_type::capacity;
+        using base_type::data;
+        bool is_inline() const noexcept;
+
+        // Comparison
+        bool operator== (const small_vector& other) const;
+        auto operator<=> (const small_vector& other) const;
+
+        // Element access
+        using base_type::operator[];
+        using base_type::at;
+        using base_type::front;
+        using base_type::back;
+
+        // Adding/removing elements
+        using base_type::push_back;
+        using base_type::pop_back;
+        using base_type::emplace_back;
+        using base_type::insert;
+        using base_type::insert_range;
+        using base_type::append_range;
+        using base_type::erase;
+        using base_type::emplace;
+
+        // Size/capacity modification
+        using base_type::clear;
+        using base_type::resize;
+        using base_type::resize_for_overwrite;
+        using base_type::reserve;
+        void shrink_to_fit();
+
+        // Iterators
+        using base_type::begin;
+        using base_type::end;
+        using base_type::cbegin;
+        using base_type::cend;
+        using base_type::rbegin;
+        using base_type::rend;
+        using base_type::crbegin;
+        using base_type::crend;
+
+    private:
+        // Takes heap memory of other vector, other is left empty with its inline memory
+        void steal_heap_memory(small_vector& other) noexcept;
+        // Points vector to its inline memory, vector must be empty and not own any memory
+        void use_inline_memory() noexcept;
+    };
+
+    // Constructors
+    // Each constructor starts with inline memory, so first N elements never cause allocation
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>::small_vector() : small_vector(A())
+    {
+
+    }
+
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>::small_vector(const A& allocator) : base_type(small_vector_allocator<T, N, A>(allocator))
+    {
+        use_inline_memory();
+    }
+
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>::small_vector(size_type size, const A& allocator) : small_vector(allocator)
+    {
+        resize(size);
+    }
+
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>::small_vector(size_type size, const T& value, const A& allocator) : small_vector(allocator)
+    {
+        resize(size, value);
+    }
+
+    template <typename T, std::size_t N, typename A>
+    template <std::input_iterator I>
+    small_vector<T, N, A>::small_vector(I first, I last, const A& allocator) : small_vector(allocator)
+    {
+        assign(first, last);
+    }
+
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>::small_vector(std::initializer_list<T> init_list, const A& allocator) : small_vector(allocator)
+    {
+        assign(init_list);
+    }
+
+    // Rule of 5
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>::small_vector(const small_vector& other) :
+        small_vector(std::allocator_traits<A>::select_on_container_copy_construction(other.get_allocator()))
+    {
+        assign(other.begin(), other.end());
+    }
+
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>& small_vector<T, N, A>::operator= (const small_vector& other)
+    {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+
+        return *this;
+    }
+
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>::small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) :
+        small_vector(other.get_allocator())
+    {
+        if (other.is_inline()) {
+            // Inline elements can't change owner, so they are moved one by one
+            assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        } else {
+            steal_heap_memory(other);
+        }
+    }
+
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>& small_vector<T, N, A>::operator= (small_vector&& other)
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        if (!other.is_inline() && get_allocator() == other.get_allocator()) {
+            steal_heap_memory(other);
+        } else {
+            assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    // Other
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>& small_vector<T, N, A>::operator= (std::initializer_list<T> init_list)
+    {
+        assign(init_list);
+        return *this;
+    }
+
+    template <typename T, std::size_t N, typename A>
+    void small_vector<T, N, A>::swap(small_vector& other)
+    {
+        if (!is_inline() && !other.is_inline()) {
+            // Both use heap memory, so only pointers change places
+            using std::swap;
+            swap(this->size_, other.size_);
+            swap(this->capacity_, other.capacity_);
+            swap(this->data_, other.data_);
+        } else {
+            small_vector temporary(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temporary);
+        }
+    }
+
+    template <typename T, std::size_t N, typename A>
+    small_vector<T, N, A>::allocator_type small_vector<T, N, A>::get_allocator() const
+    {
+        return this->allocator_.base();
+    }
+
+    // Propery access
+    template <typename T, std::size_t N, typename A>
+    bool small_vector<T, N, A>::is_inline() const noexcept
+    {
+        return this->data_ == this->allocator_.inline_data();
+    }
+
+    // Comparison
+    template <typename T, std::size_t N, typename A>
+    bool small_vector<T, N, A>::operator== (const small_vector& other) const
+    {
+        return static_cast<const base_type&>(*this) == static_cast<const base_type&>(other);
+    }
+
+    template <typename T, std::size_t N, typename A>
+    auto small_vector<T, N, A>::operator<=> (const small_vector& other) const
+    {
+        return static_cast<const base_type&>(*this) <=> static_cast<const base_type&>(other);
+    }
+
+    // Size/capacity modification
+    template <typename T, std::size_t N, typename A>
+    void small_vector<T, N, A>::shrink_to_fit()
+    {
+        if (is_inline()) {
+            return;
+        }
+
+        if (size() <= N) {
+            // Inline memory is free while elements are on the heap, so they move back there
+            this->reallocate(N);
+        } else {
+            base_type::shrink_to_fit();
+        }
+    }
+
+    // Private member functions
+    template <typename T, std::size_t N, typename A>
+    void small_vector<T, N, A>::steal_heap_memory(small_vector& other) noexcept
+    {
+        // Release whatever memory this vector had
+        this->destroy_range(this->data_, this->data_ + this->size_);
+        this->allocator_.deallocate(this->data_, this->capacity_);
+
+        this->size_ = other.size_;
+        this->capacity_ = other.capacity_;
+        this->data_ = other.data_;
+
+        other.size_ = 0;
+        other.capacity_ = 0;
+        other.data_ = nullptr;
+        other.use_inline_memory();
+    }
+
+    template <typename T, std::size_t N, typename A>
+    void small_vector<T, N, A>::use_inline_memory() noexcept
+    {
+        // Inline memory is always free at this point, so this does not allocate
+        this->data_ = this->allocator_.allocate(N);
+        this->capacity_ = N;
+    }
+}
+
+#endif /* TOY_SDL_SMALL_VECTOR_HPP */
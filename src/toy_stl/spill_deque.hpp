@@ -0,0 +1,646 @@
+#ifndef TOY_SDL_SPILL_DEQUE_HPP
+#define TOY_SDL_SPILL_DEQUE_HPP
+
+#include "deque_data.hpp"
+#include "deque_block_size_policy.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace my
+{
+    // Deque for queues that do not fit into memory, POSIX only
+    // Elements are stored in the same circular array of blocks as in deque, but a block pointer can point either
+    // to a block allocated in RAM or to a slot of a memory-mapped segment file
+    // First and last hot_blocks used blocks are kept in RAM, blocks between them are copied to segment files,
+    // so the kernel can write cold pages to disk and drop them instead of running out of memory
+    // When a spilled block gets close to one of the ends again, it is copied back to RAM
+    // Segment files are unlinked right after creation, so they disappear with the last mapping even after a crash
+    // Segment is unmapped when none of its slots holds a block, so disk space is returned after a backlog drains
+    template <typename T, typename Allocator = std::allocator<T>, block_size_policy BlockSizePolicy = default_block_size>
+    class spill_deque
+    {
+        // Blocks are moved between RAM and files with memcpy
+        static_assert(std::is_trivially_copyable_v<T>, "Elements of spill deque must be trivially copyable");
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        // Segment files are created in directory, every file holds segment_blocks blocks
+        explicit spill_deque(std::filesystem::path directory, size_type hot_blocks = 4, size_type segment_blocks = 256, const Allocator& allocator = Allocator());
+
+        spill_deque(const spill_deque&) = delete;
+        spill_deque& operator=(const spill_deque&) = delete;
+
+        ~spill_deque();
+
+        // Element access
+        reference operator[](size_type pos);
+        const_reference operator[](size_type pos) const;
+        reference at(size_type pos);
+        const_reference at(size_type pos) const;
+
+        reference front();
+        const_reference front() const;
+        reference back();
+        const_reference back() const;
+
+        // Capacity
+        [[nodiscard]] bool empty() const noexcept;
+        size_type size() const noexcept;
+        // Blocks with elements that are currently in RAM and in segment files
+        size_type ram_blocks_count() const noexcept;
+        size_type spilled_blocks_count() const noexcept;
+        size_type segments_count() const noexcept;
+
+        // Modifiers
+        // Releases every segment file, including the spare one
+        void clear() noexcept;
+
+        void push_back(const T& value);
+        void push_front(const T& value);
+        void pop_back();
+        void pop_front();
+
+    private:
+        using deque_data_type = deque_data<value_type, size_type, BlockSizePolicy>;
+        using block_type = typename deque_data_type::block_type;
+        using block_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<block_type>;
+
+        constexpr static size_type block_size = deque_data_type::block_size;
+        constexpr static size_type block_bytes = block_size * sizeof(value_type);
+
+        struct segment
+        {
+            std::byte* base;
+            size_type bytes;
+            // Slots that hold blocks
+            size_type used_slots;
+        };
+
+        T* element_at(size_type pos) const;
+
+        bool adding_back_element_needs_growth() const;
+        bool adding_front_element_needs_growth() const;
+        // Moves block pointers to array of double size, so that begin block becomes the first one
+        void grow_blocks_array();
+
+        // Number of blocks between begin block and the block of the last element
+        size_type used_blocks_count() const;
+        // Block at position relative_block counting from begin block
+        block_type& block_at(size_type relative_block) const;
+        bool should_be_in_ram(size_type relative_block, size_type used_blocks) const;
+        // Moves block between RAM and segment file if its position says so
+        void place_block(block_type& block, size_type relative_block, size_type used_blocks);
+        // Same, but failure to allocate RAM only leaves block in file, because it is still accessible there
+        void try_place_block(block_type& block, size_type relative_block, size_type used_blocks) noexcept;
+
+        // Index of segment that holds the block, or segments count if block is in RAM
+        size_type find_segment(block_type block) const;
+        bool is_spilled(block_type block) const;
+        block_type allocate_ram_block();
+        void release_block(block_type& block) noexcept;
+        void spill_block(block_type& block);
+        void unspill_block(block_type& block);
+
+        block_type acquire_slot();
+        void return_slot(block_type slot) noexcept;
+        void map_segment();
+        void unmap_segment(size_type index) noexcept;
+        void unmap_all_segments() noexcept;
+
+        [[no_unique_address]] Allocator element_allocator;
+        [[no_unique_address]] block_allocator_type block_allocator;
+        deque_data_type data;
+
+        std::filesystem::path directory;
+        size_type hot_blocks;
+        size_type segment_blocks;
+
+        // Sorted by base, so that owner of a block pointer is found with binary search
+        std::vector<segment> segments;
+        std::vector<block_type> free_slots;
+
+        size_type ram_blocks { 0 };
+        size_type spilled_blocks { 0 };
+    };
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::spill_deque(std::filesystem::path directory, size_type hot_blocks, size_type segment_blocks, const Allocator& allocator) :
+        element_allocator(allocator),
+        block_allocator(allocator),
+        directory(std::move(directory)),
+        hot_blocks(hot_blocks),
+        segment_blocks(segment_blocks)
+    {
+        assert((hot_blocks > 0) && "At least one block at each end must be in RAM");
+        assert((segment_blocks > 0) && "Segment must hold at least one block");
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::~spill_deque()
+    {
+        clear();
+
+        if (data.blocks != nullptr) {
+            std::allocator_traits<block_allocator_type>::deallocate(block_allocator, data.blocks, data.blocks_count);
+        }
+    }
+
+    // Element access
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::reference spill_deque<T, Allocator, BlockSizePolicy>::operator[](size_type pos)
+    {
+        assert((pos < size()) && "Invalid element index");
+        return *element_at(pos);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::const_reference spill_deque<T, Allocator, BlockSizePolicy>::operator[](size_type pos) const
+    {
+        assert((pos < size()) && "Invalid element index");
+        return *element_at(pos);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::reference spill_deque<T, Allocator, BlockSizePolicy>::at(size_type pos)
+    {
+        if (pos >= size()) {
+            throw std::out_of_range("Invalid element index");
+        }
+
+        return *element_at(pos);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::const_reference spill_deque<T, Allocator, BlockSizePolicy>::at(size_type pos) const
+    {
+        if (pos >= size()) {
+            throw std::out_of_range("Invalid element index");
+        }
+
+        return *element_at(pos);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::reference spill_deque<T, Allocator, BlockSizePolicy>::front()
+    {
+        assert((!empty()) && "Deque is empty");
+        return *element_at(0);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::const_reference spill_deque<T, Allocator, BlockSizePolicy>::front() const
+    {
+        assert((!empty()) && "Deque is empty");
+        return *element_at(0);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::reference spill_deque<T, Allocator, BlockSizePolicy>::back()
+    {
+        assert((!empty()) && "Deque is empty");
+        return *element_at(size() - 1);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::const_reference spill_deque<T, Allocator, BlockSizePolicy>::back() const
+    {
+        assert((!empty()) && "Deque is empty");
+        return *element_at(size() - 1);
+    }
+
+    // Capacity
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool spill_deque<T, Allocator, BlockSizePolicy>::empty() const noexcept
+    {
+        return data.elements_count == 0;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::size_type spill_deque<T, Allocator, BlockSizePolicy>::size() const noexcept
+    {
+        return data.elements_count;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::size_type spill_deque<T, Allocator, BlockSizePolicy>::ram_blocks_count() const noexcept
+    {
+        return ram_blocks;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::size_type spill_deque<T, Allocator, BlockSizePolicy>::spilled_blocks_count() const noexcept
+    {
+        return spilled_blocks;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::size_type spill_deque<T, Allocator, BlockSizePolicy>::segments_count() const noexcept
+    {
+        return segments.size();
+    }
+
+    // Modifiers
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::clear() noexcept
+    {
+        for (size_type i = 0; i < data.blocks_count; ++i) {
+            if (data.blocks[i] != nullptr) {
+                release_block(data.blocks[i]);
+            }
+        }
+
+        // Elements are trivially destructible, so nothing else has to be done with them
+        data.begin_index = 0;
+        data.elements_count = 0;
+        unmap_all_segments();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::push_back(const T& value)
+    {
+        if (adding_back_element_needs_growth()) {
+            grow_blocks_array();
+        }
+
+        const auto index = data.wrap_index(data.begin_index + data.elements_count);
+        auto& block = data.blocks[data.calculate_block_index(index)];
+
+        if (block == nullptr) {
+            // New block becomes the last one, so the block hot_blocks before it leaves hot tail
+            // Done before anything is changed, so that failure to create segment leaves deque as it was
+            const auto used_blocks = used_blocks_count();
+            if (used_blocks >= hot_blocks) {
+                place_block(block_at(used_blocks - hot_blocks), used_blocks - hot_blocks, used_blocks + 1);
+            }
+
+            block = allocate_ram_block();
+        }
+
+        std::allocator_traits<Allocator>::construct(element_allocator, block + data.calculate_block_offset(index), value);
+        ++data.elements_count;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::push_front(const T& value)
+    {
+        if (adding_front_element_needs_growth()) {
+            grow_blocks_array();
+        }
+
+        const auto index = data.calculate_previous_index(data.begin_index);
+        auto& block = data.blocks[data.calculate_block_index(index)];
+
+        if (block == nullptr) {
+            // New block becomes the first one, so the last block of hot head moves one position further
+            const auto used_blocks = used_blocks_count();
+            if (hot_blocks <= used_blocks) {
+                place_block(block_at(hot_blocks - 1), hot_blocks, used_blocks + 1);
+            }
+
+            block = allocate_ram_block();
+        }
+
+        std::allocator_traits<Allocator>::construct(element_allocator, block + data.calculate_block_offset(index), value);
+        data.begin_index = index;
+        ++data.elements_count;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::pop_back()
+    {
+        assert((!empty()) && "Deque is empty");
+
+        const auto last_block_index = data.calculate_block_index(data.wrap_index(data.begin_index + data.elements_count - 1));
+        --data.elements_count;
+
+        if (data.elements_count == 0 || data.calculate_block_index(data.wrap_index(data.begin_index + data.elements_count - 1)) != last_block_index) {
+            release_block(data.blocks[last_block_index]);
+
+            // Block hot_blocks before the end joins hot tail
+            const auto used_blocks = used_blocks_count();
+            if (used_blocks >= hot_blocks) {
+                try_place_block(block_at(used_blocks - hot_blocks), used_blocks - hot_blocks, used_blocks);
+            }
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::pop_front()
+    {
+        assert((!empty()) && "Deque is empty");
+
+        const auto begin_block_index = data.calculate_block_index(data.begin_index);
+        data.begin_index = data.calculate_next_index(data.begin_index);
+        --data.elements_count;
+
+        if (data.elements_count == 0 || data.calculate_block_index(data.begin_index) != begin_block_index) {
+            release_block(data.blocks[begin_block_index]);
+
+            // Block hot_blocks after the begin joins hot head
+            const auto used_blocks = used_blocks_count();
+            if (hot_blocks <= used_blocks) {
+                try_place_block(block_at(hot_blocks - 1), hot_blocks - 1, used_blocks);
+            }
+        }
+    }
+
+    // Implementation details
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    T* spill_deque<T, Allocator, BlockSizePolicy>::element_at(size_type pos) const
+    {
+        const auto index = data.wrap_index(data.begin_index + pos);
+        return data.blocks[data.calculate_block_index(index)] + data.calculate_block_offset(index);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool spill_deque<T, Allocator, BlockSizePolicy>::adding_back_element_needs_growth() const
+    {
+        if (data.blocks_count == 0 || data.elements_count == data.capacity()) {
+            return true;
+        }
+
+        // Like in deque, elements must not wrap around into the begin block, so that every block holds one run of elements
+        const auto index = data.wrap_index(data.begin_index + data.elements_count);
+        return index < data.begin_index && data.calculate_block_index(index) == data.calculate_block_index(data.begin_index);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool spill_deque<T, Allocator, BlockSizePolicy>::adding_front_element_needs_growth() const
+    {
+        if (data.blocks_count == 0 || data.elements_count == data.capacity()) {
+            return true;
+        }
+
+        if (data.elements_count == 0) {
+            return false;
+        }
+
+        const auto index = data.calculate_previous_index(data.begin_index);
+        const auto last_index = data.wrap_index(data.begin_index + data.elements_count - 1);
+        return index > last_index && data.calculate_block_index(index) == data.calculate_block_index(last_index);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::grow_blocks_array()
+    {
+        // Minimum 2 blocks, like in deque
+        const auto new_blocks_count = data.blocks_count == 0 ? 2 : data.blocks_count * 2;
+        auto new_blocks = std::allocator_traits<block_allocator_type>::allocate(block_allocator, new_blocks_count);
+
+        const auto begin_block_index = data.blocks_count == 0 ? 0 : data.calculate_block_index(data.begin_index);
+        std::rotate_copy(data.blocks, data.blocks + begin_block_index, data.blocks + data.blocks_count, new_blocks);
+        std::fill(new_blocks + data.blocks_count, new_blocks + new_blocks_count, nullptr);
+
+        if (data.blocks != nullptr) {
+            std::allocator_traits<block_allocator_type>::deallocate(block_allocator, data.blocks, data.blocks_count);
+        }
+
+        data.begin_index = data.calculate_block_offset(data.begin_index);
+        data.blocks = new_blocks;
+        data.blocks_count = new_blocks_count;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::size_type spill_deque<T, Allocator, BlockSizePolicy>::used_blocks_count() const
+    {
+        if (data.elements_count == 0) {
+            return 0;
+        }
+
+        const auto used_blocks = (data.calculate_block_offset(data.begin_index) + data.elements_count + block_size - 1) / block_size;
+        return std::min(used_blocks, data.blocks_count);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::block_type& spill_deque<T, Allocator, BlockSizePolicy>::block_at(size_type relative_block) const
+    {
+        return data.blocks[(data.calculate_block_index(data.begin_index) + relative_block) & (data.blocks_count - 1)];
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool spill_deque<T, Allocator, BlockSizePolicy>::should_be_in_ram(size_type relative_block, size_type used_blocks) const
+    {
+        return relative_block < hot_blocks || relative_block + hot_blocks >= used_blocks;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::place_block(block_type& block, size_type relative_block, size_type used_blocks)
+    {
+        if (block == nullptr) {
+            return;
+        }
+
+        const bool in_ram = should_be_in_ram(relative_block, used_blocks);
+        const bool spilled = is_spilled(block);
+
+        if (in_ram && spilled) {
+            unspill_block(block);
+        } else if (!in_ram && !spilled) {
+            spill_block(block);
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::try_place_block(block_type& block, size_type relative_block, size_type used_blocks) noexcept
+    {
+        try {
+            place_block(block, relative_block, used_blocks);
+        } catch (...) {
+            // Pop must not fail, block is still readable from the file
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::size_type spill_deque<T, Allocator, BlockSizePolicy>::find_segment(block_type block) const
+    {
+        const auto address = reinterpret_cast<std::byte*>(block);
+        auto it = std::upper_bound(segments.begin(), segments.end(), address, [](std::byte* a, const segment& s) {
+            return a < s.base;
+        });
+
+        if (it == segments.begin()) {
+            return segments.size();
+        }
+
+        --it;
+        return address < it->base + it->bytes ? static_cast<size_type>(it - segments.begin()) : segments.size();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool spill_deque<T, Allocator, BlockSizePolicy>::is_spilled(block_type block) const
+    {
+        return find_segment(block) != segments.size();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::block_type spill_deque<T, Allocator, BlockSizePolicy>::allocate_ram_block()
+    {
+        auto block = std::allocator_traits<Allocator>::allocate(element_allocator, block_size);
+        ++ram_blocks;
+        return block;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::release_block(block_type& block) noexcept
+    {
+        if (is_spilled(block)) {
+            return_slot(block);
+            --spilled_blocks;
+        } else {
+            std::allocator_traits<Allocator>::deallocate(element_allocator, block, block_size);
+            --ram_blocks;
+        }
+
+        block = nullptr;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::spill_block(block_type& block)
+    {
+        auto slot = acquire_slot();
+        std::memcpy(slot, block, block_bytes);
+
+        std::allocator_traits<Allocator>::deallocate(element_allocator, block, block_size);
+        --ram_blocks;
+
+        block = slot;
+        ++spilled_blocks;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::unspill_block(block_type& block)
+    {
+        auto ram_block = allocate_ram_block();
+        std::memcpy(ram_block, block, block_bytes);
+
+        return_slot(block);
+        --spilled_blocks;
+
+        block = ram_block;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spill_deque<T, Allocator, BlockSizePolicy>::block_type spill_deque<T, Allocator, BlockSizePolicy>::acquire_slot()
+    {
+        if (free_slots.empty()) {
+            map_segment();
+        }
+
+        const auto slot = free_slots.back();
+        free_slots.pop_back();
+        ++segments[find_segment(slot)].used_slots;
+        return slot;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::return_slot(block_type slot) noexcept
+    {
+        // Slot is kept for the next spilled block, free_slots has room for every slot of every segment
+        const auto index = find_segment(slot);
+        free_slots.push_back(slot);
+
+        if (--segments[index].used_slots != 0) {
+            return;
+        }
+
+        // One empty segment is kept, so that a block moving back and forth at the edge of hot blocks
+        // does not create and map a new file every time
+        const auto empty_segments = std::count_if(segments.begin(), segments.end(), [](const segment& s) {
+            return s.used_slots == 0;
+        });
+        if (empty_segments > 1) {
+            unmap_segment(index);
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::map_segment()
+    {
+        const auto bytes = segment_blocks * block_bytes;
+        // Reserved first, so that release_block never has to allocate
+        free_slots.reserve((segments.size() + 1) * segment_blocks);
+        segments.reserve(segments.size() + 1);
+
+        auto path = (directory / "toy_stl_spill_XXXXXX").string();
+        const int fd = ::mkstemp(path.data());
+        if (fd == -1) {
+            throw std::system_error(errno, std::generic_category(), "Failed to create spill segment in " + directory.string());
+        }
+        // File stays on disk only while it is mapped
+        ::unlink(path.c_str());
+
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) == -1) {
+            const auto error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Failed to resize spill segment");
+        }
+
+        void* address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const auto error = errno;
+        // Mapping keeps the file open
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "Failed to map spill segment");
+        }
+
+        const auto base = static_cast<std::byte*>(address);
+        const auto position = std::upper_bound(segments.begin(), segments.end(), base, [](std::byte* a, const segment& s) {
+            return a < s.base;
+        });
+        segments.insert(position, segment { base, bytes, 0 });
+
+        // Backwards, so that slots are taken in order of addresses
+        for (size_type i = segment_blocks; i > 0; --i) {
+            free_slots.push_back(reinterpret_cast<block_type>(base + (i - 1) * block_bytes));
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::unmap_segment(size_type index) noexcept
+    {
+        const auto& s = segments[index];
+        std::erase_if(free_slots, [&s](block_type slot) {
+            const auto address = reinterpret_cast<std::byte*>(slot);
+            return address >= s.base && address < s.base + s.bytes;
+        });
+
+        // File is unlinked, so its disk space is freed together with the mapping
+        ::munmap(s.base, s.bytes);
+        segments.erase(segments.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void spill_deque<T, Allocator, BlockSizePolicy>::unmap_all_segments() noexcept
+    {
+        for (const auto& s : segments) {
+            ::munmap(s.base, s.bytes);
+        }
+
+        segments.clear();
+        free_slots.clear();
+    }
+}
+
+#endif /* TOY_SDL_SPILL_DEQUE_HPP */
@@ -0,0 +1,465 @@
+#ifndef TOY_SDL_SPSC_QUEUE_HPP
+#define TOY_SDL_SPSC_QUEUE_HPP
+
+#include "deque_data.hpp"
+#include "deque_block_size_policy.hpp"
+#include "cache_line.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <algorithm>
+#include <utility>
+
+namespace my
+{
+    // Lock-free queue for exactly one producer thread and one consumer thread
+    // Elements are stored in the same circular array of blocks as in deque, but it never grows
+    // Head and tail only increase and are wrapped on access, so full and empty queues are easy to tell apart
+    // Each side keeps a cached copy of the other side's index and reloads it only when queue looks full or empty,
+    // so in steady state producer and consumer do not touch each other's cache lines
+    template <typename T, typename Allocator = std::allocator<T>, block_size_policy BlockSizePolicy = default_block_size>
+    class spsc_queue
+    {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+
+        // Capacity is rounded up, so that it is a power of two number of whole blocks
+        explicit spsc_queue(size_type capacity, const Allocator& allocator = Allocator());
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+
+        ~spsc_queue();
+
+        // Producer side
+        template <typename ... Args>
+        bool try_emplace(Args&& ... args);
+        bool try_push(const T& value);
+        bool try_push(T&& value);
+        // Pushes as many elements as fit, but not more than count, and publishes them at once
+        // Returns number of pushed elements, first is advanced by the same number
+        template <std::input_iterator InputIt>
+        size_type try_push_n(InputIt first, size_type count);
+
+        // Consumer side
+        bool try_pop(T& value);
+        // Moves up to count elements to out and releases their memory at once, returns number of popped elements
+        template <std::weakly_incrementable OutputIt>
+        size_type try_pop_n(OutputIt out, size_type count);
+
+        // Exact only when neither side is running
+        size_type size_approx() const noexcept;
+        bool empty_approx() const noexcept;
+        size_type capacity() const noexcept;
+
+    private:
+        using deque_data_type = deque_data<value_type, size_type, BlockSizePolicy>;
+        using block_type = typename deque_data_type::block_type;
+        using block_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<block_type>;
+
+        T* element_at(size_type index) const;
+
+        // Only read after construction
+        [[no_unique_address]] Allocator element_allocator;
+        [[no_unique_address]] block_allocator_type block_allocator;
+        deque_data_type data;
+
+        // Producer side, tail is number of pushed elements
+        alignas(cache_line_size) std::atomic<size_type> tail { 0 };
+        size_type cached_head { 0 };
+
+        // Consumer side, head is number of popped elements
+        alignas(cache_line_size) std::atomic<size_type> head { 0 };
+        size_type cached_tail { 0 };
+    };
+
+    // Same as spsc_queue, but producer never fails
+    // When the last block is full, a new block is allocated and linked after it
+    // Consumer frees blocks it has read completely
+    template <typename T, typename Allocator = std::allocator<T>, block_size_policy BlockSizePolicy = default_block_size>
+    class unbounded_spsc_queue
+    {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+
+        constexpr static size_type block_size = BlockSizePolicy::block_size(sizeof(T));
+        static_assert(std::has_single_bit(block_size), "Block size must be power of two");
+
+        explicit unbounded_spsc_queue(const Allocator& allocator = Allocator());
+
+        unbounded_spsc_queue(const unbounded_spsc_queue&) = delete;
+        unbounded_spsc_queue& operator=(const unbounded_spsc_queue&) = delete;
+
+        ~unbounded_spsc_queue();
+
+        // Producer side
+        template <typename ... Args>
+        void emplace(Args&& ... args);
+        void push(const T& value);
+        void push(T&& value);
+        template <std::input_iterator InputIt>
+        void push_n(InputIt first, size_type count);
+
+        // Consumer side
+        bool try_pop(T& value);
+        template <std::weakly_incrementable OutputIt>
+        size_type try_pop_n(OutputIt out, size_type count);
+
+        size_type size_approx() const noexcept;
+        bool empty_approx() const noexcept;
+
+    private:
+        // Next is written by producer before elements of the next block are published with tail
+        struct node
+        {
+            node* next { nullptr };
+            alignas(T) std::byte storage[sizeof(T) * block_size];
+
+            T* elements() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        using node_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<node>;
+
+        constexpr static size_type block_mask = block_size - 1;
+
+        node* allocate_node();
+        void deallocate_node(node* block);
+
+        [[no_unique_address]] node_allocator_type node_allocator;
+
+        // Producer side
+        alignas(cache_line_size) std::atomic<size_type> tail { 0 };
+        node* tail_node { nullptr };
+
+        // Consumer side
+        alignas(cache_line_size) std::atomic<size_type> head { 0 };
+        node* head_node { nullptr };
+        size_type cached_tail { 0 };
+    };
+
+    // spsc_queue
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spsc_queue<T, Allocator, BlockSizePolicy>::spsc_queue(size_type capacity, const Allocator& allocator) :
+        element_allocator(allocator),
+        block_allocator(allocator)
+    {
+        const auto blocks_count = std::bit_ceil(std::max<size_type>((capacity + data.block_size - 1) / data.block_size, 1));
+
+        data.blocks = std::allocator_traits<block_allocator_type>::allocate(block_allocator, blocks_count);
+        data.blocks_count = blocks_count;
+        std::fill(data.blocks, data.blocks + blocks_count, nullptr);
+
+        try {
+            // All blocks are allocated up front, so neither side ever allocates
+            for (size_type i = 0; i < blocks_count; ++i) {
+                data.blocks[i] = std::allocator_traits<Allocator>::allocate(element_allocator, data.block_size);
+                ++data.allocated_blocks_count;
+            }
+        } catch (...) {
+            for (size_type i = 0; i < data.allocated_blocks_count; ++i) {
+                std::allocator_traits<Allocator>::deallocate(element_allocator, data.blocks[i], data.block_size);
+            }
+            std::allocator_traits<block_allocator_type>::deallocate(block_allocator, data.blocks, blocks_count);
+            throw;
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spsc_queue<T, Allocator, BlockSizePolicy>::~spsc_queue()
+    {
+        const auto last = tail.load(std::memory_order_acquire);
+        for (auto index = head.load(std::memory_order_relaxed); index != last; ++index) {
+            std::allocator_traits<Allocator>::destroy(element_allocator, element_at(index));
+        }
+
+        for (size_type i = 0; i < data.blocks_count; ++i) {
+            std::allocator_traits<Allocator>::deallocate(element_allocator, data.blocks[i], data.block_size);
+        }
+        std::allocator_traits<block_allocator_type>::deallocate(block_allocator, data.blocks, data.blocks_count);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <typename ... Args>
+    bool spsc_queue<T, Allocator, BlockSizePolicy>::try_emplace(Args&& ... args)
+    {
+        const auto current_tail = tail.load(std::memory_order_relaxed);
+
+        if (current_tail - cached_head == capacity()) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (current_tail - cached_head == capacity()) {
+                return false;
+            }
+        }
+
+        std::allocator_traits<Allocator>::construct(element_allocator, element_at(current_tail), std::forward<Args>(args) ...);
+        tail.store(current_tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool spsc_queue<T, Allocator, BlockSizePolicy>::try_push(const T& value)
+    {
+        return try_emplace(value);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool spsc_queue<T, Allocator, BlockSizePolicy>::try_push(T&& value)
+    {
+        return try_emplace(std::move(value));
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <std::input_iterator InputIt>
+    spsc_queue<T, Allocator, BlockSizePolicy>::size_type spsc_queue<T, Allocator, BlockSizePolicy>::try_push_n(InputIt first, size_type count)
+    {
+        const auto current_tail = tail.load(std::memory_order_relaxed);
+
+        if (capacity() - (current_tail - cached_head) < count) {
+            cached_head = head.load(std::memory_order_acquire);
+        }
+
+        const auto pushed = std::min(count, capacity() - (current_tail - cached_head));
+        size_type i = 0;
+
+        try {
+            for (; i < pushed; ++i, ++first) {
+                std::allocator_traits<Allocator>::construct(element_allocator, element_at(current_tail + i), *first);
+            }
+        } catch (...) {
+            // Elements that were constructed are published anyway
+            tail.store(current_tail + i, std::memory_order_release);
+            throw;
+        }
+
+        tail.store(current_tail + pushed, std::memory_order_release);
+        return pushed;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool spsc_queue<T, Allocator, BlockSizePolicy>::try_pop(T& value)
+    {
+        return try_pop_n(&value, 1) == 1;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <std::weakly_incrementable OutputIt>
+    spsc_queue<T, Allocator, BlockSizePolicy>::size_type spsc_queue<T, Allocator, BlockSizePolicy>::try_pop_n(OutputIt out, size_type count)
+    {
+        const auto current_head = head.load(std::memory_order_relaxed);
+
+        if (cached_tail - current_head < count) {
+            cached_tail = tail.load(std::memory_order_acquire);
+        }
+
+        const auto popped = std::min(count, cached_tail - current_head);
+        size_type i = 0;
+
+        try {
+            for (; i < popped; ++i, ++out) {
+                auto element = element_at(current_head + i);
+                *out = std::move(*element);
+                std::allocator_traits<Allocator>::destroy(element_allocator, element);
+            }
+        } catch (...) {
+            // Element that failed to move stays in the queue
+            head.store(current_head + i, std::memory_order_release);
+            throw;
+        }
+
+        head.store(current_head + popped, std::memory_order_release);
+        return popped;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spsc_queue<T, Allocator, BlockSizePolicy>::size_type spsc_queue<T, Allocator, BlockSizePolicy>::size_approx() const noexcept
+    {
+        // Head is loaded first, so the difference never underflows
+        const auto current_head = head.load(std::memory_order_acquire);
+        return tail.load(std::memory_order_acquire) - current_head;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool spsc_queue<T, Allocator, BlockSizePolicy>::empty_approx() const noexcept
+    {
+        return size_approx() == 0;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    spsc_queue<T, Allocator, BlockSizePolicy>::size_type spsc_queue<T, Allocator, BlockSizePolicy>::capacity() const noexcept
+    {
+        return data.capacity();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    T* spsc_queue<T, Allocator, BlockSizePolicy>::element_at(size_type index) const
+    {
+        const auto absolute_index = data.wrap_index(index);
+        return data.blocks[data.calculate_block_index(absolute_index)] + data.calculate_block_offset(absolute_index);
+    }
+
+    // unbounded_spsc_queue
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::unbounded_spsc_queue(const Allocator& allocator) :
+        node_allocator(allocator)
+    {
+        tail_node = head_node = allocate_node();
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::~unbounded_spsc_queue()
+    {
+        const auto last = tail.load(std::memory_order_acquire);
+        auto index = head.load(std::memory_order_relaxed);
+        auto block = head_node;
+
+        for (; index != last; ++index) {
+            if ((index & block_mask) == 0 && index != 0) {
+                block = block->next;
+            }
+            std::destroy_at(block->elements() + (index & block_mask));
+        }
+
+        while (head_node != nullptr) {
+            auto next = head_node->next;
+            deallocate_node(head_node);
+            head_node = next;
+        }
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <typename ... Args>
+    void unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::emplace(Args&& ... args)
+    {
+        const auto current_tail = tail.load(std::memory_order_relaxed);
+        const auto offset = current_tail & block_mask;
+
+        // Block is linked before the element is published, so consumer always finds it
+        if (offset == 0 && current_tail != 0) {
+            auto new_node = allocate_node();
+            tail_node->next = new_node;
+            tail_node = new_node;
+        }
+
+        std::construct_at(tail_node->elements() + offset, std::forward<Args>(args) ...);
+        tail.store(current_tail + 1, std::memory_order_release);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::push(const T& value)
+    {
+        emplace(value);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::push(T&& value)
+    {
+        emplace(std::move(value));
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <std::input_iterator InputIt>
+    void unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::push_n(InputIt first, size_type count)
+    {
+        const auto current_tail = tail.load(std::memory_order_relaxed);
+        size_type i = 0;
+
+        try {
+            for (; i < count; ++i, ++first) {
+                const auto offset = (current_tail + i) & block_mask;
+                if (offset == 0 && current_tail + i != 0) {
+                    auto new_node = allocate_node();
+                    tail_node->next = new_node;
+                    tail_node = new_node;
+                }
+
+                std::construct_at(tail_node->elements() + offset, *first);
+            }
+        } catch (...) {
+            tail.store(current_tail + i, std::memory_order_release);
+            throw;
+        }
+
+        tail.store(current_tail + count, std::memory_order_release);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::try_pop(T& value)
+    {
+        return try_pop_n(&value, 1) == 1;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    template <std::weakly_incrementable OutputIt>
+    unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::size_type unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::try_pop_n(OutputIt out, size_type count)
+    {
+        const auto current_head = head.load(std::memory_order_relaxed);
+
+        if (cached_tail - current_head < count) {
+            cached_tail = tail.load(std::memory_order_acquire);
+        }
+
+        const auto popped = std::min(count, cached_tail - current_head);
+        size_type i = 0;
+
+        try {
+            for (; i < popped; ++i, ++out) {
+                const auto offset = (current_head + i) & block_mask;
+
+                // Element after the end of the block is published, so producer has already moved to the next block
+                if (offset == 0 && current_head + i != 0) {
+                    auto next = head_node->next;
+                    deallocate_node(head_node);
+                    head_node = next;
+                }
+
+                auto element = head_node->elements() + offset;
+                *out = std::move(*element);
+                std::destroy_at(element);
+            }
+        } catch (...) {
+            head.store(current_head + i, std::memory_order_release);
+            throw;
+        }
+
+        head.store(current_head + popped, std::memory_order_release);
+        return popped;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::size_type unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::size_approx() const noexcept
+    {
+        const auto current_head = head.load(std::memory_order_acquire);
+        return tail.load(std::memory_order_acquire) - current_head;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    bool unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::empty_approx() const noexcept
+    {
+        return size_approx() == 0;
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::node* unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::allocate_node()
+    {
+        auto block = std::allocator_traits<node_allocator_type>::allocate(node_allocator, 1);
+        return std::construct_at(block);
+    }
+
+    template <typename T, typename Allocator, block_size_policy BlockSizePolicy>
+    void unbounded_spsc_queue<T, Allocator, BlockSizePolicy>::deallocate_node(node* block)
+    {
+        std::destroy_at(block);
+        std::allocator_traits<node_allocator_type>::deallocate(node_allocator, block, 1);
+    }
+}
+
+#endif /* TOY_SDL_SPSC_QUEUE_HPP */
@@ -0,0 +1,772 @@
+#ifndef TOY_SDL_STATIC_VECTOR_HPP
+#define TOY_SDL_STATIC_VECTOR_HPP
+
+#include "vector_iterator.hpp"
+#include "vector_const_iterator.hpp"
+#include "iterator.hpp"
+#include "algorithm.hpp"
+#include "ranges.hpp"
+
+#include <stdexcept>
+#include <new>
+#include <cassert>
+#include <memory>
+#include <algorithm>
+#include <utility>
+
+namespace my
+{
+    // Vector with capacity fixed at compile time and elements stored inside the object
+    // Never allocates, so it can be used where calls to malloc are not allowed
+    // If elements don't fit, functions throw std::bad_alloc, try_ versions return nullptr instead
+    template <typename T, std::size_t N>
+    class static_vector
+    {
+        static_assert(N > 0, "static_vector must be able to hold at least one element");
+
+    public:
+        // Member types
+        using value_type = T;
+
+        using reference = T&;
+        using const_reference = const T&;
+
+        using pointer = T*;
+        using const_pointer = const T*;
+
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        using iterator = vector_iterator<T>;
+        using const_iterator = vector_const_iterator<T>;
+
+        using reverse_iterator = my::reverse_iterator<iterator>;
+        using const_reverse_iterator = my::reverse_iterator<const_iterator>;
+
+        // Constructors
+        constexpr static_vector() noexcept;
+        constexpr explicit static_vector(size_type size);
+        constexpr static_vector(size_type size, const T& value);
+        template <std::input_iterator I>
+        constexpr static_vector(I first, I last);
+        constexpr static_vector(std::initializer_list<T> init_list);
+
+        // Rule of 5
+        constexpr static_vector(const static_vector& other);
+        constexpr static_vector& operator= (const static_vector& other);
+        constexpr static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+        constexpr static_vector& operator= (static_vector&& other) noexcept(std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_constructible_v<T>);
+        constexpr ~static_vector();
+
+        // Other
+        constexpr static_vector& operator= (std::initializer_list<T> init_list);
+        template <std::input_iterator I>
+        constexpr void assign(I first, I last);
+        constexpr void assign(std::initializer_list<T> init_list);
+        template <container_compatible_range<T> R>
+        constexpr void assign_range(R&& range);
+        constexpr void swap(static_vector& other) noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>);
+
+        // Propery access
+        constexpr bool empty() const noexcept;
+        constexpr bool full() const noexcept;
+        constexpr size_type size() const noexcept;
+        constexpr static size_type max_size() noexcept;
+        constexpr static size_type capacity() noexcept;
+        constexpr T* data() noexcept;
+        constexpr const T* data() const noexcept;
+
+        // Comparison
+        constexpr bool operator== (const static_vector& other) const;
+        constexpr synth_three_way_result<T> operator<=> (const static_vector& other) const;
+
+        // Element access
+        constexpr reference operator[] (size_type index);
+        constexpr const_reference operator[] (size_type index) const;
+        constexpr reference at(size_type index);
+        constexpr const_reference at(size_type index) const;
+        constexpr reference front();
+        constexpr const_reference front() const;
+        constexpr reference back();
+        constexpr const_reference back() const;
+
+        // Adding/removing elements
+        constexpr void push_back(const T& value);
+        constexpr void push_back(T&& value);
+        constexpr void pop_back();
+        template <typename ... Args>
+        constexpr reference emplace_back(Args&& ... args);
+        // Do not throw if vector is full, return nullptr instead
+        template <typename ... Args>
+        constexpr pointer try_emplace_back(Args&& ... args);
+        constexpr pointer try_push_back(const T& value);
+        constexpr pointer try_push_back(T&& value);
+        // Same as emplace_back, but vector must not be full
+        template <typename ... Args>
+        constexpr reference unchecked_emplace_back(Args&& ... args);
+        constexpr iterator insert(const_iterator pos, const T& value);
+        constexpr iterator insert(const_iterator pos, T&& value);
+        constexpr iterator insert(const_iterator pos, size_type count, const T& value);
+        template <std::input_iterator InputIt>
+        constexpr iterator insert(const_iterator pos, InputIt first, InputIt last);
+        constexpr iterator insert(const_iterator pos, std::initializer_list<T> init_list);
+        template <container_compatible_range<T> R>
+        constexpr iterator insert_range(const_iterator pos, R&& range);
+        template <container_compatible_range<T> R>
+        constexpr void append_range(R&& range);
+        constexpr iterator erase(const_iterator pos);
+        constexpr iterator erase(const_iterator first, const_iterator last);
+        template <typename ... Args>
+        constexpr iterator emplace(const_iterator pos, Args&& ... args);
+
+        // Size modification
+        constexpr void clear() noexcept;
+        constexpr void resize(size_type new_size);
+        constexpr void resize(size_type new_size, const T& value);
+
+        // Iterators
+        constexpr iterator begin() noexcept;
+        constexpr iterator end() noexcept;
+        constexpr const_iterator begin() const noexcept;
+        constexpr const_iterator end() const noexcept;
+        constexpr const_iterator cbegin() const noexcept;
+        constexpr const_iterator cend() const noexcept;
+
+        // Reverse iterators
+        constexpr reverse_iterator rbegin() noexcept;
+        constexpr reverse_iterator rend() noexcept;
+        constexpr const_reverse_iterator rbegin() const noexcept;
+        constexpr const_reverse_iterator rend() const noexcept;
+        constexpr const_reverse_iterator crbegin() const noexcept;
+        constexpr const_reverse_iterator crend() const noexcept;
+
+    private:
+        // Throws std::bad_alloc if count more elements would not fit
+        constexpr void check_free_space(size_type count) const;
+
+        // Moves elements [first, size) to position pos, so that elements appended to the end end up at pos
+        constexpr iterator rotate_to(size_type position, size_type first);
+
+        constexpr void destroy_range(pointer begin, pointer end);
+
+        // Union, so that elements are not constructed together with vector
+        // Elements in range [0, size_) are alive, others are not
+        union
+        {
+            T elements_[N];
+        };
+        size_type size_ { 0 };
+    };
+
+    // Constructors
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::static_vector() noexcept
+    {
+
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::static_vector(size_type size) : static_vector()
+    {
+        resize(size);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::static_vector(size_type size, const T& value) : static_vector()
+    {
+        resize(size, value);
+    }
+
+    template <typename T, std::size_t N>
+    template <std::input_iterator I>
+    constexpr static_vector<T, N>::static_vector(I first, I last) : static_vector()
+    {
+        // Destructor is called if this throws, because delegated constructor has already finished
+        insert(cend(), first, last);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::static_vector(std::initializer_list<T> init_list) :
+        static_vector(std::begin(init_list), std::end(init_list))
+    {
+
+    }
+
+    // Rule of 5
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::static_vector(const static_vector& other) : static_vector()
+    {
+        for (const auto& element : other) {
+            unchecked_emplace_back(element);
+        }
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>& static_vector<T, N>::operator= (const static_vector& other)
+    {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+
+        return *this;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) :
+        static_vector()
+    {
+        // Elements are stored inside the object, so they can only be moved one by one
+        for (auto& element : other) {
+            unchecked_emplace_back(std::move(element));
+        }
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>& static_vector<T, N>::operator= (static_vector&& other) noexcept(
+        std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_constructible_v<T>
+    )
+    {
+        if (this != &other) {
+            assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+
+        return *this;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::~static_vector()
+    {
+        destroy_range(data(), data() + size_);
+    }
+
+    // Other
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>& static_vector<T, N>::operator= (std::initializer_list<T> init_list)
+    {
+        assign(init_list);
+        return *this;
+    }
+
+    template <typename T, std::size_t N>
+    template <std::input_iterator I>
+    constexpr void static_vector<T, N>::assign(I first, I last)
+    {
+        if constexpr (std::forward_iterator<I>) {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            if (count > N) {
+                throw std::bad_alloc();
+            }
+
+            // Assign new values to existing elements, then construct or destroy the rest
+            size_type i = 0;
+            for (; i < size_ && first != last; ++i, ++first) {
+                elements_[i] = *first;
+            }
+
+            destroy_range(data() + i, data() + size_);
+            size_ = i;
+
+            for (; first != last; ++first) {
+                unchecked_emplace_back(*first);
+            }
+        } else {
+            clear();
+            insert(cend(), first, last);
+        }
+    }
+
+    template <typename T, std::size_t N>
+    constexpr void static_vector<T, N>::assign(std::initializer_list<T> init_list)
+    {
+        assign(std::begin(init_list), std::end(init_list));
+    }
+
+    template <typename T, std::size_t N>
+    template <container_compatible_range<T> R>
+    constexpr void static_vector<T, N>::assign_range(R&& range)
+    {
+        if constexpr (std::ranges::common_range<R>) {
+            assign(std::ranges::begin(range), std::ranges::end(range));
+        } else {
+            clear();
+            append_range(std::forward<R>(range));
+        }
+    }
+
+    template <typename T, std::size_t N>
+    constexpr void static_vector<T, N>::swap(static_vector& other) noexcept(
+        std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>
+    )
+    {
+        // Swap common prefix, then move the rest from longer vector to shorter one
+        static_vector* shorter = size_ < other.size_ ? this : &other;
+        static_vector* longer = size_ < other.size_ ? &other : this;
+
+        using std::swap;
+        for (size_type i = 0; i < shorter->size_; ++i) {
+            swap(elements_[i], other.elements_[i]);
+        }
+
+        const auto common_size = shorter->size_;
+        for (size_type i = common_size; i < longer->size_; ++i) {
+            shorter->unchecked_emplace_back(std::move(longer->elements_[i]));
+        }
+
+        longer->destroy_range(longer->data() + common_size, longer->data() + longer->size_);
+        longer->size_ = common_size;
+    }
+
+    // Propery access
+    template <typename T, std::size_t N>
+    constexpr bool static_vector<T, N>::empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr bool static_vector<T, N>::full() const noexcept
+    {
+        return size_ == N;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::size_type static_vector<T, N>::size() const noexcept
+    {
+        return size_;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::size_type static_vector<T, N>::max_size() noexcept
+    {
+        return N;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::size_type static_vector<T, N>::capacity() noexcept
+    {
+        return N;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr T* static_vector<T, N>::data() noexcept
+    {
+        return elements_;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr const T* static_vector<T, N>::data() const noexcept
+    {
+        return elements_;
+    }
+
+    // Comparisons
+    template <typename T, std::size_t N>
+    constexpr bool static_vector<T, N>::operator== (const static_vector& other) const
+    {
+        if constexpr (my::is_bitwise_comparable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return size_ == other.size_ && my::bitwise_equal(data(), other.data(), size_);
+            }
+        }
+
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+    template <typename T, std::size_t N>
+    constexpr synth_three_way_result<T> static_vector<T, N>::operator<=> (const static_vector& other) const
+    {
+        if constexpr (my::is_bitwise_comparable_v<T> && std::three_way_comparable<T>) {
+            if (!std::is_constant_evaluated()) {
+                return my::bitwise_compare_three_way(data(), size_, other.data(), other.size_);
+            }
+        }
+
+        return my::lexicographical_compare_three_way(
+            begin(), end(),
+            other.begin(), other.end(),
+            my::synth_three_way { }
+        );
+    }
+
+    // Element access
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::reference static_vector<T, N>::operator[] (size_type index)
+    {
+        return elements_[index];
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_reference static_vector<T, N>::operator[] (size_type index) const
+    {
+        return elements_[index];
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::reference static_vector<T, N>::at(size_type index)
+    {
+        if (index >= size()) {
+            throw std::out_of_range("Invalid element index");
+        }
+
+        return (*this)[index];
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_reference static_vector<T, N>::at(size_type index) const
+    {
+        if (index >= size()) {
+            throw std::out_of_range("Invalid element index");
+        }
+
+        return (*this)[index];
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::reference static_vector<T, N>::front()
+    {
+        return (*this)[0];
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_reference static_vector<T, N>::front() const
+    {
+        return (*this)[0];
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::reference static_vector<T, N>::back()
+    {
+        return (*this)[size() - 1];
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_reference static_vector<T, N>::back() const
+    {
+        return (*this)[size() - 1];
+    }
+
+    // Adding/removing elements
+    template <typename T, std::size_t N>
+    constexpr void static_vector<T, N>::push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr void static_vector<T, N>::push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <typename T, std::size_t N>
+    constexpr void static_vector<T, N>::pop_back()
+    {
+        assert((size_ > 0) && "Trying to remove last element of empty vector is undefined behavior");
+
+        size_ -= 1;
+        std::destroy_at(data() + size_);
+    }
+
+    template <typename T, std::size_t N>
+    template <typename ... Args>
+    constexpr static_vector<T, N>::reference static_vector<T, N>::emplace_back(Args&& ... args)
+    {
+        check_free_space(1);
+        return unchecked_emplace_back(std::forward<Args>(args) ...);
+    }
+
+    template <typename T, std::size_t N>
+    template <typename ... Args>
+    constexpr static_vector<T, N>::pointer static_vector<T, N>::try_emplace_back(Args&& ... args)
+    {
+        if (full()) {
+            return nullptr;
+        }
+
+        return std::addressof(unchecked_emplace_back(std::forward<Args>(args) ...));
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::pointer static_vector<T, N>::try_push_back(const T& value)
+    {
+        return try_emplace_back(value);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::pointer static_vector<T, N>::try_push_back(T&& value)
+    {
+        return try_emplace_back(std::move(value));
+    }
+
+    template <typename T, std::size_t N>
+    template <typename ... Args>
+    constexpr static_vector<T, N>::reference static_vector<T, N>::unchecked_emplace_back(Args&& ... args)
+    {
+        assert((size_ < N) && "Vector is full");
+
+        std::construct_at(data() + size_, std::forward<Args>(args) ...);
+        size_ += 1;
+
+        return back();
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::insert(const_iterator pos, const T& value)
+    {
+        return emplace(pos, value);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::insert(const_iterator pos, T&& value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::insert(const_iterator pos, size_type count, const T& value)
+    {
+        const auto insert_position = static_cast<size_type>(pos - cbegin());
+        check_free_space(count);
+
+        // Value can reference element of this vector, so copies are made before anything is moved
+        const auto old_size = size_;
+        for (size_type i = 0; i < count; ++i) {
+            unchecked_emplace_back(value);
+        }
+
+        return rotate_to(insert_position, old_size);
+    }
+
+    template <typename T, std::size_t N>
+    template <std::input_iterator InputIt>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        const auto insert_position = static_cast<size_type>(pos - cbegin());
+
+        if constexpr (std::forward_iterator<InputIt>) {
+            check_free_space(static_cast<size_type>(std::distance(first, last)));
+        }
+
+        const auto old_size = size_;
+        try {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        } catch (...) {
+            // Remove what was appended, so old elements stay in their places
+            destroy_range(data() + old_size, data() + size_);
+            size_ = old_size;
+            throw;
+        }
+
+        return rotate_to(insert_position, old_size);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::insert(const_iterator pos, std::initializer_list<T> init_list)
+    {
+        return insert(pos, std::begin(init_list), std::end(init_list));
+    }
+
+    template <typename T, std::size_t N>
+    template <container_compatible_range<T> R>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::insert_range(const_iterator pos, R&& range)
+    {
+        if constexpr (std::ranges::common_range<R>) {
+            return insert(pos, std::ranges::begin(range), std::ranges::end(range));
+        } else {
+            const auto insert_position = static_cast<size_type>(pos - cbegin());
+            const auto old_size = size_;
+
+            try {
+                auto last = std::ranges::end(range);
+                for (auto i = std::ranges::begin(range); i != last; ++i) {
+                    emplace_back(*i);
+                }
+            } catch (...) {
+                destroy_range(data() + old_size, data() + size_);
+                size_ = old_size;
+                throw;
+            }
+
+            return rotate_to(insert_position, old_size);
+        }
+    }
+
+    template <typename T, std::size_t N>
+    template <container_compatible_range<T> R>
+    constexpr void static_vector<T, N>::append_range(R&& range)
+    {
+        insert_range(cend(), std::forward<R>(range));
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::erase(const_iterator first, const_iterator last)
+    {
+        const auto first_index = first - cbegin();
+        const auto last_index = last - cbegin();
+
+        if (first_index != last_index) {
+            auto new_end = std::move(data() + last_index, data() + size_, data() + first_index);
+            destroy_range(new_end, data() + size_);
+            size_ = static_cast<size_type>(new_end - data());
+        }
+
+        return iterator(data() + first_index);
+    }
+
+    template <typename T, std::size_t N>
+    template <typename ... Args>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::emplace(const_iterator pos, Args&& ... args)
+    {
+        const auto new_element_index = static_cast<size_type>(pos - cbegin());
+
+        // Constructed at the end first, because arguments can reference elements that are going to be moved
+        emplace_back(std::forward<Args>(args) ...);
+
+        return rotate_to(new_element_index, size_ - 1);
+    }
+
+    // Size modification
+    template <typename T, std::size_t N>
+    constexpr void static_vector<T, N>::clear() noexcept
+    {
+        destroy_range(data(), data() + size_);
+        size_ = 0;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr void static_vector<T, N>::resize(size_type new_size)
+    {
+        if (new_size > size_) {
+            check_free_space(new_size - size_);
+            while (size_ < new_size) {
+                unchecked_emplace_back();
+            }
+        } else {
+            destroy_range(data() + new_size, data() + size_);
+            size_ = new_size;
+        }
+    }
+
+    template <typename T, std::size_t N>
+    constexpr void static_vector<T, N>::resize(size_type new_size, const T& value)
+    {
+        if (new_size > size_) {
+            check_free_space(new_size - size_);
+            while (size_ < new_size) {
+                unchecked_emplace_back(value);
+            }
+        } else {
+            destroy_range(data() + new_size, data() + size_);
+            size_ = new_size;
+        }
+    }
+
+    // Iterators
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::begin() noexcept
+    {
+        return iterator(data());
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::end() noexcept
+    {
+        return iterator(data() + size_);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_iterator static_vector<T, N>::begin() const noexcept
+    {
+        // vector_const_iterator is constructed from non-const pointer, but does not allow modification
+        return const_iterator(const_cast<T*>(data()));
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_iterator static_vector<T, N>::end() const noexcept
+    {
+        return const_iterator(const_cast<T*>(data()) + size_);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_iterator static_vector<T, N>::cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_iterator static_vector<T, N>::cend() const noexcept
+    {
+        return end();
+    }
+
+    // Reverse iterators
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::reverse_iterator static_vector<T, N>::rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::reverse_iterator static_vector<T, N>::rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_reverse_iterator static_vector<T, N>::rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_reverse_iterator static_vector<T, N>::rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_reverse_iterator static_vector<T, N>::crbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::const_reverse_iterator static_vector<T, N>::crend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    // Private member functions
+    template <typename T, std::size_t N>
+    constexpr void static_vector<T, N>::check_free_space(size_type count) const
+    {
+        if (count > N - size_) {
+            throw std::bad_alloc();
+        }
+    }
+
+    template <typename T, std::size_t N>
+    constexpr static_vector<T, N>::iterator static_vector<T, N>::rotate_to(size_type position, size_type first)
+    {
+        std::rotate(data() + position, data() + first, data() + size_);
+        return iterator(data() + position);
+    }
+
+    template <typename T, std::size_t N>
+    constexpr void static_vector<T, N>::destroy_range(pointer begin, pointer end)
+    {
+        for (; begin != end; ++begin) {
+            std::destroy_at(begin);
+        }
+    }
+}
+
+#endif /* TOY_SDL_STATIC_VECTOR_HPP */
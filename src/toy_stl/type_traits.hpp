@@ -0,0 +1,32 @@
+#ifndef TOY_SDL_TYPE_TRAITS_HPP
+#define TOY_SDL_TYPE_TRAITS_HPP
+
+#include <type_traits>
+
+namespace my
+{
+    // Type is trivially relocatable if moving object to new location and ending lifetime of the old one
+    // is equivalent to copying its bytes (and not calling destructor for old object)
+    // Trivially copyable types are always trivially relocatable
+    // Other types (for example types with pointer to heap memory) can opt in by specializing this template:
+    //     template <>
+    //     struct my::is_trivially_relocatable<Foo> : std::true_type { };
+    // Types that store pointers to themselves or register their address somewhere must not do this
+    template <typename T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> { };
+
+    template <typename T>
+    constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    // Type is bitwise comparable if two objects are equal exactly when their bytes are equal
+    // Then ranges of such objects can be compared with memcmp
+    // Integers, enums and pointers are bitwise comparable, floating point types are not (because of -0.0 and NaN)
+    // Other types can opt in by specializing this template, but they must not have padding bytes
+    template <typename T>
+    struct is_bitwise_comparable : std::bool_constant<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>> { };
+
+    template <typename T>
+    constexpr bool is_bitwise_comparable_v = is_bitwise_comparable<T>::value;
+}
+
+#endif /* TOY_SDL_TYPE_TRAITS_HPP */
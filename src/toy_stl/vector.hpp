@@ -4,16 +4,22 @@
 #include "vector_iterator.hpp"
 #include "vector_const_iterator.hpp"
 #include "iterator.hpp"
+#include "type_traits.hpp"
+#include "algorithm.hpp"
+#include "vector_growth_policy.hpp"
+#include "ranges.hpp"
 
 #include <stdexcept>
 #include <new>
 #include <cassert>
 #include <memory>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
 
 namespace my
 {
-    template <typename T, typename A = std::allocator<T>>
+    template <typename T, typename A = std::allocator<T>, growth_policy GrowthPolicy = double_growth>
     class vector
     {
     public:
@@ -36,6 +42,7 @@ namespace my
         using const_reverse_iterator = my::reverse_iterator<const_iterator>;
 
         using allocator_type = A;
+        using growth_policy_type = GrowthPolicy;
 
         // Constructors
         constexpr vector() noexcept(noexcept(A()));
@@ -55,6 +62,11 @@ namespace my
 
         // Other
         constexpr vector& operator= (std::initializer_list<T> init_list);
+        template <std::input_iterator I>
+        constexpr void assign(I first, I last);
+        constexpr void assign(std::initializer_list<T> init_list);
+        template <container_compatible_range<T> R>
+        constexpr void assign_range(R&& range);
         constexpr void swap(vector& other) noexcept(
             std::allocator_traits<allocator_type>::propagate_on_container_swap::value || std::allocator_traits<allocator_type>::is_always_equal::value
         );
@@ -90,9 +102,13 @@ namespace my
         constexpr iterator insert(const_iterator pos, const T& value);
         constexpr iterator insert(const_iterator pos, T&& value);
         constexpr iterator insert(const_iterator pos, size_type count, const T& value);
-        template <std::random_access_iterator InputIt>
+        template <std::input_iterator InputIt>
         constexpr iterator insert(const_iterator pos, InputIt first, InputIt last);
         constexpr iterator insert(const_iterator pos, std::initializer_list<T> init_list);
+        template <container_compatible_range<T> R>
+        constexpr iterator insert_range(const_iterator pos, R&& range);
+        template <container_compatible_range<T> R>
+        constexpr void append_range(R&& range);
         constexpr iterator erase(const_iterator pos);
         constexpr iterator erase(const_iterator first, const_iterator last);
         template <typename ... Args>
@@ -102,6 +118,9 @@ namespace my
         constexpr void clear() noexcept;
         constexpr void resize(size_type new_size);
         constexpr void resize(size_type new_size, const T& value);
+        // Same as resize, but new elements are default-initialized instead of value-initialized
+        // So trivial types (like char or int) are left uninitialized and can be overwritten without zeroing memory first
+        constexpr void resize_for_overwrite(size_type new_size);
         constexpr void reserve(size_type new_capacity);
         constexpr void shrink_to_fit();
 
@@ -121,18 +140,48 @@ namespace my
         constexpr const_reverse_iterator crbegin() const noexcept;
         constexpr const_reverse_iterator crend() const noexcept;
 
-    private:
+    protected:
+        // Protected, because small_vector reuses all of this
+        // Elements can be relocated with memcpy only if allocator does not customize their construction and destruction
+        constexpr static bool is_bitwise_relocatable =
+            my::is_trivially_relocatable_v<T> &&
+            !requires (A& allocator, T* p) { allocator.construct(p, std::declval<T&&>()); } &&
+            !requires (A& allocator, T* p) { allocator.destroy(p); };
+        // Default-initialization bypasses allocator, so it is used only if allocator does not customize construction
+        constexpr static bool is_default_initializable =
+            !requires (A& allocator, T* p) { allocator.construct(p); };
+
         bool is_memory_filled() const;
-        size_type calculate_new_capacity() const;
-        void grow();
+        // Capacity to grow to when vector needs at least required_capacity elements
+        size_type calculate_new_capacity(size_type required_capacity) const;
+
+        // Moves elements to new memory
+        // If exception is thrown vector is left unchanged (as long as element type is copyable or has noexcept move)
+        constexpr void reallocate(size_type new_capacity);
+        // Same, but leaves gap of gap_size elements at gap_position, which is filled by construct_gap(pointer to gap)
+        // Gap is filled before old elements are moved, so new elements can be constructed from references to old ones
+        template <typename ConstructGap>
+        constexpr void reallocate(size_type new_capacity, size_type gap_position, size_type gap_size, ConstructGap construct_gap);
+
+        // Bulk modifiers behind assign, insert and their range versions
+        // Counted versions know number of elements in advance, so memory is allocated at most once
+        template <std::forward_iterator I>
+        constexpr void assign_counted(I first, size_type count);
+        template <std::forward_iterator I>
+        constexpr iterator insert_counted(size_type insert_position, I first, size_type count);
+        // Single pass ranges are appended to the end and then rotated into place
+        template <std::input_iterator I, std::sentinel_for<I> S>
+        constexpr iterator insert_single_pass(size_type insert_position, I first, S last);
 
         // TODO: Rename these, cause now things operate on 2 ranges vs 1 range and value have similar names
         constexpr void destroy_range(pointer begin, pointer end);
         constexpr void default_construct_range(pointer begin, pointer end);
+        constexpr void default_initialize_range(pointer begin, pointer end);
         constexpr void copy_construct_range(pointer begin, pointer end, const T& value);
         template <typename InputIt, typename OutputIt>
         constexpr void copy_range(InputIt source_begin, InputIt source_end, OutputIt destination_begin);
         constexpr void move_range(pointer source_begin, pointer source_end, pointer destination_begin);
+        constexpr void move_if_noexcept_range(pointer source_begin, pointer source_end, pointer destination_begin);
         constexpr void copy_range_backwards(pointer source_begin, pointer source_end, pointer destination_end);
         constexpr void move_range_backwards(pointer source_begin, pointer source_end, pointer destination_end);
         constexpr void copy_assign_range(pointer begin, pointer end, const T& value);
@@ -140,29 +189,33 @@ namespace my
         constexpr void copy_assign_range_to_range(InputIt source_begin, InputIt source_end, OutputIt destination_begin);
         constexpr void move_assign_range_backwards(pointer source_begin, pointer source_end, pointer destination_end);
         constexpr void move_assign_range(pointer source_begin, pointer source_end, pointer destination_begin);
+        // Copies bytes of elements to uninitialized memory, lifetime of the source elements ends without destructor call
+        // Can be used only if is_bitwise_relocatable is true
+        constexpr void relocate_range_bitwise(pointer source_begin, pointer source_end, pointer destination_begin);
 
         A allocator_ { };
+        [[no_unique_address]] GrowthPolicy growth_policy_ { };
         size_type size_ {0};
         size_type capacity_ {0};
         T* data_ {nullptr};
     };
 
     // Constructors
-    template <typename T, typename A>
-    constexpr vector<T, A>::vector() noexcept(noexcept(A()))
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::vector() noexcept(noexcept(A()))
     {
 
     }
 
     // Constructors
-    template <typename T, typename A>
-    constexpr vector<T, A>::vector(const A& allocator) noexcept : allocator_{allocator}
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::vector(const A& allocator) noexcept : allocator_{allocator}
     {
 
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::vector(size_type size, const A& allocator) :
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::vector(size_type size, const A& allocator) :
         allocator_{allocator},
         size_{size},
         capacity_{size},
@@ -171,8 +224,8 @@ namespace my
         default_construct_range(data_, data_ + size_);
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::vector(size_type size, const T& value, const A& allocator) :
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::vector(size_type size, const T& value, const A& allocator) :
         allocator_{allocator},
         size_{size},
         capacity_{size},
@@ -181,26 +234,37 @@ namespace my
         copy_construct_range(data_, data_ + size_, value);
     }
 
-    template <typename T, typename A>
+    template <typename T, typename A, growth_policy GrowthPolicy>
     template <std::input_iterator I>
-    constexpr vector<T, A>::vector(I first, I last, const A& allocator) : vector(allocator)
-    {
-        for (auto i = first; i != last; ++i) {
-            push_back(*i);
+    constexpr vector<T, A, GrowthPolicy>::vector(I first, I last, const A& allocator) : vector(allocator)
+    {
+        // Destructor is called if this throws, because delegated constructor has already finished
+        if constexpr (std::forward_iterator<I>) {
+            // Size is known in advance, so all memory is allocated at once
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            reserve(count);
+            copy_range(first, last, data_);
+            size_ = count;
+        } else {
+            // Single pass iterators can only be read once, so there is no way to know size beforehand
+            for (auto i = first; i != last; ++i) {
+                emplace_back(*i);
+            }
         }
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::vector(std::initializer_list<T> init_list, const A& allocator) :
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::vector(std::initializer_list<T> init_list, const A& allocator) :
         vector(std::begin(init_list), std::end(init_list), allocator)
     {
 
     }
 
     // Rule of 5
-    template <typename T, typename A>
-    constexpr vector<T, A>::vector(const vector& other) :
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::vector(const vector& other) :
         allocator_{std::allocator_traits<A>::select_on_container_copy_construction(other.allocator_)},
+        growth_policy_{other.growth_policy_},
         size_{other.size_},
         capacity_{other.size_}, // vector does not have to copy capacity
         data_{std::allocator_traits<A>::allocate(allocator_, other.size_)}
@@ -209,16 +273,17 @@ namespace my
     }
 
     // Maybe reimplement for better performance?
-    template <typename T, typename A>
-    constexpr vector<T, A>& vector<T, A>::operator= (vector other)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>& vector<T, A, GrowthPolicy>::operator= (vector other)
     {
         this->swap(other);
         return *this;
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::vector(vector&& other) noexcept :
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::vector(vector&& other) noexcept :
         allocator_{std::move(other.allocator_)},
+        growth_policy_{std::move(other.growth_policy_)},
         size_{other.size_},
         capacity_{other.capacity_},
         data_{other.data_}
@@ -228,31 +293,69 @@ namespace my
         other.data_ = nullptr;
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>& vector<T, A>::operator= (vector&& other)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>& vector<T, A, GrowthPolicy>::operator= (vector&& other)
     {
-        this->swap(vector<T, A>(std::move(other)));
+        this->swap(vector<T, A, GrowthPolicy>(std::move(other)));
         return *this;
     }
 
-    template <typename T, typename A>
-    vector<T, A>::~vector()
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    vector<T, A, GrowthPolicy>::~vector()
     {
         destroy_range(data_, data_ + size_);
         std::allocator_traits<A>::deallocate(allocator_, data_, capacity_);
         // zeroing member variables is not required, so data_, size_ and capacity_ still contain garbage
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>& vector<T, A>::operator= (std::initializer_list<T> init_list)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>& vector<T, A, GrowthPolicy>::operator= (std::initializer_list<T> init_list)
     {
-        vector<T, A> temporary(init_list);
-        this->swap(temporary);
+        assign(init_list);
         return *this;
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::swap(vector& other) noexcept(
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    template <std::input_iterator I>
+    constexpr void vector<T, A, GrowthPolicy>::assign(I first, I last)
+    {
+        if constexpr (std::forward_iterator<I>) {
+            assign_counted(first, static_cast<size_type>(std::distance(first, last)));
+        } else {
+            clear();
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::assign(std::initializer_list<T> init_list)
+    {
+        assign(std::begin(init_list), std::end(init_list));
+    }
+
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    template <container_compatible_range<T> R>
+    constexpr void vector<T, A, GrowthPolicy>::assign_range(R&& range)
+    {
+        if constexpr (std::ranges::forward_range<R>) {
+            assign_counted(std::ranges::begin(range), static_cast<size_type>(std::ranges::distance(range)));
+        } else {
+            clear();
+            if constexpr (std::ranges::sized_range<R>) {
+                reserve(static_cast<size_type>(std::ranges::size(range)));
+            }
+
+            auto last = std::ranges::end(range);
+            for (auto i = std::ranges::begin(range); i != last; ++i) {
+                emplace_back(*i);
+            }
+        }
+    }
+
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::swap(vector& other) noexcept(
         std::allocator_traits<allocator_type>::propagate_on_container_swap::value || std::allocator_traits<allocator_type>::is_always_equal::value
     )
     {
@@ -261,56 +364,63 @@ namespace my
             swap(this->allocator_, other.allocator_);
         }
 
+        swap(this->growth_policy_, other.growth_policy_);
         swap(this->size_, other.size_);
         swap(this->capacity_, other.capacity_);
         swap(this->data_, other.data_);
     }
     
     // Propery access
-    template <typename T, typename A>
-    constexpr bool vector<T, A>::empty() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr bool vector<T, A, GrowthPolicy>::empty() const noexcept
     {
         return size_ == 0;
     }
     
-    template <typename T, typename A>
-    constexpr vector<T, A>::size_type vector<T, A>::size() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::size_type vector<T, A, GrowthPolicy>::size() const noexcept
     {
         return size_;
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::size_type vector<T, A>::max_size() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::size_type vector<T, A, GrowthPolicy>::max_size() const noexcept
     {
         return std::numeric_limits<difference_type>::max();
     }
     
-    template <typename T, typename A>
-    constexpr vector<T, A>::size_type vector<T, A>::capacity() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::size_type vector<T, A, GrowthPolicy>::capacity() const noexcept
     {
         return capacity_;
     }
 
-    template <typename T, typename A>
-    constexpr T* vector<T, A>::data() noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr T* vector<T, A, GrowthPolicy>::data() noexcept
     {
         return data_;
     }
 
-    template <typename T, typename A>
-    constexpr const T* vector<T, A>::data() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr const T* vector<T, A, GrowthPolicy>::data() const noexcept
     {
         return data_;
     }
 
     // Comparisons
-    template <typename T, typename A>
-    constexpr bool vector<T, A>::operator== (const vector& other) const
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr bool vector<T, A, GrowthPolicy>::operator== (const vector& other) const
     {
         if (size() != other.size()) {
             return false;
         }
 
+        if constexpr (my::is_bitwise_comparable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                return my::bitwise_equal(data_, other.data_, size_);
+            }
+        }
+
         for (size_type i = 0; i < size(); i += 1) {
             if ((*this)[i] != other[i]) {
                 return false;
@@ -320,10 +430,16 @@ namespace my
         return true;
     }
 
-    template <typename T, typename A>
-    constexpr auto vector<T, A>::operator<=> (const vector& other) const
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr auto vector<T, A, GrowthPolicy>::operator<=> (const vector& other) const
     {
         if constexpr (std::three_way_comparable<T>) {
+            if constexpr (my::is_bitwise_comparable_v<T>) {
+                if (!std::is_constant_evaluated()) {
+                    return my::bitwise_compare_three_way(data_, size_, other.data_, other.size_);
+                }
+            }
+
             for (size_type i = 0; i < std::min(size(), other.size()); i += 1) {
                 if (auto comparison_result = (*this)[i] <=> other[i]; comparison_result != 0) {
                     return comparison_result;
@@ -355,20 +471,20 @@ namespace my
     }
 
     // Element access
-    template <typename T, typename A>
-    constexpr vector<T, A>::reference vector<T, A>::operator[] (size_type index)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::reference vector<T, A, GrowthPolicy>::operator[] (size_type index)
     {
         return data_[index];
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_reference vector<T, A>::operator[] (size_type index) const
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_reference vector<T, A, GrowthPolicy>::operator[] (size_type index) const
     {
         return data_[index];
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::reference vector<T, A>::at(size_type index)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::reference vector<T, A, GrowthPolicy>::at(size_type index)
     {
         if (index >= size()) {
             throw std::out_of_range("Invalid element index");
@@ -377,8 +493,8 @@ namespace my
         return (*this)[index];
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_reference vector<T, A>::at(size_type index) const
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_reference vector<T, A, GrowthPolicy>::at(size_type index) const
     {
         if (index >= size()) {
             throw std::out_of_range("Invalid element index");
@@ -387,78 +503,81 @@ namespace my
         return (*this)[index];
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::reference vector<T, A>::front()
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::reference vector<T, A, GrowthPolicy>::front()
     {
         return (*this)[0];
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_reference vector<T, A>::front() const
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_reference vector<T, A, GrowthPolicy>::front() const
     {
         return (*this)[0];
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::reference vector<T, A>::back()
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::reference vector<T, A, GrowthPolicy>::back()
     {
         return (*this)[size() - 1];
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_reference vector<T, A>::back() const
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_reference vector<T, A, GrowthPolicy>::back() const
     {
         return (*this)[size() - 1];
     }
 
     // Adding/removing elements
-    template <typename T, typename A>
-    constexpr void vector<T, A>::push_back(const T& value)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::push_back(const T& value)
     {
         emplace_back(value);
     }  
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::push_back(T&& value)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::push_back(T&& value)
     {
         emplace_back(std::move(value));
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::pop_back()
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::pop_back()
     {
         size_ -= 1;
         std::allocator_traits<A>::destroy(allocator_, data_ + size_);
     }
 
-    template <typename T, typename A>
+    template <typename T, typename A, growth_policy GrowthPolicy>
     template <typename ... Args>
-    constexpr vector<T, A>::reference vector<T, A>::emplace_back(Args&& ... args)
+    constexpr vector<T, A, GrowthPolicy>::reference vector<T, A, GrowthPolicy>::emplace_back(Args&& ... args)
     {
         if (is_memory_filled()) {
-            grow();
+            // New element is constructed in new memory, because arguments can reference old elements
+            reallocate(calculate_new_capacity(size_ + 1), size_, 1, [&](pointer new_element) {
+                std::allocator_traits<A>::construct(allocator_, new_element, std::forward<Args>(args) ...);
+            });
+        } else {
+            std::allocator_traits<A>::construct(allocator_, data_ + size_, std::forward<Args>(args) ...);
+            size_ += 1;
         }
-        
-        std::allocator_traits<A>::construct(allocator_, data_ + size_, std::forward<Args>(args) ...);
-        size_ += 1;
 
         return back();
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::iterator vector<T, A>::insert(const_iterator pos, const T& value)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::insert(const_iterator pos, const T& value)
     {
         return emplace(pos, value);
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::iterator vector<T, A>::insert(const_iterator pos, T&& value)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::insert(const_iterator pos, T&& value)
     {
         return emplace(pos, std::move(value));
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::iterator vector<T, A>::insert(const_iterator pos, size_type count, const T& value)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::insert(const_iterator pos, size_type count, const T& value)
     {
         const auto insert_position = pos - cbegin();
 
@@ -469,23 +588,9 @@ namespace my
         const auto new_size = size_ + count;
 
         if (new_size > capacity_) {
-            std::size_t new_capacity = new_size; // TODO: Maybe max(new_size, calculate_new_capacity()) ??
-            T* new_data = std::allocator_traits<A>::allocate(allocator_, new_capacity);
-
-            // Move elements [begin, pos)
-            move_range(data_, data_ + insert_position, new_data);
-            // Move elements [pos, end)
-            // Elements are move constructed in new location, so this is ok
-            move_range_backwards(data_ + insert_position, data_ + size_, new_data + new_size);
-            copy_construct_range(new_data + insert_position, new_data + insert_position + count, value);
-
-            // Clear old memory
-            destroy_range(data_, data_ + size_);
-            std::allocator_traits<A>::deallocate(allocator_, data_, capacity_);
-
-            data_ = new_data;
-            capacity_ = new_capacity;
-            size_ = new_size;
+            reallocate(calculate_new_capacity(new_size), insert_position, count, [&](pointer gap) {
+                copy_construct_range(gap, gap + count, value);
+            });
         } else {
             // Move last count elements to uninitialized memory
             // Backwards because this way arguments are easier to understand
@@ -524,87 +629,56 @@ namespace my
         return iterator(data_ + insert_position);
     }
 
-    template <typename T, typename A>
-    template <std::random_access_iterator InputIt>
-    constexpr vector<T, A>::iterator vector<T, A>::insert(const_iterator pos, InputIt first, InputIt last)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    template <std::input_iterator InputIt>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::insert(const_iterator pos, InputIt first, InputIt last)
     {
-        const auto insert_position = pos - cbegin();
+        const auto insert_position = static_cast<size_type>(pos - cbegin());
 
-        if (first == last) {
-            return iterator(data_ + insert_position);
+        if constexpr (std::forward_iterator<InputIt>) {
+            return insert_counted(insert_position, first, static_cast<size_type>(std::distance(first, last)));
+        } else {
+            return insert_single_pass(insert_position, first, last);
         }
+    }
 
-        const auto count = last - first; // FIXME: Does not work for some types of iterators
-        const auto new_size = size_ + count;
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::insert(const_iterator pos, std::initializer_list<T> init_list)
+    {
+        return insert(pos, std::begin(init_list), std::end(init_list));
+    }
 
-        if (new_size > capacity_) {
-            std::size_t new_capacity = new_size;
-            T* new_data = std::allocator_traits<A>::allocate(allocator_, new_capacity);
-
-            // Move elements [begin, pos)
-            move_range(data_, data_ + insert_position, new_data);
-            // Move elements [pos, end)
-            // Elements are move constructed in new location, so this is ok
-            move_range_backwards(data_ + insert_position, data_ + size_, new_data + new_size);
-            // Copy data from input iterator range to new location
-            copy_range(first, last, new_data + insert_position);
-
-            // Clear old memory
-            destroy_range(data_, data_ + size_);
-            std::allocator_traits<A>::deallocate(allocator_, data_, capacity_);
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    template <container_compatible_range<T> R>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::insert_range(const_iterator pos, R&& range)
+    {
+        const auto insert_position = static_cast<size_type>(pos - cbegin());
 
-            data_ = new_data;
-            capacity_ = new_capacity;
-            size_ = new_size;
+        if constexpr (std::ranges::forward_range<R>) {
+            return insert_counted(insert_position, std::ranges::begin(range), static_cast<size_type>(std::ranges::distance(range)));
         } else {
-            // Move last count elements to uninitialized memory
-            // Backwards because this way arguments are easier to understand
-            // TODO: There should be better way than static_cast<difference_type>(count) everywhere
-            move_range_backwards(
-                data_ + size_ - std::min(cend() - pos, static_cast<difference_type>(count)),
-                data_ + size_,
-                data_ + size_ + count
-            );
-            // Move others to the end of array
-            // Assignment because destructors were not called for moved-out objects
-            // Backwards because input and output ranges can overlap
-            move_assign_range_backwards(
-                data_ + insert_position,
-                data_ + size_ - std::min(cend() - pos, static_cast<difference_type>(count)),
-                data_ + size_
-            );
-
-            // Some of new elements copy constructed in uninitialized memory
-            // Didn't work without explicit <InputIt, T*>
-            // Probably bacause it cannot deduce result type of first + std::min(cend() - pos, static_cast<difference_type>(count))
-            // Would by nice to restrict InputIt to concept that has operator+ with int
-            copy_range<InputIt, T*>(
-                first + std::min(cend() - pos, static_cast<difference_type>(count)),
-                last,
-                data_ + size_
-            );
-
-            // Some are copy assigned to moved-from objects in already occupied memory
-            copy_assign_range_to_range<InputIt, T*>(
-                first,
-                first + std::min(cend() - pos, static_cast<difference_type>(count)),
-                data_ + insert_position
-            );
+            if constexpr (std::ranges::sized_range<R>) {
+                // Can't be read twice, but size is still known, so at least allocate only once
+                // Growth policy is used like in insert_counted, so that repeated appends do not reallocate every time
+                const auto new_size = size_ + static_cast<size_type>(std::ranges::size(range));
+                if (new_size > capacity()) {
+                    reallocate(calculate_new_capacity(new_size));
+                }
+            }
 
-            size_ = new_size;
+            return insert_single_pass(insert_position, std::ranges::begin(range), std::ranges::end(range));
         }
-
-        return iterator(data_ + insert_position);
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::iterator vector<T, A>::insert(const_iterator pos, std::initializer_list<T> init_list)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    template <container_compatible_range<T> R>
+    constexpr void vector<T, A, GrowthPolicy>::append_range(R&& range)
     {
-        return insert(pos, std::begin(init_list), std::end(init_list));
+        insert_range(cend(), std::forward<R>(range));
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::iterator vector<T, A>::erase(const_iterator pos)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::erase(const_iterator pos)
     {
         if (empty()) {
             return end();
@@ -620,8 +694,8 @@ namespace my
         }
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::iterator vector<T, A>::erase(const_iterator first, const_iterator last)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::erase(const_iterator first, const_iterator last)
     {
         if (first == last) {
             return iterator(data_ + (last - cbegin()));
@@ -642,32 +716,18 @@ namespace my
         }
     }
 
-    template <typename T, typename A>
+    template <typename T, typename A, growth_policy GrowthPolicy>
     template <typename ... Args>
-    constexpr vector<T, A>::iterator vector<T, A>::emplace(const_iterator pos, Args&& ... args)
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::emplace(const_iterator pos, Args&& ... args)
     {
         const auto new_element_index = pos - cbegin();
         if (is_memory_filled()) {
-            std::size_t new_capacity = calculate_new_capacity();
-            T* new_data = std::allocator_traits<A>::allocate(allocator_, new_capacity);
-
-            // Move elements [begin, pos)
-            move_range(data_, data_ + new_element_index, new_data);
-            // Move elements [pos, end)
-            // Elements are move constructed in new location, so this is ok
-            move_range_backwards(data_ + new_element_index, data_ + size_, new_data + size_ + 1);
             // Construct value in correct position
-            std::allocator_traits<A>::construct(allocator_, new_data + new_element_index, std::forward<Args>(args) ...);
-
-            // Clear old memory
-            destroy_range(data_, data_ + size_);
-            std::allocator_traits<A>::deallocate(allocator_, data_, capacity_);
-
-            data_ = new_data;
-            capacity_ = new_capacity;
-            size_ = size_ + 1;
+            reallocate(calculate_new_capacity(size_ + 1), new_element_index, 1, [&](pointer new_element) {
+                std::allocator_traits<A>::construct(allocator_, new_element, std::forward<Args>(args) ...);
+            });
 
-            return iterator(new_data + new_element_index);
+            return iterator(data_ + new_element_index);
         } else {
             // Handle case without reallocation
             const auto elements_need_to_be_moved = cend() - pos;
@@ -689,29 +749,19 @@ namespace my
     }
 
     // Size/capacity modification
-    template <typename T, typename A>
-    constexpr void vector<T, A>::clear() noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::clear() noexcept
     {
         destroy_range(data_, data_ + size_);
         size_ = 0;
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::resize(size_type new_size)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::resize(size_type new_size)
     {
         if (new_size > size()) {
             if (new_size > capacity()) {
-                // Move data to new memory location
-                const std::size_t new_capacity = new_size;
-                T* new_data = std::allocator_traits<A>::allocate(allocator_, new_capacity);
-                move_range(data_, data_ + size_, new_data);
-
-                // Clear old memory
-                destroy_range(data_, data_ + size_);
-                std::allocator_traits<A>::deallocate(allocator_, data_, capacity_);
-
-                data_ = new_data;
-                capacity_ = new_capacity;
+                reallocate(calculate_new_capacity(new_size));
             }
 
             // Default construct new elements
@@ -723,23 +773,12 @@ namespace my
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::resize(size_type new_size, const T& value)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::resize(size_type new_size, const T& value)
     {
         if (new_size > size()) {
             if (new_size > capacity()) {
-                // Move data to new memory location
-                const std::size_t new_capacity = new_size;
-
-                T* new_data = std::allocator_traits<A>::allocate(allocator_, new_capacity);
-                move_range(data_, data_ + size_, new_data);
-
-                // Clear old memory
-                destroy_range(data_, data_ + size_);
-                std::allocator_traits<A>::deallocate(allocator_, data_, capacity_);
-
-                data_ = new_data;
-                capacity_ = new_capacity;
+                reallocate(calculate_new_capacity(new_size));
             }
 
             // Copy construct new elements
@@ -751,194 +790,373 @@ namespace my
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::reserve(size_type new_capacity)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::resize_for_overwrite(size_type new_size)
     {
-        if (new_capacity > capacity()) {
-            // Move data to new memory location
-            T* new_data = std::allocator_traits<A>::allocate(allocator_, new_capacity);
-            move_range(data_, data_ + size_, new_data);
+        if (new_size > size()) {
+            if (new_size > capacity()) {
+                reallocate(calculate_new_capacity(new_size));
+            }
 
-            // Clear old memory
-            destroy_range(data_, data_ + size_);
-            std::allocator_traits<A>::deallocate(allocator_, data_, capacity_);
+            default_initialize_range(data_ + size_, data_ + new_size);
+            size_ = new_size;
+        } else if (new_size < size()) {
+            destroy_range(data_ + new_size, data_ + size_);
+            size_ = new_size;
+        }
+    }
 
-            data_ = new_data;
-            capacity_ = new_capacity;
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::reserve(size_type new_capacity)
+    {
+        if (new_capacity > capacity()) {
+            reallocate(new_capacity);
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::shrink_to_fit()
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::shrink_to_fit()
     {
         if (size() < capacity()) {
-            // Move data to new memory location
-            const std::size_t new_capacity = size();
-            T* new_data = std::allocator_traits<A>::allocate(allocator_, new_capacity);
-            move_range(data_, data_ + size_, new_data);
-
-            // Clear old memory
-            destroy_range(data_, data_ + size_);
-            std::allocator_traits<A>::deallocate(allocator_, data_, capacity_);
-
-            data_ = new_data;
-            capacity_ = new_capacity;
+            reallocate(size());
         }
     }
 
     // Iterators
-    template <typename T, typename A>
-    constexpr vector<T, A>::iterator vector<T, A>::begin() noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::begin() noexcept
     {
         return iterator(data());
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::iterator vector<T, A>::end() noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::end() noexcept
     {
         return iterator(data() + size());
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_iterator vector<T, A>::begin() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_iterator vector<T, A, GrowthPolicy>::begin() const noexcept
     {
         return const_iterator(data_); // data() will not work because it returns const T*
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_iterator vector<T, A>::end() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_iterator vector<T, A, GrowthPolicy>::end() const noexcept
     {
         return const_iterator(data_ + size_);
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_iterator vector<T, A>::cbegin() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_iterator vector<T, A, GrowthPolicy>::cbegin() const noexcept
     {
         return begin();
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_iterator vector<T, A>::cend() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_iterator vector<T, A, GrowthPolicy>::cend() const noexcept
     {
         return end();
     }
 
     // Reverse iterators
-    template <typename T, typename A>
-    constexpr vector<T, A>::reverse_iterator vector<T, A>::rbegin() noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::reverse_iterator vector<T, A, GrowthPolicy>::rbegin() noexcept
     {
         return reverse_iterator(end());
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::reverse_iterator vector<T, A>::rend() noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::reverse_iterator vector<T, A, GrowthPolicy>::rend() noexcept
     {
         return reverse_iterator(begin());
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_reverse_iterator vector<T, A>::rbegin() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_reverse_iterator vector<T, A, GrowthPolicy>::rbegin() const noexcept
     {
         return const_reverse_iterator(end());
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_reverse_iterator vector<T, A>::rend() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_reverse_iterator vector<T, A, GrowthPolicy>::rend() const noexcept
     {
         return const_reverse_iterator(begin());
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_reverse_iterator vector<T, A>::crbegin() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_reverse_iterator vector<T, A, GrowthPolicy>::crbegin() const noexcept
     {
         return const_reverse_iterator(end());
     }
 
-    template <typename T, typename A>
-    constexpr vector<T, A>::const_reverse_iterator vector<T, A>::crend() const noexcept
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr vector<T, A, GrowthPolicy>::const_reverse_iterator vector<T, A, GrowthPolicy>::crend() const noexcept
     {
         return const_reverse_iterator(begin());
     }
 
     // Private member functions
-    template <typename T, typename A>
-    bool vector<T, A>::is_memory_filled() const
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    bool vector<T, A, GrowthPolicy>::is_memory_filled() const
     {
         return size() == capacity();
     }
 
-    template <typename T, typename A>
-    vector<T, A>::size_type vector<T, A>::calculate_new_capacity() const
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    vector<T, A, GrowthPolicy>::size_type vector<T, A, GrowthPolicy>::calculate_new_capacity(size_type required_capacity) const
     {
-        constexpr std::size_t growth_factor = 2;
-
-        if (capacity_ == 0) {
-            return 1;
-        } else {
-            return capacity_ * growth_factor;
-        }
+        const size_type new_capacity = growth_policy_(capacity_, required_capacity, sizeof(T));
+        assert((new_capacity >= required_capacity) && "Growth policy must return capacity that fits all required elements");
+        return new_capacity;
     }
 
-    template <typename T, typename A>
-    void vector<T, A>::grow()
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::reallocate(size_type new_capacity)
     {
-        std::size_t new_capacity = calculate_new_capacity();
+        reallocate(new_capacity, size_, 0, [](pointer) { });
+    }
 
-        // Move data to new memory location
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    template <typename ConstructGap>
+    constexpr void vector<T, A, GrowthPolicy>::reallocate(size_type new_capacity, size_type gap_position, size_type gap_size, ConstructGap construct_gap)
+    {
         T* new_data = std::allocator_traits<A>::allocate(allocator_, new_capacity);
-        move_range(data_, data_ + size_, new_data);
+        pointer gap_begin = new_data + gap_position;
+        pointer gap_end = gap_begin + gap_size;
+
+        try {
+            construct_gap(gap_begin);
+        } catch (...) {
+            std::allocator_traits<A>::deallocate(allocator_, new_data, new_capacity);
+            throw;
+        }
+
+        if (is_bitwise_relocatable && !std::is_constant_evaluated()) {
+            // Nothing here can throw
+            relocate_range_bitwise(data_, data_ + gap_position, new_data);
+            relocate_range_bitwise(data_ + gap_position, data_ + size_, gap_end);
+        } else {
+            // Old elements are moved only if it can't throw, otherwise they are copied
+            // So if exception is thrown old elements are still intact
+            try {
+                move_if_noexcept_range(data_, data_ + gap_position, new_data);
+                try {
+                    move_if_noexcept_range(data_ + gap_position, data_ + size_, gap_end);
+                } catch (...) {
+                    destroy_range(new_data, gap_begin);
+                    throw;
+                }
+            } catch (...) {
+                destroy_range(gap_begin, gap_end);
+                std::allocator_traits<A>::deallocate(allocator_, new_data, new_capacity);
+                throw;
+            }
+
+            // Everything is in new memory, so it is safe to destroy old elements
+            destroy_range(data_, data_ + size_);
+        }
 
-        // Clear old memory
-        destroy_range(data_, data_ + size_);
         std::allocator_traits<A>::deallocate(allocator_, data_, capacity_);
 
         data_ = new_data;
         capacity_ = new_capacity;
+        size_ += gap_size;
+    }
+
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    template <std::forward_iterator I>
+    constexpr void vector<T, A, GrowthPolicy>::assign_counted(I first, size_type count)
+    {
+        const I last = std::next(first, count);
+
+        if (count > capacity()) {
+            // Old elements are not needed, so there is no point in moving them to the new memory
+            T* new_data = std::allocator_traits<A>::allocate(allocator_, count);
+            try {
+                copy_range(first, last, new_data);
+            } catch (...) {
+                std::allocator_traits<A>::deallocate(allocator_, new_data, count);
+                throw;
+            }
+
+            destroy_range(data_, data_ + size_);
+            std::allocator_traits<A>::deallocate(allocator_, data_, capacity_);
+
+            data_ = new_data;
+            capacity_ = count;
+        } else if (count <= size_) {
+            // Assign new values to existing elements and destroy the rest
+            copy_assign_range_to_range(first, last, data_);
+            destroy_range(data_ + count, data_ + size_);
+        } else {
+            // Assign new values to existing elements and construct the rest in uninitialized memory
+            const I middle = std::next(first, size_);
+            copy_assign_range_to_range(first, middle, data_);
+            copy_range(middle, last, data_ + size_);
+        }
+
+        size_ = count;
+    }
+
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    template <std::forward_iterator I>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::insert_counted(size_type insert_position, I first, size_type count)
+    {
+        if (count == 0) {
+            return iterator(data_ + insert_position);
+        }
+
+        const I last = std::next(first, count);
+        const auto new_size = size_ + count;
+
+        if (new_size > capacity_) {
+            reallocate(calculate_new_capacity(new_size), insert_position, count, [&](pointer gap) {
+                // Copy data from input iterator range to new location
+                copy_range(first, last, gap);
+            });
+        } else {
+            // Number of old elements that end up in uninitialized memory
+            // Equal to number of new elements that are assigned to moved-from objects
+            const auto elements_after = size_ - insert_position;
+            const auto overlap = std::min(elements_after, count);
+
+            // Move last overlap elements to uninitialized memory
+            // Backwards because this way arguments are easier to understand
+            move_range_backwards(data_ + size_ - overlap, data_ + size_, data_ + size_ + count);
+            // Move others to the end of array
+            // Assignment because destructors were not called for moved-out objects
+            // Backwards because input and output ranges can overlap
+            move_assign_range_backwards(data_ + insert_position, data_ + size_ - overlap, data_ + size_);
+
+            // Some of new elements copy constructed in uninitialized memory
+            const I middle = std::next(first, overlap);
+            copy_range(middle, last, data_ + size_);
+
+            // Some are copy assigned to moved-from objects in already occupied memory
+            copy_assign_range_to_range(first, middle, data_ + insert_position);
+
+            size_ = new_size;
+        }
+
+        return iterator(data_ + insert_position);
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::destroy_range(pointer begin, pointer end)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    template <std::input_iterator I, std::sentinel_for<I> S>
+    constexpr vector<T, A, GrowthPolicy>::iterator vector<T, A, GrowthPolicy>::insert_single_pass(size_type insert_position, I first, S last)
+    {
+        const auto old_size = size_;
+
+        try {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        } catch (...) {
+            // Remove what was appended, so old elements stay in their places
+            destroy_range(data_ + old_size, data_ + size_);
+            size_ = old_size;
+            throw;
+        }
+
+        std::rotate(data_ + insert_position, data_ + old_size, data_ + size_);
+
+        return iterator(data_ + insert_position);
+    }
+
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::destroy_range(pointer begin, pointer end)
     {
         for (; begin != end; ++begin) {
             std::allocator_traits<A>::destroy(allocator_, begin);
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::default_construct_range(pointer begin, pointer end)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::default_construct_range(pointer begin, pointer end)
     {
-        for (; begin != end; ++begin) {
-            std::allocator_traits<A>::construct(allocator_, begin);
+        // If construction throws, already constructed elements are destroyed
+        const pointer first = begin;
+
+        try {
+            for (; begin != end; ++begin) {
+                std::allocator_traits<A>::construct(allocator_, begin);
+            }
+        } catch (...) {
+            destroy_range(first, begin);
+            throw;
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::copy_construct_range(pointer begin, pointer end, const T& value)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::default_initialize_range(pointer begin, pointer end)
     {
-        for (; begin != end; ++begin) {
-            std::allocator_traits<A>::construct(allocator_, begin, value);
+        // Reading uninitialized memory is not allowed in constant evaluation, so elements are value-initialized there
+        if (is_default_initializable && !std::is_constant_evaluated()) {
+            // Does nothing for trivially default constructible types
+            // Destroys already constructed elements if exception is thrown
+            std::uninitialized_default_construct(begin, end);
+        } else {
+            default_construct_range(begin, end);
         }
     }
 
-    template <typename T, typename A>
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::copy_construct_range(pointer begin, pointer end, const T& value)
+    {
+        const pointer first = begin;
+
+        try {
+            for (; begin != end; ++begin) {
+                std::allocator_traits<A>::construct(allocator_, begin, value);
+            }
+        } catch (...) {
+            destroy_range(first, begin);
+            throw;
+        }
+    }
+
+    template <typename T, typename A, growth_policy GrowthPolicy>
     template <typename InputIt, typename OutputIt>
-    constexpr void vector<T, A>::copy_range(InputIt source_begin, InputIt source_end, OutputIt destination_begin)
+    constexpr void vector<T, A, GrowthPolicy>::copy_range(InputIt source_begin, InputIt source_end, OutputIt destination_begin)
     {
-        for (; source_begin != source_end; ++source_begin, ++destination_begin) {
-            std::allocator_traits<A>::construct(allocator_, std::to_address(destination_begin), *source_begin);
+        const OutputIt destination_first = destination_begin;
+
+        try {
+            for (; source_begin != source_end; ++source_begin, ++destination_begin) {
+                std::allocator_traits<A>::construct(allocator_, std::to_address(destination_begin), *source_begin);
+            }
+        } catch (...) {
+            destroy_range(std::to_address(destination_first), std::to_address(destination_begin));
+            throw;
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::move_range(pointer source_begin, pointer source_end, pointer destination_begin)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::move_range(pointer source_begin, pointer source_end, pointer destination_begin)
     {
         for (; source_begin != source_end; ++source_begin, ++destination_begin) {
             std::allocator_traits<A>::construct(allocator_, destination_begin, std::move(*source_begin));
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::copy_range_backwards(pointer source_begin, pointer source_end, pointer destination_end)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::move_if_noexcept_range(pointer source_begin, pointer source_end, pointer destination_begin)
+    {
+        const pointer destination_first = destination_begin;
+
+        try {
+            for (; source_begin != source_end; ++source_begin, ++destination_begin) {
+                std::allocator_traits<A>::construct(allocator_, destination_begin, std::move_if_noexcept(*source_begin));
+            }
+        } catch (...) {
+            destroy_range(destination_first, destination_begin);
+            throw;
+        }
+    }
+
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::copy_range_backwards(pointer source_begin, pointer source_end, pointer destination_end)
     {
         while (source_end != source_begin) {
             --source_end;
@@ -948,8 +1166,8 @@ namespace my
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::move_range_backwards(pointer source_begin, pointer source_end, pointer destination_end)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::move_range_backwards(pointer source_begin, pointer source_end, pointer destination_end)
     {
         while (source_end != source_begin) {
             --source_end;
@@ -959,25 +1177,25 @@ namespace my
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::copy_assign_range(pointer begin, pointer end, const T& value)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::copy_assign_range(pointer begin, pointer end, const T& value)
     {
         for (; begin != end; ++begin) {
             *begin = value;
         }
     }
 
-    template <typename T, typename A>
+    template <typename T, typename A, growth_policy GrowthPolicy>
     template <typename InputIt, typename OutputIt>
-    constexpr void vector<T, A>::copy_assign_range_to_range(InputIt source_begin, InputIt source_end, OutputIt destination_begin)
+    constexpr void vector<T, A, GrowthPolicy>::copy_assign_range_to_range(InputIt source_begin, InputIt source_end, OutputIt destination_begin)
     {
         for (; source_begin != source_end; ++source_begin, ++destination_begin) {
             *destination_begin = *source_begin;
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::move_assign_range_backwards(pointer source_begin, pointer source_end, pointer destination_end)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::move_assign_range_backwards(pointer source_begin, pointer source_end, pointer destination_end)
     {
         while (source_end != source_begin) {
             --source_end;
@@ -987,13 +1205,29 @@ namespace my
         }
     }
 
-    template <typename T, typename A>
-    constexpr void vector<T, A>::move_assign_range(pointer source_begin, pointer source_end, pointer destination_begin)
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::move_assign_range(pointer source_begin, pointer source_end, pointer destination_begin)
     {
         for (; source_begin != source_end; ++source_begin, ++destination_begin) {
             *destination_begin = std::move(*source_begin);
         }
     }
+
+    template <typename T, typename A, growth_policy GrowthPolicy>
+    constexpr void vector<T, A, GrowthPolicy>::relocate_range_bitwise(pointer source_begin, pointer source_end, pointer destination_begin)
+    {
+        // Empty vector can have nullptr data and memcpy with nullptr is undefined even for 0 bytes
+        if (source_begin != source_end) {
+            std::memcpy(
+                static_cast<void*>(destination_begin),
+                static_cast<const void*>(source_begin),
+                (source_end - source_begin) * sizeof(T)
+            );
+        }
+    }
 }
 
+// Packed specialization for bool, it must be visible everywhere vector is
+#include "vector_bool.hpp"
+
 #endif /* VECTOR_HPP */
@@ -0,0 +1,1012 @@
+#ifndef TOY_SDL_VECTOR_BOOL_HPP
+#define TOY_SDL_VECTOR_BOOL_HPP
+
+#include "vector.hpp"
+#include "vector_bool_iterator.hpp"
+
+#include <stdexcept>
+#include <cassert>
+#include <memory>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <compare>
+
+namespace my
+{
+    // Stores bools packed into 64-bit words, so it needs 8 times less memory than one byte per element
+    // Operations on the whole vector (count, find, set_range, bitwise operators) work with full words at a time
+    // Bits past size() inside of allocated words are always zero, so whole words can be compared and counted
+    template <typename A, growth_policy GrowthPolicy>
+    class vector<bool, A, GrowthPolicy>
+    {
+    public:
+        using word_type = std::uint64_t;
+
+        // Member types
+        using value_type = bool;
+
+        using reference = bit_reference<word_type>;
+        using const_reference = bool;
+
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        using iterator = bit_iterator<word_type, false>;
+        using const_iterator = bit_iterator<word_type, true>;
+
+        using reverse_iterator = my::reverse_iterator<iterator>;
+        using const_reverse_iterator = my::reverse_iterator<const_iterator>;
+
+        using allocator_type = A;
+        using growth_policy_type = GrowthPolicy;
+
+        constexpr static size_type bits_per_word = std::numeric_limits<word_type>::digits;
+        // Returned by find_first and find_next when there are no set bits
+        constexpr static size_type npos = std::numeric_limits<size_type>::max();
+
+        // Constructors
+        constexpr vector() noexcept(noexcept(A()));
+        constexpr explicit vector(const A& allocator) noexcept;
+        constexpr vector(size_type size, const A& allocator = A());
+        constexpr explicit vector(size_type size, bool value, const A& allocator = A());
+        template <std::input_iterator I>
+        constexpr vector(I first, I last, const A& allocator = A());
+        constexpr vector(std::initializer_list<bool> init_list, const A& allocator = A());
+
+        // Rule of 5
+        constexpr vector(const vector& other);
+        constexpr vector& operator= (const vector& other);
+        constexpr vector(vector&& other) noexcept;
+        constexpr vector& operator= (vector&& other) noexcept;
+        constexpr ~vector();
+
+        // Other
+        constexpr vector& operator= (std::initializer_list<bool> init_list);
+        template <std::input_iterator I>
+        constexpr void assign(I first, I last);
+        constexpr void assign(std::initializer_list<bool> init_list);
+        template <container_compatible_range<bool> R>
+        constexpr void assign_range(R&& range);
+        constexpr void swap(vector& other) noexcept(
+            std::allocator_traits<A>::propagate_on_container_swap::value || std::allocator_traits<A>::is_always_equal::value
+        );
+
+        // Propery access
+        constexpr bool empty() const noexcept;
+        constexpr size_type size() const noexcept;
+        constexpr size_type max_size() const noexcept;
+        constexpr size_type capacity() const noexcept;
+
+        // Comparison
+        constexpr bool operator== (const vector& other) const;
+        constexpr std::strong_ordering operator<=> (const vector& other) const;
+
+        // Element access
+        constexpr reference operator[] (size_type index);
+        constexpr const_reference operator[] (size_type index) const;
+        constexpr reference at(size_type index);
+        constexpr const_reference at(size_type index) const;
+        constexpr reference front();
+        constexpr const_reference front() const;
+        constexpr reference back();
+        constexpr const_reference back() const;
+
+        // Bit operations
+        // Number of set bits
+        constexpr size_type count() const noexcept;
+        constexpr bool all() const noexcept;
+        constexpr bool any() const noexcept;
+        constexpr bool none() const noexcept;
+        // Index of the first set bit, or npos
+        constexpr size_type find_first() const noexcept;
+        // Index of the first set bit after position, or npos
+        constexpr size_type find_next(size_type position) const noexcept;
+        // Set or reset all bits in range [first, last)
+        constexpr void set_range(size_type first, size_type last);
+        constexpr void reset_range(size_type first, size_type last);
+        constexpr void set() noexcept;
+        constexpr void reset() noexcept;
+        constexpr void flip() noexcept;
+
+        // Bitwise operators, both vectors must have the same size
+        constexpr vector& operator&= (const vector& other);
+        constexpr vector& operator|= (const vector& other);
+        constexpr vector& operator^= (const vector& other);
+        constexpr vector operator~ () const;
+
+        // Adding/removing elements
+        constexpr void push_back(bool value);
+        constexpr void pop_back();
+        template <typename ... Args>
+        constexpr reference emplace_back(Args&& ... args);
+        constexpr iterator insert(const_iterator pos, bool value);
+        constexpr iterator insert(const_iterator pos, size_type count, bool value);
+        template <std::input_iterator InputIt>
+        constexpr iterator insert(const_iterator pos, InputIt first, InputIt last);
+        constexpr iterator insert(const_iterator pos, std::initializer_list<bool> init_list);
+        template <container_compatible_range<bool> R>
+        constexpr iterator insert_range(const_iterator pos, R&& range);
+        template <container_compatible_range<bool> R>
+        constexpr void append_range(R&& range);
+        constexpr iterator erase(const_iterator pos);
+        constexpr iterator erase(const_iterator first, const_iterator last);
+        template <typename ... Args>
+        constexpr iterator emplace(const_iterator pos, Args&& ... args);
+
+        // Size/capacity modification
+        constexpr void clear() noexcept;
+        constexpr void resize(size_type new_size, bool value = false);
+        constexpr void reserve(size_type new_capacity);
+        constexpr void shrink_to_fit();
+
+        // Iterators
+        constexpr iterator begin() noexcept;
+        constexpr iterator end() noexcept;
+        constexpr const_iterator begin() const noexcept;
+        constexpr const_iterator end() const noexcept;
+        constexpr const_iterator cbegin() const noexcept;
+        constexpr const_iterator cend() const noexcept;
+
+        // Reverse iterators
+        constexpr reverse_iterator rbegin() noexcept;
+        constexpr reverse_iterator rend() noexcept;
+        constexpr const_reverse_iterator rbegin() const noexcept;
+        constexpr const_reverse_iterator rend() const noexcept;
+        constexpr const_reverse_iterator crbegin() const noexcept;
+        constexpr const_reverse_iterator crend() const noexcept;
+
+    private:
+        using word_allocator_type = typename std::allocator_traits<A>::template rebind_alloc<word_type>;
+        using word_allocator_traits = std::allocator_traits<word_allocator_type>;
+
+        constexpr static size_type calculate_words_count(size_type bits_count);
+        constexpr size_type used_words_count() const;
+        // Mask with count lowest bits set, count must be in range [1, bits_per_word]
+        constexpr static word_type low_bits_mask(size_type count);
+
+        // Moves words to new memory, words past the used ones are zeroed
+        constexpr void reallocate(size_type new_words_capacity);
+        // Makes sure that required_size bits fit, capacity grows according to growth policy
+        constexpr void grow_to_fit(size_type required_size);
+
+        // Read or write count bits (at most bits_per_word) starting from index, bits can span two words
+        constexpr word_type read_bits(size_type index, size_type count) const;
+        constexpr void write_bits(size_type index, size_type count, word_type bits);
+        // Same as memmove, but for bits, ranges can overlap
+        constexpr void move_bits(size_type source, size_type destination, size_type count);
+        constexpr void fill_bits(size_type first, size_type last, bool value);
+
+        // Moves bits [position, size) count positions forward, bits in the gap are left unspecified
+        constexpr void open_gap(size_type position, size_type count);
+        template <std::forward_iterator I>
+        constexpr iterator insert_counted(size_type position, I first, size_type count);
+        // Zeroes bits past size in the last used word after operation that could have set them
+        constexpr void clear_unused_bits();
+
+        word_allocator_type allocator_ { };
+        [[no_unique_address]] GrowthPolicy growth_policy_ { };
+        size_type size_ { 0 }; // In bits
+        size_type words_capacity_ { 0 };
+        word_type* data_ { nullptr };
+    };
+
+    // Constructors
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::vector() noexcept(noexcept(A()))
+    {
+
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::vector(const A& allocator) noexcept : allocator_(allocator)
+    {
+
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::vector(size_type size, const A& allocator) :
+        vector(size, false, allocator)
+    {
+
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::vector(size_type size, bool value, const A& allocator) : vector(allocator)
+    {
+        resize(size, value);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    template <std::input_iterator I>
+    constexpr vector<bool, A, GrowthPolicy>::vector(I first, I last, const A& allocator) : vector(allocator)
+    {
+        insert(cend(), first, last);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::vector(std::initializer_list<bool> init_list, const A& allocator) :
+        vector(std::begin(init_list), std::end(init_list), allocator)
+    {
+
+    }
+
+    // Rule of 5
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::vector(const vector& other) :
+        allocator_{word_allocator_traits::select_on_container_copy_construction(other.allocator_)},
+        growth_policy_{other.growth_policy_}
+    {
+        reallocate(other.used_words_count());
+        std::copy(other.data_, other.data_ + other.used_words_count(), data_);
+        size_ = other.size_;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>& vector<bool, A, GrowthPolicy>::operator= (const vector& other)
+    {
+        if (this != &other) {
+            vector copy(other);
+            swap(copy);
+        }
+
+        return *this;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::vector(vector&& other) noexcept :
+        allocator_{std::move(other.allocator_)},
+        growth_policy_{std::move(other.growth_policy_)},
+        size_{other.size_},
+        words_capacity_{other.words_capacity_},
+        data_{other.data_}
+    {
+        other.size_ = 0;
+        other.words_capacity_ = 0;
+        other.data_ = nullptr;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>& vector<bool, A, GrowthPolicy>::operator= (vector&& other) noexcept
+    {
+        vector moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::~vector()
+    {
+        if (data_ != nullptr) {
+            word_allocator_traits::deallocate(allocator_, data_, words_capacity_);
+        }
+    }
+
+    // Other
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>& vector<bool, A, GrowthPolicy>::operator= (std::initializer_list<bool> init_list)
+    {
+        assign(init_list);
+        return *this;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    template <std::input_iterator I>
+    constexpr void vector<bool, A, GrowthPolicy>::assign(I first, I last)
+    {
+        clear();
+        insert(cend(), first, last);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::assign(std::initializer_list<bool> init_list)
+    {
+        assign(std::begin(init_list), std::end(init_list));
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    template <container_compatible_range<bool> R>
+    constexpr void vector<bool, A, GrowthPolicy>::assign_range(R&& range)
+    {
+        clear();
+        append_range(std::forward<R>(range));
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::swap(vector& other) noexcept(
+        std::allocator_traits<A>::propagate_on_container_swap::value || std::allocator_traits<A>::is_always_equal::value
+    )
+    {
+        using std::swap;
+        if (std::allocator_traits<A>::propagate_on_container_swap::value) {
+            swap(this->allocator_, other.allocator_);
+        }
+
+        swap(this->growth_policy_, other.growth_policy_);
+        swap(this->size_, other.size_);
+        swap(this->words_capacity_, other.words_capacity_);
+        swap(this->data_, other.data_);
+    }
+
+    // Propery access
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr bool vector<bool, A, GrowthPolicy>::empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::size_type vector<bool, A, GrowthPolicy>::size() const noexcept
+    {
+        return size_;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::size_type vector<bool, A, GrowthPolicy>::max_size() const noexcept
+    {
+        return std::numeric_limits<difference_type>::max();
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::size_type vector<bool, A, GrowthPolicy>::capacity() const noexcept
+    {
+        return words_capacity_ * bits_per_word;
+    }
+
+    // Comparisons
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr bool vector<bool, A, GrowthPolicy>::operator== (const vector& other) const
+    {
+        // Unused bits are zero, so whole words can be compared
+        return size_ == other.size_ && std::equal(data_, data_ + used_words_count(), other.data_);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr std::strong_ordering vector<bool, A, GrowthPolicy>::operator<=> (const vector& other) const
+    {
+        // Lowest differing bit of the first differing word decides the order
+        const auto common_size = std::min(size_, other.size_);
+        const auto common_words_count = calculate_words_count(common_size);
+
+        for (size_type i = 0; i < common_words_count; ++i) {
+            auto difference = data_[i] ^ other.data_[i];
+            if (i == common_words_count - 1 && common_size % bits_per_word != 0) {
+                difference &= low_bits_mask(common_size % bits_per_word);
+            }
+
+            if (difference != 0) {
+                const auto bit = std::countr_zero(difference);
+                return ((data_[i] >> bit) & 1) <=> ((other.data_[i] >> bit) & 1);
+            }
+        }
+
+        return size_ <=> other.size_;
+    }
+
+    // Element access
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::reference vector<bool, A, GrowthPolicy>::operator[] (size_type index)
+    {
+        return reference(data_ + index / bits_per_word, word_type { 1 } << (index % bits_per_word));
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_reference vector<bool, A, GrowthPolicy>::operator[] (size_type index) const
+    {
+        return (data_[index / bits_per_word] >> (index % bits_per_word)) & 1;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::reference vector<bool, A, GrowthPolicy>::at(size_type index)
+    {
+        if (index >= size()) {
+            throw std::out_of_range("Invalid element index");
+        }
+
+        return (*this)[index];
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_reference vector<bool, A, GrowthPolicy>::at(size_type index) const
+    {
+        if (index >= size()) {
+            throw std::out_of_range("Invalid element index");
+        }
+
+        return (*this)[index];
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::reference vector<bool, A, GrowthPolicy>::front()
+    {
+        return (*this)[0];
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_reference vector<bool, A, GrowthPolicy>::front() const
+    {
+        return (*this)[0];
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::reference vector<bool, A, GrowthPolicy>::back()
+    {
+        return (*this)[size_ - 1];
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_reference vector<bool, A, GrowthPolicy>::back() const
+    {
+        return (*this)[size_ - 1];
+    }
+
+    // Bit operations
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::size_type vector<bool, A, GrowthPolicy>::count() const noexcept
+    {
+        size_type result = 0;
+        for (size_type i = 0; i < used_words_count(); ++i) {
+            result += static_cast<size_type>(std::popcount(data_[i]));
+        }
+
+        return result;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr bool vector<bool, A, GrowthPolicy>::all() const noexcept
+    {
+        return count() == size_;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr bool vector<bool, A, GrowthPolicy>::any() const noexcept
+    {
+        return find_first() != npos;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr bool vector<bool, A, GrowthPolicy>::none() const noexcept
+    {
+        return !any();
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::size_type vector<bool, A, GrowthPolicy>::find_first() const noexcept
+    {
+        for (size_type i = 0; i < used_words_count(); ++i) {
+            if (data_[i] != 0) {
+                return i * bits_per_word + static_cast<size_type>(std::countr_zero(data_[i]));
+            }
+        }
+
+        return npos;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::size_type vector<bool, A, GrowthPolicy>::find_next(size_type position) const noexcept
+    {
+        const auto first = position + 1;
+        if (position == npos || first >= size_) {
+            return npos;
+        }
+
+        // Bits before first are masked out in the first word, after that whole words are checked
+        auto word_index = first / bits_per_word;
+        auto word = data_[word_index] & (~word_type { 0 } << (first % bits_per_word));
+        while (word == 0) {
+            word_index += 1;
+            if (word_index == used_words_count()) {
+                return npos;
+            }
+
+            word = data_[word_index];
+        }
+
+        return word_index * bits_per_word + static_cast<size_type>(std::countr_zero(word));
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::set_range(size_type first, size_type last)
+    {
+        assert((first <= last && last <= size_) && "Invalid range");
+        fill_bits(first, last, true);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::reset_range(size_type first, size_type last)
+    {
+        assert((first <= last && last <= size_) && "Invalid range");
+        fill_bits(first, last, false);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::set() noexcept
+    {
+        std::fill(data_, data_ + used_words_count(), ~word_type { 0 });
+        clear_unused_bits();
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::reset() noexcept
+    {
+        std::fill(data_, data_ + used_words_count(), word_type { 0 });
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::flip() noexcept
+    {
+        for (size_type i = 0; i < used_words_count(); ++i) {
+            data_[i] = ~data_[i];
+        }
+
+        clear_unused_bits();
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>& vector<bool, A, GrowthPolicy>::operator&= (const vector& other)
+    {
+        assert((size_ == other.size_) && "Vectors must have the same size");
+        for (size_type i = 0; i < used_words_count(); ++i) {
+            data_[i] &= other.data_[i];
+        }
+
+        return *this;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>& vector<bool, A, GrowthPolicy>::operator|= (const vector& other)
+    {
+        assert((size_ == other.size_) && "Vectors must have the same size");
+        for (size_type i = 0; i < used_words_count(); ++i) {
+            data_[i] |= other.data_[i];
+        }
+
+        return *this;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>& vector<bool, A, GrowthPolicy>::operator^= (const vector& other)
+    {
+        assert((size_ == other.size_) && "Vectors must have the same size");
+        for (size_type i = 0; i < used_words_count(); ++i) {
+            data_[i] ^= other.data_[i];
+        }
+
+        return *this;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy> vector<bool, A, GrowthPolicy>::operator~ () const
+    {
+        auto result = *this;
+        result.flip();
+        return result;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy> operator& (vector<bool, A, GrowthPolicy> a, const vector<bool, A, GrowthPolicy>& b)
+    {
+        a &= b;
+        return a;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy> operator| (vector<bool, A, GrowthPolicy> a, const vector<bool, A, GrowthPolicy>& b)
+    {
+        a |= b;
+        return a;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy> operator^ (vector<bool, A, GrowthPolicy> a, const vector<bool, A, GrowthPolicy>& b)
+    {
+        a ^= b;
+        return a;
+    }
+
+    // Adding/removing elements
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::push_back(bool value)
+    {
+        grow_to_fit(size_ + 1);
+        size_ += 1;
+        if (value) {
+            back() = true;
+        }
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::pop_back()
+    {
+        assert((size_ > 0) && "Trying to remove last element of empty vector is undefined behavior");
+        back() = false;
+        size_ -= 1;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    template <typename ... Args>
+    constexpr vector<bool, A, GrowthPolicy>::reference vector<bool, A, GrowthPolicy>::emplace_back(Args&& ... args)
+    {
+        push_back(bool(std::forward<Args>(args) ...));
+        return back();
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::insert(const_iterator pos, bool value)
+    {
+        return insert(pos, 1, value);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::insert(const_iterator pos, size_type count, bool value)
+    {
+        const auto position = static_cast<size_type>(pos - cbegin());
+        open_gap(position, count);
+        fill_bits(position, position + count, value);
+        return begin() + position;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    template <std::input_iterator InputIt>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        const auto position = static_cast<size_type>(pos - cbegin());
+
+        if constexpr (std::forward_iterator<InputIt>) {
+            return insert_counted(position, first, static_cast<size_type>(std::distance(first, last)));
+        } else {
+            // Single pass ranges are collected first, so that bits after pos are moved only once
+            vector buffer;
+            for (; first != last; ++first) {
+                buffer.push_back(static_cast<bool>(*first));
+            }
+
+            return insert_counted(position, buffer.cbegin(), buffer.size());
+        }
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::insert(const_iterator pos, std::initializer_list<bool> init_list)
+    {
+        return insert(pos, std::begin(init_list), std::end(init_list));
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    template <container_compatible_range<bool> R>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::insert_range(const_iterator pos, R&& range)
+    {
+        const auto position = static_cast<size_type>(pos - cbegin());
+
+        if constexpr (std::ranges::forward_range<R>) {
+            return insert_counted(position, std::ranges::begin(range), static_cast<size_type>(std::ranges::distance(range)));
+        } else {
+            vector buffer;
+            auto last = std::ranges::end(range);
+            for (auto i = std::ranges::begin(range); i != last; ++i) {
+                buffer.push_back(static_cast<bool>(*i));
+            }
+
+            return insert_counted(position, buffer.cbegin(), buffer.size());
+        }
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    template <container_compatible_range<bool> R>
+    constexpr void vector<bool, A, GrowthPolicy>::append_range(R&& range)
+    {
+        insert_range(cend(), std::forward<R>(range));
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::erase(const_iterator first, const_iterator last)
+    {
+        const auto first_index = static_cast<size_type>(first - cbegin());
+        const auto last_index = static_cast<size_type>(last - cbegin());
+        const auto count = last_index - first_index;
+
+        if (count != 0) {
+            move_bits(last_index, first_index, size_ - last_index);
+            fill_bits(size_ - count, size_, false);
+            size_ -= count;
+        }
+
+        return begin() + first_index;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    template <typename ... Args>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::emplace(const_iterator pos, Args&& ... args)
+    {
+        return insert(pos, bool(std::forward<Args>(args) ...));
+    }
+
+    // Size/capacity modification
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::clear() noexcept
+    {
+        reset();
+        size_ = 0;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::resize(size_type new_size, bool value)
+    {
+        if (new_size > size_) {
+            grow_to_fit(new_size);
+            // New bits are already zero
+            if (value) {
+                fill_bits(size_, new_size, true);
+            }
+        } else {
+            fill_bits(new_size, size_, false);
+        }
+
+        size_ = new_size;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::reserve(size_type new_capacity)
+    {
+        if (new_capacity > capacity()) {
+            reallocate(calculate_words_count(new_capacity));
+        }
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::shrink_to_fit()
+    {
+        if (used_words_count() < words_capacity_) {
+            reallocate(used_words_count());
+        }
+    }
+
+    // Iterators
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::begin() noexcept
+    {
+        return iterator(data_, 0);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::end() noexcept
+    {
+        return begin() + static_cast<difference_type>(size_);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_iterator vector<bool, A, GrowthPolicy>::begin() const noexcept
+    {
+        return const_iterator(data_, 0);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_iterator vector<bool, A, GrowthPolicy>::end() const noexcept
+    {
+        return begin() + static_cast<difference_type>(size_);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_iterator vector<bool, A, GrowthPolicy>::cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_iterator vector<bool, A, GrowthPolicy>::cend() const noexcept
+    {
+        return end();
+    }
+
+    // Reverse iterators
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::reverse_iterator vector<bool, A, GrowthPolicy>::rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::reverse_iterator vector<bool, A, GrowthPolicy>::rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_reverse_iterator vector<bool, A, GrowthPolicy>::rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_reverse_iterator vector<bool, A, GrowthPolicy>::rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_reverse_iterator vector<bool, A, GrowthPolicy>::crbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::const_reverse_iterator vector<bool, A, GrowthPolicy>::crend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    // Private member functions
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::size_type vector<bool, A, GrowthPolicy>::calculate_words_count(size_type bits_count)
+    {
+        return (bits_count + bits_per_word - 1) / bits_per_word;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::size_type vector<bool, A, GrowthPolicy>::used_words_count() const
+    {
+        return calculate_words_count(size_);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::word_type vector<bool, A, GrowthPolicy>::low_bits_mask(size_type count)
+    {
+        assert((0 < count && count <= bits_per_word) && "Invalid number of bits");
+        // Shifting by bits_per_word is undefined, so full mask is shifted right instead
+        return ~word_type { 0 } >> (bits_per_word - count);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::reallocate(size_type new_words_capacity)
+    {
+        const auto words_count = used_words_count();
+        assert((new_words_capacity >= words_count) && "New capacity must fit all elements");
+
+        word_type* new_data = word_allocator_traits::allocate(allocator_, new_words_capacity);
+        // Nothing here can throw
+        std::copy(data_, data_ + words_count, new_data);
+        std::fill(new_data + words_count, new_data + new_words_capacity, word_type { 0 });
+
+        if (data_ != nullptr) {
+            word_allocator_traits::deallocate(allocator_, data_, words_capacity_);
+        }
+
+        data_ = new_data;
+        words_capacity_ = new_words_capacity;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::grow_to_fit(size_type required_size)
+    {
+        if (required_size <= capacity()) {
+            return;
+        }
+
+        const auto required_words = calculate_words_count(required_size);
+        const size_type new_words_capacity = growth_policy_(words_capacity_, required_words, sizeof(word_type));
+        assert((new_words_capacity >= required_words) && "Growth policy must return capacity that fits all required elements");
+        reallocate(new_words_capacity);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr vector<bool, A, GrowthPolicy>::word_type vector<bool, A, GrowthPolicy>::read_bits(size_type index, size_type count) const
+    {
+        const auto word_index = index / bits_per_word;
+        const auto offset = index % bits_per_word;
+
+        auto bits = data_[word_index] >> offset;
+        if (offset != 0 && offset + count > bits_per_word) {
+            bits |= data_[word_index + 1] << (bits_per_word - offset);
+        }
+
+        return bits & low_bits_mask(count);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::write_bits(size_type index, size_type count, word_type bits)
+    {
+        const auto word_index = index / bits_per_word;
+        const auto offset = index % bits_per_word;
+        const auto mask = low_bits_mask(count);
+        bits &= mask;
+
+        data_[word_index] = (data_[word_index] & ~(mask << offset)) | (bits << offset);
+        if (offset + count > bits_per_word) {
+            // Rest of the bits go to the beginning of the next word
+            const auto high_mask = low_bits_mask(offset + count - bits_per_word);
+            const auto high_bits = bits >> (bits_per_word - offset);
+            data_[word_index + 1] = (data_[word_index + 1] & ~high_mask) | high_bits;
+        }
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::move_bits(size_type source, size_type destination, size_type count)
+    {
+        // Like with memmove, direction is chosen so that source bits are read before they are overwritten
+        if (destination < source) {
+            for (size_type moved = 0; moved < count; ) {
+                const auto chunk = std::min(bits_per_word, count - moved);
+                write_bits(destination + moved, chunk, read_bits(source + moved, chunk));
+                moved += chunk;
+            }
+        } else if (destination > source) {
+            for (size_type remaining = count; remaining > 0; ) {
+                const auto chunk = std::min(bits_per_word, remaining);
+                remaining -= chunk;
+                write_bits(destination + remaining, chunk, read_bits(source + remaining, chunk));
+            }
+        }
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::fill_bits(size_type first, size_type last, bool value)
+    {
+        if (first >= last) {
+            return;
+        }
+
+        const auto first_word = first / bits_per_word;
+        const auto last_word = (last - 1) / bits_per_word;
+        const auto first_mask = ~word_type { 0 } << (first % bits_per_word);
+        const auto last_mask = low_bits_mask((last - 1) % bits_per_word + 1);
+
+        // Partial words at the ends are masked, whole words in the middle are filled directly
+        if (first_word == last_word) {
+            const auto mask = first_mask & last_mask;
+            data_[first_word] = value ? (data_[first_word] | mask) : (data_[first_word] & ~mask);
+            return;
+        }
+
+        data_[first_word] = value ? (data_[first_word] | first_mask) : (data_[first_word] & ~first_mask);
+        std::fill(data_ + first_word + 1, data_ + last_word, value ? ~word_type { 0 } : word_type { 0 });
+        data_[last_word] = value ? (data_[last_word] | last_mask) : (data_[last_word] & ~last_mask);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::open_gap(size_type position, size_type count)
+    {
+        assert((position <= size_) && "Invalid position");
+        grow_to_fit(size_ + count);
+
+        const auto old_size = size_;
+        size_ += count;
+        move_bits(position, position + count, old_size - position);
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    template <std::forward_iterator I>
+    constexpr vector<bool, A, GrowthPolicy>::iterator vector<bool, A, GrowthPolicy>::insert_counted(size_type position, I first, size_type count)
+    {
+        open_gap(position, count);
+
+        // Words are assembled in a register and written at once, instead of setting bits one by one
+        for (size_type written = 0; written < count; ) {
+            const auto chunk = std::min(bits_per_word, count - written);
+            word_type bits = 0;
+            for (size_type i = 0; i < chunk; ++i, ++first) {
+                bits |= word_type { static_cast<bool>(*first) } << i;
+            }
+
+            write_bits(position + written, chunk, bits);
+            written += chunk;
+        }
+
+        return begin() + position;
+    }
+
+    template <typename A, growth_policy GrowthPolicy>
+    constexpr void vector<bool, A, GrowthPolicy>::clear_unused_bits()
+    {
+        if (size_ % bits_per_word != 0) {
+            data_[size_ / bits_per_word] &= low_bits_mask(size_ % bits_per_word);
+        }
+    }
+}
+
+#endif /* TOY_SDL_VECTOR_BOOL_HPP */
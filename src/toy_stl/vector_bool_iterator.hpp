@@ -0,0 +1,300 @@
+#ifndef TOY_SDL_VECTOR_BOOL_ITERATOR_HPP
+#define TOY_SDL_VECTOR_BOOL_ITERATOR_HPP
+
+#include <compare>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace my
+{
+    // Proxy for one bit inside of a word, returned instead of bool& by vector<bool>
+    template <typename Word>
+    class bit_reference
+    {
+    public:
+        constexpr bit_reference(Word* word, Word mask) noexcept;
+        bit_reference(const bit_reference& other) = default;
+
+        constexpr operator bool() const noexcept;
+        constexpr bool operator~ () const noexcept;
+
+        // Assignment is const, because it modifies referenced bit and not the proxy itself
+        // This is what std::indirectly_writable expects from proxy references
+        constexpr const bit_reference& operator= (bool value) const noexcept;
+        constexpr const bit_reference& operator= (const bit_reference& other) const noexcept;
+
+        constexpr void flip() const noexcept;
+
+        template <typename U>
+        friend constexpr void swap(bit_reference<U> a, bit_reference<U> b) noexcept;
+        template <typename U>
+        friend constexpr void swap(bit_reference<U> a, bool& b) noexcept;
+        template <typename U>
+        friend constexpr void swap(bool& a, bit_reference<U> b) noexcept;
+
+    private:
+        Word* word_;
+        Word mask_;
+    };
+
+    // Random access iterator over bits, IsConst selects between bit_reference and bool as reference type
+    template <typename Word, bool IsConst>
+    class bit_iterator
+    {
+    private:
+        using word_pointer = std::conditional_t<IsConst, const Word*, Word*>;
+        constexpr static unsigned bits_per_word = std::numeric_limits<Word>::digits;
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::conditional_t<IsConst, bool, bit_reference<Word>>;
+
+        bit_iterator() = default;
+        constexpr bit_iterator(word_pointer word, unsigned offset) noexcept;
+        // Iterator converts to const_iterator, but not the other way around
+        template <bool OtherIsConst>
+            requires (IsConst && !OtherIsConst)
+        constexpr bit_iterator(const bit_iterator<Word, OtherIsConst>& other) noexcept;
+
+        constexpr bool operator== (const bit_iterator& other) const;
+        constexpr std::strong_ordering operator<=> (const bit_iterator& other) const;
+
+        constexpr bit_iterator& operator++ ();
+        constexpr bit_iterator operator++ (int);
+
+        constexpr bit_iterator& operator-- ();
+        constexpr bit_iterator operator-- (int);
+
+        constexpr bit_iterator& operator+= (difference_type n);
+        constexpr bit_iterator operator+ (difference_type n) const;
+        friend constexpr bit_iterator operator+ (difference_type n, const bit_iterator& i)
+        {
+            return i + n;
+        }
+
+        constexpr bit_iterator& operator-= (difference_type n);
+        constexpr bit_iterator operator- (difference_type n) const;
+        constexpr difference_type operator- (const bit_iterator& other) const;
+
+        constexpr reference operator[] (difference_type n) const;
+        constexpr reference operator* () const;
+
+    private:
+        template <typename, bool>
+        friend class bit_iterator;
+
+        word_pointer word_ { nullptr };
+        unsigned offset_ { 0 }; // Index of bit inside of the word, always less than bits_per_word
+    };
+
+    // bit_reference
+    template <typename Word>
+    constexpr bit_reference<Word>::bit_reference(Word* word, Word mask) noexcept :
+        word_(word),
+        mask_(mask)
+    {
+
+    }
+
+    template <typename Word>
+    constexpr bit_reference<Word>::operator bool() const noexcept
+    {
+        return (*word_ & mask_) != 0;
+    }
+
+    template <typename Word>
+    constexpr bool bit_reference<Word>::operator~ () const noexcept
+    {
+        return !static_cast<bool>(*this);
+    }
+
+    template <typename Word>
+    constexpr const bit_reference<Word>& bit_reference<Word>::operator= (bool value) const noexcept
+    {
+        if (value) {
+            *word_ |= mask_;
+        } else {
+            *word_ &= ~mask_;
+        }
+
+        return *this;
+    }
+
+    template <typename Word>
+    constexpr const bit_reference<Word>& bit_reference<Word>::operator= (const bit_reference& other) const noexcept
+    {
+        return *this = static_cast<bool>(other);
+    }
+
+    template <typename Word>
+    constexpr void bit_reference<Word>::flip() const noexcept
+    {
+        *word_ ^= mask_;
+    }
+
+    template <typename U>
+    constexpr void swap(bit_reference<U> a, bit_reference<U> b) noexcept
+    {
+        const bool temp = a;
+        a = b;
+        b = temp;
+    }
+
+    template <typename U>
+    constexpr void swap(bit_reference<U> a, bool& b) noexcept
+    {
+        const bool temp = a;
+        a = b;
+        b = temp;
+    }
+
+    template <typename U>
+    constexpr void swap(bool& a, bit_reference<U> b) noexcept
+    {
+        swap(b, a);
+    }
+
+    // bit_iterator
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst>::bit_iterator(word_pointer word, unsigned offset) noexcept :
+        word_(word),
+        offset_(offset)
+    {
+
+    }
+
+    template <typename Word, bool IsConst>
+    template <bool OtherIsConst>
+        requires (IsConst && !OtherIsConst)
+    constexpr bit_iterator<Word, IsConst>::bit_iterator(const bit_iterator<Word, OtherIsConst>& other) noexcept :
+        word_(other.word_),
+        offset_(other.offset_)
+    {
+
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bool bit_iterator<Word, IsConst>::operator== (const bit_iterator& other) const
+    {
+        return word_ == other.word_ && offset_ == other.offset_;
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr std::strong_ordering bit_iterator<Word, IsConst>::operator<=> (const bit_iterator& other) const
+    {
+        if (const auto result = word_ <=> other.word_; result != 0) {
+            return result;
+        }
+
+        return offset_ <=> other.offset_;
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst>& bit_iterator<Word, IsConst>::operator++ ()
+    {
+        if (++offset_ == bits_per_word) {
+            offset_ = 0;
+            ++word_;
+        }
+
+        return *this;
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst> bit_iterator<Word, IsConst>::operator++ (int)
+    {
+        const auto copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst>& bit_iterator<Word, IsConst>::operator-- ()
+    {
+        if (offset_ == 0) {
+            offset_ = bits_per_word;
+            --word_;
+        }
+
+        --offset_;
+        return *this;
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst> bit_iterator<Word, IsConst>::operator-- (int)
+    {
+        const auto copy = *this;
+        --(*this);
+        return copy;
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst>& bit_iterator<Word, IsConst>::operator+= (difference_type n)
+    {
+        // Floor division, so that offset stays non-negative when moving backwards
+        constexpr auto word_bits = static_cast<difference_type>(bits_per_word);
+        const auto bit_index = static_cast<difference_type>(offset_) + n;
+        auto word_step = bit_index / word_bits;
+        auto new_offset = bit_index % word_bits;
+        if (new_offset < 0) {
+            new_offset += word_bits;
+            word_step -= 1;
+        }
+
+        word_ += word_step;
+        offset_ = static_cast<unsigned>(new_offset);
+        return *this;
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst> bit_iterator<Word, IsConst>::operator+ (difference_type n) const
+    {
+        auto copy = *this;
+        copy += n;
+        return copy;
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst>& bit_iterator<Word, IsConst>::operator-= (difference_type n)
+    {
+        return *this += -n;
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst> bit_iterator<Word, IsConst>::operator- (difference_type n) const
+    {
+        auto copy = *this;
+        copy -= n;
+        return copy;
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst>::difference_type bit_iterator<Word, IsConst>::operator- (const bit_iterator& other) const
+    {
+        return (word_ - other.word_) * static_cast<difference_type>(bits_per_word)
+            + static_cast<difference_type>(offset_) - static_cast<difference_type>(other.offset_);
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst>::reference bit_iterator<Word, IsConst>::operator[] (difference_type n) const
+    {
+        return *(*this + n);
+    }
+
+    template <typename Word, bool IsConst>
+    constexpr bit_iterator<Word, IsConst>::reference bit_iterator<Word, IsConst>::operator* () const
+    {
+        if constexpr (IsConst) {
+            return (*word_ >> offset_) & Word { 1 };
+        } else {
+            return bit_reference<Word>(word_, Word { 1 } << offset_);
+        }
+    }
+}
+
+#endif /* TOY_SDL_VECTOR_BOOL_ITERATOR_HPP */
@@ -19,61 +19,61 @@ namespace my
         using element_type = const value_type;
 
         vector_const_iterator() = default;
-        explicit vector_const_iterator(T* ptr);
+        constexpr explicit vector_const_iterator(T* ptr);
 
-        bool operator== (const vector_const_iterator<T>& other) const;
-        std::strong_ordering operator<=> (const vector_const_iterator<T>& other) const;
+        constexpr bool operator== (const vector_const_iterator<T>& other) const;
+        constexpr std::strong_ordering operator<=> (const vector_const_iterator<T>& other) const;
 
-        vector_const_iterator& operator++ ();
-        vector_const_iterator operator++ (int);
+        constexpr vector_const_iterator& operator++ ();
+        constexpr vector_const_iterator operator++ (int);
 
-        vector_const_iterator& operator-- ();
-        vector_const_iterator operator-- (int);
+        constexpr vector_const_iterator& operator-- ();
+        constexpr vector_const_iterator operator-- (int);
 
-        vector_const_iterator& operator+= (difference_type n);
+        constexpr vector_const_iterator& operator+= (difference_type n);
         template<typename U>
-        friend vector_const_iterator<U> operator+ (vector_const_iterator<U> i, vector_const_iterator<U>::difference_type n);
+        friend constexpr vector_const_iterator<U> operator+ (vector_const_iterator<U> i, vector_const_iterator<U>::difference_type n);
         template<typename U>
-        friend vector_const_iterator<U> operator+ (vector_const_iterator<U>::difference_type n, vector_const_iterator<U> i);
+        friend constexpr vector_const_iterator<U> operator+ (vector_const_iterator<U>::difference_type n, vector_const_iterator<U> i);
 
-        vector_const_iterator& operator-= (difference_type n);
+        constexpr vector_const_iterator& operator-= (difference_type n);
         template<typename U>
-        friend vector_const_iterator<U>::difference_type operator- (const vector_const_iterator<U>& a, const vector_const_iterator<U>& b);
+        friend constexpr vector_const_iterator<U>::difference_type operator- (const vector_const_iterator<U>& a, const vector_const_iterator<U>& b);
 
-        reference operator[] (std::ptrdiff_t n) const;
-        reference operator* () const;
-        pointer operator-> () const;
+        constexpr reference operator[] (std::ptrdiff_t n) const;
+        constexpr reference operator* () const;
+        constexpr pointer operator-> () const;
     private:
         T* ptr{};
     };
 
     template <typename T>
-    vector_const_iterator<T>::vector_const_iterator(T* ptr) : ptr(ptr)
+    constexpr vector_const_iterator<T>::vector_const_iterator(T* ptr) : ptr(ptr)
     {
 
     }
 
     template <typename T>
-    bool vector_const_iterator<T>::operator== (const vector_const_iterator<T>& other) const
+    constexpr bool vector_const_iterator<T>::operator== (const vector_const_iterator<T>& other) const
     {
         return ptr == other.ptr;
     }
 
     template<typename T>
-    std::strong_ordering vector_const_iterator<T>::operator<=> (const vector_const_iterator<T>& other) const
+    constexpr std::strong_ordering vector_const_iterator<T>::operator<=> (const vector_const_iterator<T>& other) const
     {
         return ptr <=> other.ptr;
     }
 
     template <typename T>
-    vector_const_iterator<T>& vector_const_iterator<T>::operator++ ()
+    constexpr vector_const_iterator<T>& vector_const_iterator<T>::operator++ ()
     {
         ++ptr;
         return *this;
     }
 
     template <typename T>
-    vector_const_iterator<T> vector_const_iterator<T>::operator++ (int)
+    constexpr vector_const_iterator<T> vector_const_iterator<T>::operator++ (int)
     {
         const auto copy = *this;
         ++ptr;
@@ -81,14 +81,14 @@ namespace my
     }
 
     template <typename T>
-    vector_const_iterator<T>& vector_const_iterator<T>::operator-- ()
+    constexpr vector_const_iterator<T>& vector_const_iterator<T>::operator-- ()
     {
         --ptr;
         return *this;
     }
 
     template <typename T>
-    vector_const_iterator<T> vector_const_iterator<T>::operator-- (int)
+    constexpr vector_const_iterator<T> vector_const_iterator<T>::operator-- (int)
     {
         const auto copy = *this;
         --ptr;
@@ -96,60 +96,60 @@ namespace my
     }
 
     template<typename T>
-    vector_const_iterator<T>& vector_const_iterator<T>::operator+= (difference_type n)
+    constexpr vector_const_iterator<T>& vector_const_iterator<T>::operator+= (difference_type n)
     {
         ptr += n;
         return *this;
     }
 
     template <typename T>
-    vector_const_iterator<T> operator+ (vector_const_iterator<T> i, typename vector_const_iterator<T>::difference_type n)
+    constexpr vector_const_iterator<T> operator+ (vector_const_iterator<T> i, typename vector_const_iterator<T>::difference_type n)
     {
         i += n;
         return i;
     }
 
     template <typename T>
-    vector_const_iterator<T> operator+ (typename vector_const_iterator<T>::difference_type n, vector_const_iterator<T> i)
+    constexpr vector_const_iterator<T> operator+ (typename vector_const_iterator<T>::difference_type n, vector_const_iterator<T> i)
     {
         i += n;
         return i;
     }
 
     template<typename T>
-    vector_const_iterator<T>& vector_const_iterator<T>::operator-= (difference_type n)
+    constexpr vector_const_iterator<T>& vector_const_iterator<T>::operator-= (difference_type n)
     {
         ptr -= n;
         return *this;
     }
 
     template <typename T>
-    vector_const_iterator<T> operator- (vector_const_iterator<T> i, typename vector_const_iterator<T>::difference_type n)
+    constexpr vector_const_iterator<T> operator- (vector_const_iterator<T> i, typename vector_const_iterator<T>::difference_type n)
     {
         i -= n;
         return i;
     }
 
     template <typename T>
-    vector_const_iterator<T>::difference_type operator- (const vector_const_iterator<T>& a, const vector_const_iterator<T>& b)
+    constexpr vector_const_iterator<T>::difference_type operator- (const vector_const_iterator<T>& a, const vector_const_iterator<T>& b)
     {
         return a.ptr - b.ptr;
     }
 
     template<typename T>
-    vector_const_iterator<T>::reference vector_const_iterator<T>::operator[] (difference_type n) const
+    constexpr vector_const_iterator<T>::reference vector_const_iterator<T>::operator[] (difference_type n) const
     {
         return *(ptr + n);
     }
 
     template <typename T>
-    vector_const_iterator<T>::reference vector_const_iterator<T>::operator* () const
+    constexpr vector_const_iterator<T>::reference vector_const_iterator<T>::operator* () const
     {
         return *ptr;
     }
 
     template <typename T>
-    vector_const_iterator<T>::pointer vector_const_iterator<T>::operator-> () const
+    constexpr vector_const_iterator<T>::pointer vector_const_iterator<T>::operator-> () const
     {
         return ptr;
     }
@@ -0,0 +1,65 @@
+#ifndef TOY_SDL_VECTOR_GROWTH_POLICY_HPP
+#define TOY_SDL_VECTOR_GROWTH_POLICY_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+
+namespace my
+{
+    // Growth policy decides how much memory vector allocates when it runs out of capacity
+    // It is called with current capacity, minimal required capacity and size of one element in bytes
+    // and must return new capacity which is not less than required capacity
+    template <typename P>
+    concept growth_policy = std::default_initializable<P> && requires (const P& policy, std::size_t n)
+    {
+        { policy(n, n, n) } -> std::convertible_to<std::size_t>;
+    };
+
+    // Multiplies capacity by Numerator / Denominator
+    template <std::size_t Numerator, std::size_t Denominator = 1>
+    struct geometric_growth
+    {
+        static_assert(Numerator > Denominator, "Growth factor must be greater than 1");
+
+        constexpr std::size_t operator()(std::size_t capacity, std::size_t required_capacity, std::size_t /* element_size */) const
+        {
+            // Rounding up, so that capacity always grows at least by one element
+            const auto grown_capacity = (capacity * Numerator + Denominator - 1) / Denominator;
+            return std::max(grown_capacity, required_capacity);
+        }
+    };
+
+    using double_growth = geometric_growth<2>;
+    using one_and_half_growth = geometric_growth<3, 2>;
+
+    // Rounds allocation size up to the nearest size class of jemalloc-like allocators
+    // Classes go in steps of 16 bytes up to 128 bytes, after that there are 4 classes for every power of two
+    constexpr std::size_t round_up_to_size_class(std::size_t bytes)
+    {
+        constexpr std::size_t quantum = 16;
+
+        if (bytes <= quantum) {
+            return bytes <= quantum / 2 ? quantum / 2 : quantum;
+        }
+
+        const auto previous_power_of_two = std::bit_floor(bytes - 1);
+        const auto spacing = std::max(previous_power_of_two / 4, quantum);
+        return (bytes + spacing - 1) / spacing * spacing;
+    }
+
+    // Grows capacity with Base policy and then uses all bytes of the size class allocator would round allocation to anyway
+    // Freed blocks of the same size class can be reused by allocator for next allocations
+    template <growth_policy Base = one_and_half_growth>
+    struct size_class_growth
+    {
+        constexpr std::size_t operator()(std::size_t capacity, std::size_t required_capacity, std::size_t element_size) const
+        {
+            const std::size_t grown_capacity = Base { }(capacity, required_capacity, element_size);
+            return round_up_to_size_class(grown_capacity * element_size) / element_size;
+        }
+    };
+}
+
+#endif /* TOY_SDL_VECTOR_GROWTH_POLICY_HPP */
@@ -1,6 +1,8 @@
 #ifndef TOY_SDL_VECTOR_ITERATOR_HPP
 #define TOY_SDL_VECTOR_ITERATOR_HPP
 
+#include "vector_const_iterator.hpp"
+
 #include <compare>
 #include <iterator>
 
@@ -19,61 +21,64 @@ namespace my
         using element_type = value_type;
 
         vector_iterator() = default;
-        explicit vector_iterator(T* ptr);
+        constexpr explicit vector_iterator(T* ptr);
 
-        bool operator== (const vector_iterator<T>& other) const;
-        std::strong_ordering operator<=> (const vector_iterator<T>& other) const;
+        constexpr bool operator== (const vector_iterator<T>& other) const;
+        constexpr std::strong_ordering operator<=> (const vector_iterator<T>& other) const;
 
-        vector_iterator& operator++ ();
-        vector_iterator operator++ (int);
+        constexpr vector_iterator& operator++ ();
+        constexpr vector_iterator operator++ (int);
 
-        vector_iterator& operator-- ();
-        vector_iterator operator-- (int);
+        constexpr vector_iterator& operator-- ();
+        constexpr vector_iterator operator-- (int);
 
-        vector_iterator& operator+= (difference_type n);
+        constexpr vector_iterator& operator+= (difference_type n);
         template<typename U>
-        friend vector_iterator<U> operator+ (vector_iterator<U> i, vector_iterator<U>::difference_type n);
+        friend constexpr vector_iterator<U> operator+ (vector_iterator<U> i, vector_iterator<U>::difference_type n);
         template<typename U>
-        friend vector_iterator<U> operator+ (vector_iterator<U>::difference_type n, vector_iterator<U> i);
+        friend constexpr vector_iterator<U> operator+ (vector_iterator<U>::difference_type n, vector_iterator<U> i);
 
-        vector_iterator& operator-= (difference_type n);
+        constexpr vector_iterator& operator-= (difference_type n);
         template<typename U>
-        friend vector_iterator<U>::difference_type operator- (const vector_iterator<U>& a, const vector_iterator<U>& b);
+        friend constexpr vector_iterator<U>::difference_type operator- (const vector_iterator<U>& a, const vector_iterator<U>& b);
+
+        constexpr T& operator[] (difference_type n) const;
+        constexpr T& operator* () const;
+        constexpr T* operator-> () const;
 
-        T& operator[] (difference_type n) const;
-        T& operator* () const;
-        T* operator-> () const;
+        // Allows passing iterator to functions that take const_iterator, like insert and erase
+        constexpr operator vector_const_iterator<T>() const;
     private:
         T* ptr{};
     };
 
     template <typename T>
-    vector_iterator<T>::vector_iterator(T* ptr) : ptr(ptr)
+    constexpr vector_iterator<T>::vector_iterator(T* ptr) : ptr(ptr)
     {
 
     }
 
     template <typename T>
-    bool vector_iterator<T>::operator== (const vector_iterator<T>& other) const
+    constexpr bool vector_iterator<T>::operator== (const vector_iterator<T>& other) const
     {
         return ptr == other.ptr;
     }
 
     template<typename T>
-    std::strong_ordering vector_iterator<T>::operator<=> (const vector_iterator<T>& other) const
+    constexpr std::strong_ordering vector_iterator<T>::operator<=> (const vector_iterator<T>& other) const
     {
         return ptr <=> other.ptr;
     }
 
     template <typename T>
-    vector_iterator<T>& vector_iterator<T>::operator++ ()
+    constexpr vector_iterator<T>& vector_iterator<T>::operator++ ()
     {
         ++ptr;
         return *this;
     }
 
     template <typename T>
-    vector_iterator<T> vector_iterator<T>::operator++ (int)
+    constexpr vector_iterator<T> vector_iterator<T>::operator++ (int)
     {
         const auto copy = *this;
         ++ptr;
@@ -81,14 +86,14 @@ namespace my
     }
 
     template <typename T>
-    vector_iterator<T>& vector_iterator<T>::operator-- ()
+    constexpr vector_iterator<T>& vector_iterator<T>::operator-- ()
     {
         --ptr;
         return *this;
     }
 
     template <typename T>
-    vector_iterator<T> vector_iterator<T>::operator-- (int)
+    constexpr vector_iterator<T> vector_iterator<T>::operator-- (int)
     {
         const auto copy = *this;
         --ptr;
@@ -96,63 +101,69 @@ namespace my
     }
 
     template<typename T>
-    vector_iterator<T>& vector_iterator<T>::operator+= (difference_type n)
+    constexpr vector_iterator<T>& vector_iterator<T>::operator+= (difference_type n)
     {
         ptr += n;
         return *this;
     }
 
     template <typename T>
-    vector_iterator<T> operator+ (vector_iterator<T> i, typename vector_iterator<T>::difference_type n)
+    constexpr vector_iterator<T> operator+ (vector_iterator<T> i, typename vector_iterator<T>::difference_type n)
     {
         i += n;
         return i;
     }
 
     template <typename T>
-    vector_iterator<T> operator+ (typename vector_iterator<T>::difference_type n, vector_iterator<T> i)
+    constexpr vector_iterator<T> operator+ (typename vector_iterator<T>::difference_type n, vector_iterator<T> i)
     {
         i += n;
         return i;
     }
 
     template<typename T>
-    vector_iterator<T>& vector_iterator<T>::operator-= (difference_type n)
+    constexpr vector_iterator<T>& vector_iterator<T>::operator-= (difference_type n)
     {
         ptr -= n;
         return *this;
     }
 
     template <typename T>
-    vector_iterator<T> operator- (vector_iterator<T> i, typename vector_iterator<T>::difference_type n)
+    constexpr vector_iterator<T> operator- (vector_iterator<T> i, typename vector_iterator<T>::difference_type n)
     {
         i -= n;
         return i;
     }
 
     template <typename T>
-    vector_iterator<T>::difference_type operator- (const vector_iterator<T>& a, const vector_iterator<T>& b)
+    constexpr vector_iterator<T>::difference_type operator- (const vector_iterator<T>& a, const vector_iterator<T>& b)
     {
         return a.ptr - b.ptr;
     }
 
     template<typename T>
-    T& vector_iterator<T>::operator[] (difference_type n) const
+    constexpr T& vector_iterator<T>::operator[] (difference_type n) const
     {
         return *(ptr + n);
     }
 
     template <typename T>
-    T& vector_iterator<T>::operator* () const
+    constexpr T& vector_iterator<T>::operator* () const
     {
         return *ptr;
     }
 
     template <typename T>
-    T* vector_iterator<T>::operator-> () const
+    constexpr T* vector_iterator<T>::operator-> () const
     {
         return ptr;
     }
+
+    template <typename T>
+    constexpr vector_iterator<T>::operator vector_const_iterator<T>() const
+    {
+        return vector_const_iterator<T>(ptr);
+    }
 }
 
 #endif /* TOY_SDL_VECTOR_ITERATOR_HPP */
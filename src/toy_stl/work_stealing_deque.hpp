@@ -0,0 +1,252 @@
+#ifndef TOY_SDL_WORK_STEALING_DEQUE_HPP
+#define TOY_SDL_WORK_STEALING_DEQUE_HPP
+
+#include "cache_line.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <type_traits>
+
+namespace my
+{
+    // Chase-Lev deque, memory orders follow "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al.)
+    // Owner thread pushes and pops at the bottom, any number of thieves steal from the top
+    // Like deque, elements live in a circular array with power of two capacity, indices only increase and are wrapped with a mask
+    // When the array is full, owner copies elements to an array of double size and publishes it
+    // Thieves can still read the old array, so it is retired instead of freed and released together with the deque
+    // Retired arrays are at most as large as the current one in total, because capacity doubles every time
+    template <typename T, typename Allocator = std::allocator<T>>
+    class work_stealing_deque
+    {
+        // Thieves read elements that owner may overwrite at the same time, losing thief then discards the value
+        // This is only defined for atomics, so elements are stored as std::atomic<T>
+        static_assert(std::is_trivially_copyable_v<T>, "Elements of work stealing deque must be trivially copyable, store pointers to tasks");
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+
+        explicit work_stealing_deque(size_type initial_capacity = 64, const Allocator& allocator = Allocator());
+
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+        ~work_stealing_deque();
+
+        // Owner side
+        void push_bottom(const T& value);
+        std::optional<T> pop_bottom();
+        size_type capacity() const noexcept;
+
+        // Thief side, empty result can also mean that another thief or owner took the same element
+        std::optional<T> steal();
+
+        // Exact only when nobody is running
+        size_type size_approx() const noexcept;
+        bool empty_approx() const noexcept;
+
+    private:
+        // Bottom can be one less than top while owner pops from empty deque, so indices are signed
+        using index_type = std::ptrdiff_t;
+
+        struct circular_array
+        {
+            std::atomic<T>* slots { nullptr };
+            size_type capacity { 0 };
+            // Arrays replaced by growth, newest first
+            circular_array* retired { nullptr };
+
+            T load(index_type index) const noexcept;
+            void store(index_type index, const T& value) noexcept;
+        };
+
+        using slot_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<std::atomic<T>>;
+        using array_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<circular_array>;
+
+        circular_array* allocate_array(size_type capacity);
+        void deallocate_array(circular_array* array);
+        // Called by owner when array is full, copies elements [t, b) to the new array
+        circular_array* grow(circular_array* old_array, index_type t, index_type b);
+
+        [[no_unique_address]] slot_allocator_type slot_allocator;
+        [[no_unique_address]] array_allocator_type array_allocator;
+
+        // Thieves side
+        alignas(cache_line_size) std::atomic<index_type> top { 0 };
+
+        // Owner side, thieves only read these
+        alignas(cache_line_size) std::atomic<index_type> bottom { 0 };
+        std::atomic<circular_array*> array { nullptr };
+    };
+
+    template <typename T, typename Allocator>
+    work_stealing_deque<T, Allocator>::work_stealing_deque(size_type initial_capacity, const Allocator& allocator) :
+        slot_allocator(allocator),
+        array_allocator(allocator)
+    {
+        array.store(allocate_array(std::bit_ceil(std::max<size_type>(initial_capacity, 2))), std::memory_order_relaxed);
+    }
+
+    template <typename T, typename Allocator>
+    work_stealing_deque<T, Allocator>::~work_stealing_deque()
+    {
+        auto current = array.load(std::memory_order_relaxed);
+        while (current != nullptr) {
+            auto retired = current->retired;
+            deallocate_array(current);
+            current = retired;
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void work_stealing_deque<T, Allocator>::push_bottom(const T& value)
+    {
+        const auto b = bottom.load(std::memory_order_relaxed);
+        const auto t = top.load(std::memory_order_acquire);
+        auto current = array.load(std::memory_order_relaxed);
+
+        if (b - t > static_cast<index_type>(current->capacity) - 1) {
+            current = grow(current, t, b);
+        }
+
+        current->store(b, value);
+        // Element must be visible to a thief that sees the new bottom
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<T> work_stealing_deque<T, Allocator>::pop_bottom()
+    {
+        const auto b = bottom.load(std::memory_order_relaxed) - 1;
+        const auto current = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        // Either owner sees increment of top by a thief, or the thief sees decremented bottom
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        const auto value = current->load(b);
+        if (t == b) {
+            // Last element, owner races with thieves for it
+            const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won) {
+                return std::nullopt;
+            }
+        }
+
+        return value;
+    }
+
+    template <typename T, typename Allocator>
+    work_stealing_deque<T, Allocator>::size_type work_stealing_deque<T, Allocator>::capacity() const noexcept
+    {
+        return array.load(std::memory_order_relaxed)->capacity;
+    }
+
+    template <typename T, typename Allocator>
+    std::optional<T> work_stealing_deque<T, Allocator>::steal()
+    {
+        auto t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return std::nullopt;
+        }
+
+        // Array may be retired right after this load, but it is not freed while deque is alive
+        const auto current = array.load(std::memory_order_acquire);
+        const auto value = current->load(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+
+        return value;
+    }
+
+    template <typename T, typename Allocator>
+    work_stealing_deque<T, Allocator>::size_type work_stealing_deque<T, Allocator>::size_approx() const noexcept
+    {
+        const auto t = top.load(std::memory_order_acquire);
+        const auto b = bottom.load(std::memory_order_acquire);
+        return b > t ? static_cast<size_type>(b - t) : 0;
+    }
+
+    template <typename T, typename Allocator>
+    bool work_stealing_deque<T, Allocator>::empty_approx() const noexcept
+    {
+        return size_approx() == 0;
+    }
+
+    template <typename T, typename Allocator>
+    T work_stealing_deque<T, Allocator>::circular_array::load(index_type index) const noexcept
+    {
+        // Capacity is power of two, so this is the same wraparound as in deque_data::wrap_index
+        return slots[static_cast<size_type>(index) & (capacity - 1)].load(std::memory_order_relaxed);
+    }
+
+    template <typename T, typename Allocator>
+    void work_stealing_deque<T, Allocator>::circular_array::store(index_type index, const T& value) noexcept
+    {
+        slots[static_cast<size_type>(index) & (capacity - 1)].store(value, std::memory_order_relaxed);
+    }
+
+    template <typename T, typename Allocator>
+    work_stealing_deque<T, Allocator>::circular_array* work_stealing_deque<T, Allocator>::allocate_array(size_type capacity)
+    {
+        auto new_array = std::allocator_traits<array_allocator_type>::allocate(array_allocator, 1);
+        std::allocator_traits<array_allocator_type>::construct(array_allocator, new_array);
+
+        try {
+            new_array->slots = std::allocator_traits<slot_allocator_type>::allocate(slot_allocator, capacity);
+        } catch (...) {
+            std::allocator_traits<array_allocator_type>::deallocate(array_allocator, new_array, 1);
+            throw;
+        }
+
+        // Atomics of trivially copyable types can't throw
+        for (size_type i = 0; i < capacity; ++i) {
+            std::allocator_traits<slot_allocator_type>::construct(slot_allocator, new_array->slots + i);
+        }
+        new_array->capacity = capacity;
+
+        return new_array;
+    }
+
+    template <typename T, typename Allocator>
+    void work_stealing_deque<T, Allocator>::deallocate_array(circular_array* old_array)
+    {
+        // Atomics of trivially copyable types are trivially destructible
+        std::allocator_traits<slot_allocator_type>::deallocate(slot_allocator, old_array->slots, old_array->capacity);
+        std::allocator_traits<array_allocator_type>::destroy(array_allocator, old_array);
+        std::allocator_traits<array_allocator_type>::deallocate(array_allocator, old_array, 1);
+    }
+
+    template <typename T, typename Allocator>
+    work_stealing_deque<T, Allocator>::circular_array* work_stealing_deque<T, Allocator>::grow(circular_array* old_array, index_type t, index_type b)
+    {
+        // Elements keep their indices, only the mask changes
+        auto new_array = allocate_array(old_array->capacity * 2);
+        for (auto i = t; i < b; ++i) {
+            new_array->store(i, old_array->load(i));
+        }
+
+        new_array->retired = old_array;
+        array.store(new_array, std::memory_order_release);
+
+        return new_array;
+    }
+}
+
+#endif /* TOY_SDL_WORK_STEALING_DEQUE_HPP */
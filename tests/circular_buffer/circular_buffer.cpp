@@ -0,0 +1,207 @@
+#include "doctest/doctest.h"
+#include "toy_stl/circular_buffer.hpp"
+#include "../test_fixtures.hpp"
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+using test::CountingAllocator;
+using test::Tracked;
+
+namespace
+{
+    // Assignment throws when asked, construction never does
+    struct ThrowingAssignment
+    {
+        static inline bool throw_on_assign = false;
+
+        int value { 0 };
+
+        ThrowingAssignment(int value = 0) : value(value) { }
+        ThrowingAssignment(const ThrowingAssignment& other) = default;
+
+        ThrowingAssignment& operator=(const ThrowingAssignment& other)
+        {
+            if (throw_on_assign) {
+                throw std::runtime_error("Assignment failed");
+            }
+            value = other.value;
+            return *this;
+        }
+    };
+}
+
+TEST_SUITE("Circular buffer") {
+    static_assert(std::random_access_iterator<my::circular_buffer<int>::iterator>);
+    static_assert(std::random_access_iterator<my::circular_buffer<int>::const_iterator>);
+
+    TEST_CASE("Buffer should keep the last capacity elements") {
+        my::circular_buffer<std::string> buf(5);
+        std::deque<std::string> expected;
+
+        for (int i = 0; i < 23; ++i) {
+            buf.push_back(std::to_string(i));
+            expected.push_back(std::to_string(i));
+            if (expected.size() > 5) {
+                expected.pop_front();
+            }
+
+            REQUIRE(buf.size() == expected.size());
+            CHECK(std::equal(buf.begin(), buf.end(), expected.begin()));
+            CHECK(buf.front() == expected.front());
+            CHECK(buf.back() == expected.back());
+        }
+
+        CHECK(buf.full());
+        CHECK(buf.capacity() == 5);
+        CHECK(buf[2] == "20");
+        CHECK(buf.at(4) == "22");
+        CHECK_THROWS_AS(buf.at(5), std::out_of_range);
+        CHECK(std::equal(buf.rbegin(), buf.rend(), expected.rbegin()));
+    }
+
+    TEST_CASE("Push into full buffer should not allocate or construct") {
+        CountingAllocator<Tracked> allocator;
+        my::circular_buffer<Tracked, CountingAllocator<Tracked>> buf(4, allocator);
+
+        for (int i = 0; i < 4; ++i) {
+            buf.push_back(Tracked(i));
+        }
+
+        const auto constructed_before = Tracked::constructed;
+        const auto destroyed_before = Tracked::destroyed;
+
+        const Tracked value(100);
+        for (int i = 0; i < 10; ++i) {
+            buf.push_back(value);
+        }
+
+        CHECK(*allocator.allocations == 1);
+        CHECK(Tracked::constructed == constructed_before + 1);
+        CHECK(Tracked::destroyed == destroyed_before);
+        CHECK(buf.front().value == 100);
+    }
+
+    TEST_CASE("Failed overwrite should keep order of elements") {
+        my::circular_buffer<ThrowingAssignment> buf(3);
+        for (int i = 0; i < 3; ++i) {
+            buf.push_back(ThrowingAssignment(i));
+        }
+
+        ThrowingAssignment::throw_on_assign = true;
+        CHECK_THROWS_AS(buf.push_back(ThrowingAssignment(3)), std::runtime_error);
+        CHECK_THROWS_AS(buf.emplace_back(4), std::runtime_error);
+        ThrowingAssignment::throw_on_assign = false;
+
+        REQUIRE(buf.size() == 3);
+        CHECK(buf.front().value == 0);
+        CHECK(buf.back().value == 2);
+        for (int i = 0; i < 3; ++i) {
+            CHECK(buf[i].value == i);
+        }
+
+        buf.push_back(ThrowingAssignment(5));
+        CHECK(buf.front().value == 1);
+        CHECK(buf.back().value == 5);
+    }
+
+    TEST_CASE("Emplace into full buffer should return the newest element") {
+        my::circular_buffer<std::string> buf(2);
+
+        buf.emplace_back(3, 'a');
+        buf.emplace_back(3, 'b');
+        auto& newest = buf.emplace_back(3, 'c');
+
+        CHECK(newest == "ccc");
+        CHECK(&newest == &buf.back());
+        CHECK(buf.front() == "bbb");
+    }
+
+    TEST_CASE("Segments should cover elements from oldest to newest") {
+        my::circular_buffer<int> buf(6);
+
+        auto check_segments = [&] {
+            std::vector<int> joined;
+            for (auto segment : buf.segments()) {
+                joined.insert(joined.end(), segment.begin(), segment.end());
+            }
+            CHECK(std::equal(joined.begin(), joined.end(), buf.begin(), buf.end()));
+        };
+
+        for (int i = 0; i < 4; ++i) {
+            buf.push_back(i);
+        }
+        CHECK(buf.segments()[1].empty());
+        check_segments();
+
+        for (int i = 4; i < 9; ++i) {
+            buf.push_back(i);
+        }
+        CHECK(buf.segments()[0].size() == 3);
+        CHECK(buf.segments()[1].size() == 3);
+        check_segments();
+
+        // Bulk draining, like sending a batch of events
+        const auto& const_buf = buf;
+        const auto drained = const_buf.segments()[0].size();
+        buf.pop_front_n(drained);
+        CHECK(buf.size() == 3);
+        CHECK(buf.front() == 6);
+        check_segments();
+    }
+
+    TEST_CASE("Pop and clear should destroy elements") {
+        {
+            my::circular_buffer<Tracked> buf(3);
+            for (int i = 0; i < 7; ++i) {
+                buf.emplace_back(i);
+            }
+
+            buf.pop_front();
+            buf.pop_back();
+            CHECK(buf.size() == 1);
+            CHECK(buf.front().value == 5);
+
+            buf.push_back(Tracked(7));
+            buf.pop_front_n(2);
+            CHECK(buf.empty());
+
+            buf.push_back(Tracked(8));
+            buf.clear();
+            CHECK(buf.empty());
+
+            buf.push_back(Tracked(9));
+        }
+
+        CHECK(Tracked::constructed == Tracked::destroyed);
+    }
+
+    TEST_CASE("Copy and move should keep order") {
+        my::circular_buffer<std::string> buf(3);
+        for (int i = 0; i < 5; ++i) {
+            buf.push_back(std::to_string(i));
+        }
+
+        auto copy = buf;
+        CHECK(copy == buf);
+        CHECK(copy.segments()[1].empty());
+
+        copy.push_back("5");
+        CHECK(copy != buf);
+        CHECK(copy > buf);
+
+        auto moved = std::move(copy);
+        CHECK(moved.front() == "3");
+        CHECK(moved.back() == "5");
+
+        copy = moved;
+        CHECK(copy == moved);
+
+        buf = std::move(moved);
+        CHECK(buf.back() == "5");
+    }
+}
@@ -0,0 +1,122 @@
+#include "doctest/doctest.h"
+#include "toy_stl/deque.hpp"
+
+#include <deque>
+#include <string>
+#include <thread>
+#include <algorithm>
+
+TEST_SUITE("Deque block pool") {
+    TEST_CASE("Pooled deque should work like deque") {
+        my::pooled_deque<std::string, my::small_block_size> deq;
+        std::deque<std::string> expected;
+
+        for (int i = 0; i < 500; ++i) {
+            deq.push_back(std::to_string(i));
+            expected.push_back(std::to_string(i));
+
+            if (i % 2 == 0) {
+                deq.push_front(std::to_string(-i));
+                expected.push_front(std::to_string(-i));
+            }
+
+            if (i % 5 == 0) {
+                deq.pop_front();
+                expected.pop_front();
+            }
+        }
+
+        auto copy = deq;
+
+        REQUIRE(copy.size() == expected.size());
+        CHECK(std::equal(copy.begin(), copy.end(), expected.begin()));
+    }
+
+    TEST_CASE("Freed blocks should be reused by other deques") {
+        using deque_type = my::pooled_deque<long, my::block_elements<8>>;
+        using allocator_type = deque_type::allocator_type;
+
+        const auto cached_before = allocator_type::cached_blocks();
+
+        {
+            deque_type deq;
+            for (long i = 0; i < 8 * 4; ++i) {
+                deq.push_back(i);
+            }
+        }
+
+        CHECK(allocator_type::cached_blocks() == cached_before + 4);
+
+        deque_type other;
+        other.push_back(1);
+
+        CHECK(allocator_type::cached_blocks() == cached_before + 3);
+        CHECK(other.front() == 1);
+    }
+
+    TEST_CASE("Pool should not cache more blocks than limit") {
+        using allocator_type = my::block_pool_allocator<int, my::block_elements<4>, 2>;
+        using deque_type = my::deque<int, allocator_type, my::block_elements<4>>;
+
+        {
+            deque_type deq;
+            for (int i = 0; i < 40; ++i) {
+                deq.push_back(i);
+            }
+        }
+
+        CHECK(allocator_type::cached_blocks() == 2);
+    }
+
+    TEST_CASE("Pool should be separate for every thread") {
+        using deque_type = my::pooled_deque<short, my::block_elements<16>>;
+        using allocator_type = deque_type::allocator_type;
+
+        {
+            deque_type deq(100, 1);
+        }
+        const auto cached_here = allocator_type::cached_blocks();
+
+        std::size_t cached_there = 0;
+        std::thread worker([&] {
+            deque_type deq(10, 1);
+            deq.push_back(2);
+            cached_there = allocator_type::cached_blocks();
+        });
+        worker.join();
+
+        CHECK(cached_here >= 7);
+        CHECK(cached_there == 0);
+        CHECK(allocator_type::cached_blocks() == cached_here);
+    }
+
+    TEST_CASE("Deque that outlives the pool should free blocks to std::allocator") {
+        using deque_type = my::pooled_deque<int, my::block_elements<32>>;
+
+        std::thread worker([] {
+            // Constructed before the pool, so it is destroyed after the pool when thread exits
+            thread_local deque_type deq;
+            for (int i = 0; i < 1000; ++i) {
+                deq.push_back(i);
+            }
+            for (int i = 0; i < 500; ++i) {
+                deq.pop_front();
+            }
+        });
+        worker.join();
+
+        CHECK(deque_type::allocator_type::cached_blocks() == 0);
+    }
+
+    TEST_CASE("Allocations of other sizes should not be pooled") {
+        using allocator_type = my::block_pool_allocator<int, my::block_elements<4>>;
+
+        allocator_type allocator;
+        const auto cached_before = allocator_type::cached_blocks();
+
+        auto memory = allocator.allocate(5);
+        allocator.deallocate(memory, 5);
+
+        CHECK(allocator_type::cached_blocks() == cached_before);
+    }
+}
@@ -0,0 +1,107 @@
+#include "doctest/doctest.h"
+#include "toy_stl/deque.hpp"
+
+#include <deque>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+    struct Large
+    {
+        std::int64_t values[64];
+    };
+
+    // Pushes to both ends and pops from both ends, so that blocks are allocated, crossed and wrapped around
+    template <typename Deque>
+    void check_against_std_deque()
+    {
+        using value_type = typename Deque::value_type;
+
+        Deque deq;
+        std::deque<value_type> expected;
+
+        for (int i = 0; i < 3000; ++i) {
+            const auto value = static_cast<value_type>(i);
+
+            if (i % 3 == 0) {
+                deq.push_front(value);
+                expected.push_front(value);
+            } else {
+                deq.push_back(value);
+                expected.push_back(value);
+            }
+
+            if (i % 7 == 0) {
+                deq.pop_front();
+                expected.pop_front();
+            }
+
+            if (i % 11 == 0 && !expected.empty()) {
+                deq.pop_back();
+                expected.pop_back();
+            }
+        }
+
+        deq.insert(deq.begin() + deq.size() / 3, 100, value_type { });
+        expected.insert(expected.begin() + expected.size() / 3, 100, value_type { });
+
+        REQUIRE(deq.size() == expected.size());
+        CHECK(std::equal(deq.begin(), deq.end(), expected.begin(), expected.end()));
+    }
+}
+
+TEST_SUITE("Deque block size") {
+    TEST_CASE("Default policy should fit block into 4096 bytes") {
+        CHECK(my::deque<char>::block_size == 4096);
+        CHECK(my::deque<int>::block_size == 1024);
+        CHECK(my::deque<Large>::block_size == 16);
+    }
+
+    TEST_CASE("Block size should be rounded down to power of two") {
+        struct Triple
+        {
+            int a, b, c;
+        };
+
+        CHECK(my::deque<Triple>::block_size == 256);
+        CHECK(my::deque<int, std::allocator<int>, my::block_bytes<1000, 1>>::block_size == 128);
+    }
+
+    TEST_CASE("Block size policies should change block size") {
+        CHECK(my::deque<int, std::allocator<int>, my::large_block_size>::block_size == 16 * 1024);
+        CHECK(my::deque<int, std::allocator<int>, my::huge_page_block_size>::block_size == 512 * 1024);
+        CHECK(my::deque<int, std::allocator<int>, my::small_block_size>::block_size == 64);
+        CHECK(my::deque<Large, std::allocator<Large>, my::small_block_size>::block_size == 4);
+        CHECK(my::deque<int, std::allocator<int>, my::block_elements<2>>::block_size == 2);
+    }
+
+    TEST_CASE("Deque should work with any block size") {
+        SUBCASE("Single element blocks") {
+            check_against_std_deque<my::deque<int, std::allocator<int>, my::block_elements<1>>>();
+        }
+
+        SUBCASE("Small blocks") {
+            check_against_std_deque<my::deque<int, std::allocator<int>, my::block_elements<4>>>();
+        }
+
+        SUBCASE("Default blocks") {
+            check_against_std_deque<my::deque<int>>();
+        }
+
+        SUBCASE("Large blocks") {
+            check_against_std_deque<my::deque<int, std::allocator<int>, my::large_block_size>>();
+        }
+    }
+
+    TEST_CASE("Deques with different block sizes should be separate types") {
+        using small_deque = my::deque<std::string, std::allocator<std::string>, my::small_block_size>;
+
+        small_deque deq = { "a", "b", "c" };
+        small_deque copy = deq;
+
+        CHECK(copy == deq);
+        CHECK_FALSE((std::is_same_v<small_deque, my::deque<std::string>>));
+    }
+}
@@ -0,0 +1,310 @@
+#include "doctest/doctest.h"
+#include "toy_stl/deque.hpp"
+#include "../test_fixtures.hpp"
+
+#include <deque>
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+    using test::BlockCountingAllocator;
+
+    using counted_deque = my::deque<int, BlockCountingAllocator<int>, my::block_elements<4>>;
+    constexpr std::size_t block_bytes = 4 * sizeof(int);
+}
+
+TEST_SUITE("Deque capacity") {
+    TEST_CASE("Shrink to fit should release all memory of empty deque") {
+        BlockCountingAllocator<int> allocator;
+        counted_deque deq(allocator);
+
+        for (int i = 0; i < 100; ++i) {
+            deq.push_back(i);
+        }
+        deq.clear();
+
+        CHECK(*allocator.allocated > 0);
+
+        deq.shrink_to_fit();
+
+        CHECK(*allocator.allocated == 0);
+        CHECK(deq.empty());
+
+        deq.push_back(1);
+
+        CHECK(deq.front() == 1);
+    }
+
+    TEST_CASE("Shrink to fit should keep elements and release unused blocks") {
+        BlockCountingAllocator<int> allocator;
+        counted_deque deq(allocator);
+        std::deque<int> expected;
+
+        for (int i = 0; i < 1000; ++i) {
+            deq.push_back(i);
+            expected.push_back(i);
+        }
+
+        const auto peak = *allocator.allocated;
+
+        // Elements are left in the middle of array of blocks and wrap around after pushes to the front
+        for (int i = 0; i < 990; ++i) {
+            deq.pop_front();
+            expected.pop_front();
+        }
+        for (int i = 0; i < 7; ++i) {
+            deq.push_front(-i);
+            expected.push_front(-i);
+        }
+
+        deq.shrink_to_fit();
+
+        // 17 elements take at most 6 blocks of 4 elements and array of 8 block pointers
+        CHECK(*allocator.allocated <= 6 * block_bytes + 8 * sizeof(int*));
+        CHECK(*allocator.allocated < peak / 10);
+        REQUIRE(deq.size() == expected.size());
+        CHECK(std::equal(deq.begin(), deq.end(), expected.begin()));
+
+        SUBCASE("Deque should grow after shrinking") {
+            for (int i = 0; i < 100; ++i) {
+                deq.push_back(i);
+                expected.push_back(i);
+                deq.push_front(i);
+                expected.push_front(i);
+            }
+
+            REQUIRE(deq.size() == expected.size());
+            CHECK(std::equal(deq.begin(), deq.end(), expected.begin()));
+        }
+    }
+
+    TEST_CASE("Shrink to fit should work when all blocks are used") {
+        counted_deque deq;
+        for (int i = 0; i < 16; ++i) {
+            deq.push_back(i);
+        }
+
+        deq.shrink_to_fit();
+        deq.shrink_to_fit();
+
+        CHECK(deq.size() == 16);
+        CHECK(deq.back() == 15);
+        CHECK(deq[7] == 7);
+    }
+
+    TEST_CASE("Spare blocks are kept by default") {
+        BlockCountingAllocator<int> allocator;
+        counted_deque deq(allocator);
+
+        for (int i = 0; i < 400; ++i) {
+            deq.push_back(i);
+        }
+        const auto peak = *allocator.allocated;
+
+        deq.erase(deq.begin(), deq.end() - 4);
+
+        CHECK(*allocator.allocated == peak);
+    }
+
+    TEST_CASE("Spare blocks should be released above high watermark") {
+        BlockCountingAllocator<int> allocator;
+        counted_deque deq(allocator);
+        deq.set_spare_blocks_limits(2, 8);
+
+        for (int i = 0; i < 400; ++i) {
+            deq.push_back(i);
+        }
+        const auto blocks_array_bytes = *allocator.allocated - 100 * block_bytes;
+
+        SUBCASE("Popping from the front") {
+            for (int i = 0; i < 32; ++i) {
+                deq.pop_front();
+            }
+
+            // 8 spare blocks are still allowed
+            CHECK(*allocator.allocated == blocks_array_bytes + 100 * block_bytes);
+
+            for (int i = 0; i < 4; ++i) {
+                deq.pop_front();
+            }
+
+            // 9 spare blocks are too many, only 2 of them are left
+            CHECK(*allocator.allocated == blocks_array_bytes + 93 * block_bytes);
+        }
+
+        SUBCASE("Popping from the back") {
+            for (int i = 0; i < 36; ++i) {
+                deq.pop_back();
+            }
+
+            CHECK(*allocator.allocated == blocks_array_bytes + 93 * block_bytes);
+            CHECK(deq.back() == 363);
+        }
+
+        SUBCASE("Clear") {
+            deq.clear();
+
+            CHECK(*allocator.allocated == blocks_array_bytes + 2 * block_bytes);
+        }
+
+        SUBCASE("Erase and resize") {
+            deq.erase(deq.begin() + 10, deq.begin() + 110);
+
+            CHECK(*allocator.allocated == blocks_array_bytes + 77 * block_bytes);
+
+            deq.resize(8);
+
+            CHECK(*allocator.allocated == blocks_array_bytes + 4 * block_bytes);
+        }
+
+        SUBCASE("Deque should still work after releasing blocks") {
+            std::deque<int> expected(deq.begin(), deq.end());
+            for (int i = 0; i < 2000; ++i) {
+                deq.push_back(i);
+                expected.push_back(i);
+                deq.pop_front();
+                expected.pop_front();
+
+                if (i % 3 == 0) {
+                    deq.push_front(i);
+                    expected.push_front(i);
+                    deq.pop_back();
+                    expected.pop_back();
+                }
+            }
+
+            REQUIRE(deq.size() == expected.size());
+            CHECK(std::equal(deq.begin(), deq.end(), expected.begin()));
+        }
+    }
+
+    TEST_CASE("Setting spare blocks limits should release blocks immediately") {
+        BlockCountingAllocator<int> allocator;
+        counted_deque deq(allocator);
+
+        for (int i = 0; i < 400; ++i) {
+            deq.push_back(i);
+        }
+        deq.clear();
+        const auto blocks_array_bytes = *allocator.allocated - 100 * block_bytes;
+
+        deq.set_spare_blocks_limits(0, 0);
+
+        CHECK(*allocator.allocated == blocks_array_bytes);
+    }
+
+    TEST_CASE("Block map stats should describe array of blocks") {
+        counted_deque deq;
+
+        auto stats = deq.block_map_stats();
+        CHECK(stats.map_size == 0);
+        CHECK(stats.allocated_blocks == 0);
+        CHECK(stats.used_blocks == 0);
+        CHECK(stats.map_reallocations == 0);
+
+        for (int i = 0; i < 10; ++i) {
+            deq.push_back(i);
+        }
+
+        stats = deq.block_map_stats();
+        CHECK(stats.map_size == 4);
+        CHECK(stats.used_blocks == 3);
+        CHECK(stats.allocated_blocks >= stats.used_blocks);
+        CHECK(stats.map_reallocations == 2);
+
+        deq.resize(4);
+        deq.shrink_to_fit();
+        CHECK(deq.block_map_stats().map_size == 1);
+        CHECK(deq.block_map_stats().map_reallocations == 3);
+
+        counted_deque other;
+        deq.swap(other);
+        CHECK(deq.block_map_stats().map_reallocations == 0);
+        CHECK(other.block_map_stats().map_reallocations == 3);
+    }
+
+    TEST_CASE("Queue oscillating between front and back should not grow array of blocks") {
+        counted_deque deq;
+        std::deque<int> expected;
+
+        // Up to 20 elements at a time, so 8 blocks of 4 elements are always enough
+        for (int round = 0; round < 200; ++round) {
+            for (int i = 0; i < 20; ++i) {
+                if (round % 2 == 0) {
+                    deq.push_back(i);
+                    expected.push_back(i);
+                } else {
+                    deq.push_front(i);
+                    expected.push_front(i);
+                }
+            }
+            for (int i = 0; i < 20; ++i) {
+                if (round % 3 == 0) {
+                    deq.pop_front();
+                    expected.pop_front();
+                } else {
+                    deq.pop_back();
+                    expected.pop_back();
+                }
+            }
+        }
+
+        const auto stats = deq.block_map_stats();
+        CHECK(stats.map_size <= 8);
+        CHECK(stats.map_reallocations <= 3);
+        CHECK(deq.size() == expected.size());
+    }
+
+    TEST_CASE("Insertions after reserve should not allocate") {
+        BlockCountingAllocator<int> allocator;
+        counted_deque deq(allocator);
+        deq.push_back(0);
+        deq.push_back(1);
+
+        SUBCASE("Back") {
+            deq.reserve_back(30);
+            CHECK(deq.capacity_back() >= 30);
+
+            const auto allocated = *allocator.allocated;
+            for (int i = 0; i < 30; ++i) {
+                deq.push_back(i);
+            }
+            CHECK(*allocator.allocated == allocated);
+            CHECK(deq.size() == 32);
+        }
+
+        SUBCASE("Front") {
+            deq.reserve_front(30);
+            CHECK(deq.capacity_front() >= 30);
+
+            const auto allocated = *allocator.allocated;
+            for (int i = 0; i < 30; ++i) {
+                deq.push_front(i);
+            }
+            CHECK(*allocator.allocated == allocated);
+            CHECK(deq.size() == 32);
+        }
+    }
+
+    TEST_CASE("Capacity back and front should count only allocated blocks") {
+        counted_deque deq;
+        CHECK(deq.capacity_back() == 0);
+        CHECK(deq.capacity_front() == 0);
+
+        // First block is filled from its beginning, so there is no room in front of it
+        deq.push_back(0);
+        CHECK(deq.capacity_back() == 3);
+        CHECK(deq.capacity_front() == 0);
+
+        // One element is left at offset 1 of the second block, first block is spare
+        for (int i = 1; i < 6; ++i) {
+            deq.push_back(i);
+        }
+        for (int i = 0; i < 5; ++i) {
+            deq.pop_front();
+        }
+        CHECK(deq.capacity_back() == 6);
+        CHECK(deq.capacity_front() == 5);
+    }
+}
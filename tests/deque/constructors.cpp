@@ -2,6 +2,8 @@
 #include "toy_stl/deque.hpp"
 
 #include <array>
+#include <string>
+#include <algorithm>
 
 TEST_SUITE("Deque constructors") {
     TEST_CASE("Default constructor should create empty deque") {
@@ -91,6 +93,60 @@ TEST_SUITE("Deque constructors") {
         CHECK(b[2] == a[2]);
     }
 
+    TEST_CASE("Copy should work when elements wrap around array of blocks") {
+        // Begin is in the middle of a block and elements continue from the start of array of blocks
+        auto fill = [](auto& deq) {
+            for (int i = 0; i < 20; ++i) {
+                deq.push_back(i);
+            }
+            for (int i = 0; i < 6; ++i) {
+                deq.pop_front();
+                deq.push_back(20 + i);
+            }
+        };
+
+        SUBCASE("Trivially copyable elements") {
+            my::deque<int, std::allocator<int>, my::block_elements<4>> a;
+            fill(a);
+
+            auto b = a;
+            CHECK(b == a);
+
+            // Assignment reuses blocks of the old elements
+            my::deque<int, std::allocator<int>, my::block_elements<4>> c(100, -1);
+            const auto first_element = &c[0];
+            c = a;
+
+            CHECK(c == a);
+            CHECK(std::find(c.begin(), c.end(), -1) == c.end());
+            CHECK(&c[0] == first_element);
+
+            const auto& same = c;
+            c = same;
+
+            CHECK(c == a);
+        }
+
+        SUBCASE("Elements with non-trivial copy") {
+            my::deque<std::string, std::allocator<std::string>, my::block_elements<4>> a;
+            for (int i = 0; i < 20; ++i) {
+                a.push_back(std::string(30, static_cast<char>('a' + i)));
+            }
+            for (int i = 0; i < 6; ++i) {
+                a.pop_front();
+                a.push_back("short");
+            }
+
+            auto b = a;
+            CHECK(b == a);
+
+            decltype(a) c = { "x", "y" };
+            c = a;
+
+            CHECK(c == a);
+        }
+    }
+
     TEST_CASE("Move constructor should create deque of the same size") {
         SUBCASE("Empty deque") {
             my::deque<int> a;
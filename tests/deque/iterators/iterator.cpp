@@ -102,6 +102,48 @@ TEST_SUITE("Deque iterators") {
         }
     }
 
+    TEST_CASE("Iterators should cross block boundaries") {
+        // Elements are pushed to both ends, so they wrap around array of blocks
+        my::deque<int> deq;
+        for (int i = 0; i < 5000; ++i) {
+            deq.push_back(i);
+            deq.push_front(-i - 1);
+        }
+        REQUIRE(deq.size() == 10000);
+
+        SUBCASE("Forward iteration") {
+            std::size_t i = 0;
+            for (auto it = deq.begin(); it != deq.end(); ++it, ++i) {
+                REQUIRE(*it == deq[i]);
+            }
+
+            CHECK(i == deq.size());
+        }
+
+        SUBCASE("Backward iteration") {
+            std::size_t i = deq.size();
+            for (auto it = deq.end(); it != deq.begin(); ) {
+                --it;
+                --i;
+                REQUIRE(*it == deq[i]);
+            }
+
+            CHECK(i == 0);
+        }
+
+        SUBCASE("Advancing by arbitrary offsets") {
+            auto it = deq.begin();
+            std::size_t i = 0;
+            for (const int step : { 1, 1000, -999, 4097, 3, -2000, 5000 }) {
+                it += step;
+                i += step;
+                REQUIRE(*it == deq[i]);
+                REQUIRE(it - deq.begin() == static_cast<std::ptrdiff_t>(i));
+                REQUIRE(it[-1] == deq[i - 1]);
+            }
+        }
+    }
+
     TEST_CASE("Iterators should satisfy all requirements of random access iterators") {
         CHECK(std::random_access_iterator<my::deque<int>::iterator>);
         CHECK(std::random_access_iterator<my::deque<std::string>::iterator>);
@@ -2,6 +2,14 @@
 #include "toy_stl/deque.hpp"
 
 #include <string>
+#include <list>
+#include <vector>
+#include <deque>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <bit>
 
 TEST_SUITE("Deque modifiers") {
     TEST_CASE("Pushing back values should increase size") {
@@ -500,6 +508,35 @@ TEST_SUITE("Deque modifiers") {
         }
     }
 
+    TEST_CASE("Resize for overwrite should change size and keep old elements") {
+        SUBCASE("Resize up") {
+            my::deque<int> deq = { 1, 2, 3 };
+
+            deq.resize_for_overwrite(5000);
+
+            REQUIRE(deq.size() == 5000);
+            CHECK(deq[0] == 1);
+            CHECK(deq[1] == 2);
+            CHECK(deq[2] == 3);
+        }
+
+        SUBCASE("Resize down") {
+            my::deque<std::string> deq = { "a", "b", "c" };
+
+            deq.resize_for_overwrite(2);
+
+            CHECK(deq == my::deque<std::string>{ "a", "b" });
+        }
+
+        SUBCASE("Non-trivial elements are default constructed") {
+            my::deque<std::string> deq = { "a" };
+
+            deq.resize_for_overwrite(3);
+
+            CHECK(deq == my::deque<std::string>{ "a", "", "" });
+        }
+    }
+
     TEST_CASE("Emplace with begin should add element to front") {
         SUBCASE("Empty deque") {
             my::deque<int> deq;
@@ -645,4 +682,299 @@ TEST_SUITE("Deque modifiers") {
             CHECK(deq == my::deque<int>{ 1, 2, 3, 0, 0, 0 });
         }
     }
-}
\ No newline at end of file
+
+    TEST_CASE("Insert should add range of elements") {
+        SUBCASE("Insert at the front") {
+            my::deque<int> deq = { 1, 2, 3 };
+            const std::list<int> source = { 10, 20 };
+
+            auto it = deq.insert(deq.cbegin(), source.begin(), source.end());
+
+            CHECK(it == deq.begin());
+            CHECK(deq == my::deque<int>{ 10, 20, 1, 2, 3 });
+        }
+
+        SUBCASE("Insert at the back") {
+            my::deque<int> deq = { 1, 2, 3 };
+            const std::list<int> source = { 10, 20 };
+
+            auto it = deq.insert(deq.cend(), source.begin(), source.end());
+
+            CHECK(it == deq.begin() + 3);
+            CHECK(deq == my::deque<int>{ 1, 2, 3, 10, 20 });
+        }
+
+        SUBCASE("Insert in the middle") {
+            my::deque<int> deq = { 1, 2, 3, 4, 5, 6 };
+            const std::list<int> source = { 10, 20, 30, 40 };
+
+            auto it1 = deq.insert(deq.cbegin() + 1, source.begin(), source.end());
+            CHECK(it1 == deq.begin() + 1);
+            CHECK(deq == my::deque<int>{ 1, 10, 20, 30, 40, 2, 3, 4, 5, 6 });
+
+            auto it2 = deq.insert(deq.cend() - 1, source.begin(), source.end());
+            CHECK(it2 == deq.end() - 5);
+            CHECK(deq == my::deque<int>{ 1, 10, 20, 30, 40, 2, 3, 4, 5, 10, 20, 30, 40, 6 });
+        }
+
+        SUBCASE("Insert single pass range") {
+            std::istringstream stream("10 20");
+            my::deque<int> deq = { 1, 2, 3 };
+
+            auto it = deq.insert(deq.cbegin() + 1, std::istream_iterator<int>(stream), std::istream_iterator<int>{ });
+
+            CHECK(it == deq.begin() + 1);
+            CHECK(deq == my::deque<int>{ 1, 10, 20, 2, 3 });
+        }
+    }
+
+    TEST_CASE("Range modifiers should add elements") {
+        SUBCASE("Append range") {
+            my::deque<int> deq = { 1, 2, 3 };
+
+            deq.append_range(std::views::iota(4, 7));
+
+            CHECK(deq == my::deque<int>{ 1, 2, 3, 4, 5, 6 });
+        }
+
+        SUBCASE("Prepend range") {
+            my::deque<int> deq = { 1, 2, 3 };
+
+            deq.prepend_range(std::views::iota(-2, 1));
+
+            CHECK(deq == my::deque<int>{ -2, -1, 0, 1, 2, 3 });
+        }
+
+        SUBCASE("Insert range") {
+            my::deque<int> deq = { 1, 2, 3 };
+
+            auto it = deq.insert_range(deq.cbegin() + 2, std::list<int>{ 10, 20 });
+
+            CHECK(it == deq.begin() + 2);
+            CHECK(deq == my::deque<int>{ 1, 2, 10, 20, 3 });
+        }
+
+        SUBCASE("Single pass ranges") {
+            std::istringstream stream("10 20 30");
+            my::deque<int> deq = { 1, 2, 3 };
+
+            deq.prepend_range(std::views::istream<int>(stream));
+
+            CHECK(deq == my::deque<int>{ 10, 20, 30, 1, 2, 3 });
+        }
+
+        SUBCASE("Assign range") {
+            my::deque<std::string> deq = { "a", "b", "c" };
+
+            deq.assign_range(std::list<std::string>{ "x", "y" });
+            CHECK(deq == my::deque<std::string>{ "x", "y" });
+
+            deq.assign_range(std::list<std::string>{ "1", "2", "3", "4" });
+            CHECK(deq == my::deque<std::string>{ "1", "2", "3", "4" });
+        }
+    }
+
+    TEST_CASE("Range modifiers should work across many blocks") {
+        // Enough elements to fill several blocks and wrap around the array of blocks
+        constexpr int count = 3 * my::deque<int>::block_size;
+
+        std::deque<int> expected;
+        my::deque<int> deq;
+
+        for (int step = 0; step < 12; ++step) {
+            const auto values = std::views::iota(step * count, step * count + count / (step % 3 + 1));
+            const auto offset = (step * 7919) % (expected.size() + 1);
+
+            switch (step % 4) {
+            case 0:
+                deq.append_range(values);
+                expected.insert(expected.end(), values.begin(), values.end());
+                break;
+            case 1:
+                deq.prepend_range(values);
+                expected.insert(expected.begin(), values.begin(), values.end());
+                break;
+            case 2:
+                deq.insert_range(deq.cbegin() + offset, values);
+                expected.insert(expected.begin() + offset, values.begin(), values.end());
+                break;
+            case 3:
+                // Remove some elements from the front, so begin is not at the start of the block
+                for (int i = 0; i < count / 2; ++i) {
+                    deq.pop_front();
+                    expected.pop_front();
+                }
+                break;
+            }
+
+            REQUIRE(deq.size() == expected.size());
+            CHECK(std::equal(deq.begin(), deq.end(), expected.begin(), expected.end()));
+        }
+    }
+
+    TEST_CASE("Elements with size that is not power of two should use power of two blocks") {
+        struct Triple
+        {
+            int a, b, c;
+            bool operator== (const Triple&) const = default;
+        };
+        static_assert(std::has_single_bit(my::deque<Triple>::block_size));
+
+        std::deque<Triple> expected;
+        my::deque<Triple> deq;
+
+        for (int i = 0; i < 5000; ++i) {
+            deq.push_back(Triple { i, i, i });
+            expected.push_back(Triple { i, i, i });
+
+            if (i % 3 == 0) {
+                deq.push_front(Triple { -i, -i, -i });
+                expected.push_front(Triple { -i, -i, -i });
+            }
+
+            if (i % 5 == 0) {
+                deq.pop_front();
+                expected.pop_front();
+            }
+        }
+
+        REQUIRE(deq.size() == expected.size());
+        CHECK(std::equal(deq.begin(), deq.end(), expected.begin(), expected.end()));
+
+        my::deque<Triple> copy(deq);
+        CHECK(copy == deq);
+
+        copy.push_front(Triple { 1, 2, 3 });
+        copy.push_back(Triple { 4, 5, 6 });
+        CHECK(copy.front() == Triple { 1, 2, 3 });
+        CHECK(copy.back() == Triple { 4, 5, 6 });
+    }
+
+    TEST_CASE("Insert and erase in the middle should shift elements across blocks") {
+        // Small blocks, so that shifted runs cross many block boundaries and wrap around the array of blocks
+        auto check = [](auto element) {
+            using T = decltype(element);
+            my::deque<T, std::allocator<T>, my::block_elements<4>> deq;
+            std::deque<T> expected;
+
+            auto make = [](int i) {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return std::to_string(i);
+                } else {
+                    return i;
+                }
+            };
+
+            for (int i = 0; i < 40; ++i) {
+                deq.push_back(make(i));
+                expected.push_back(make(i));
+            }
+            for (int i = 0; i < 10; ++i) {
+                deq.pop_front();
+                expected.pop_front();
+            }
+
+            unsigned state = 1;
+            auto random = [&state](std::size_t bound) {
+                state = state * 1103515245 + 12345;
+                return static_cast<std::size_t>((state >> 16) % bound);
+            };
+
+            for (int step = 0; step < 300; ++step) {
+                const auto pos = random(expected.size() + 1);
+                // Not zero, std::deque of libstdc++ 12 breaks elements when inserting zero copies in the middle
+                const auto count = random(10) + 1;
+
+                switch (step % 4) {
+                case 0:
+                    deq.insert(deq.begin() + pos, count, make(-step));
+                    expected.insert(expected.begin() + pos, count, make(-step));
+                    break;
+                case 1: {
+                    std::vector<T> values;
+                    for (std::size_t i = 0; i < count; ++i) {
+                        values.push_back(make(step * 100 + static_cast<int>(i)));
+                    }
+                    deq.insert(deq.begin() + pos, values.begin(), values.end());
+                    expected.insert(expected.begin() + pos, values.begin(), values.end());
+                    break;
+                }
+                case 2:
+                    deq.emplace(deq.begin() + pos, make(step));
+                    expected.emplace(expected.begin() + pos, make(step));
+                    break;
+                case 3: {
+                    const auto erased = std::min(count * 2, expected.size() - std::min(pos, expected.size()));
+                    deq.erase(deq.begin() + pos, deq.begin() + pos + erased);
+                    expected.erase(expected.begin() + pos, expected.begin() + pos + erased);
+                    break;
+                }
+                }
+
+                REQUIRE(deq.size() == expected.size());
+                REQUIRE(std::equal(deq.begin(), deq.end(), expected.begin()));
+            }
+        };
+
+        check(0);
+        check(std::string());
+    }
+
+    TEST_CASE("Erase from the middle of deque with filled memory should work") {
+        my::deque<int, std::allocator<int>, my::block_elements<4>> deq;
+        for (int i = 0; i < 8; ++i) {
+            deq.push_back(i);
+        }
+
+        deq.erase(deq.begin() + 5);
+        CHECK(deq == my::deque<int, std::allocator<int>, my::block_elements<4>> { 0, 1, 2, 3, 4, 6, 7 });
+    }
+
+    TEST_CASE("Emplace back n should add generated elements") {
+        my::deque<std::string, std::allocator<std::string>, my::block_elements<4>> deq { "a", "b" };
+        int next = 0;
+
+        deq.emplace_back_n(10, [&next] { return std::to_string(next++); });
+
+        REQUIRE(deq.size() == 12);
+        CHECK(deq.front() == "a");
+        for (int i = 0; i < 10; ++i) {
+            CHECK(deq[i + 2] == std::to_string(i));
+        }
+
+        deq.emplace_back_n(0, [&next] { return std::to_string(next++); });
+        CHECK(deq.size() == 12);
+        CHECK(next == 10);
+    }
+
+    TEST_CASE("Emplace front n should keep order of generated elements") {
+        my::deque<int, std::allocator<int>, my::block_elements<4>> deq { 100, 101 };
+        int next = 0;
+
+        deq.emplace_front_n(10, [&next] { return next++; });
+
+        CHECK(deq == my::deque<int, std::allocator<int>, my::block_elements<4>> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 100, 101 });
+    }
+
+    TEST_CASE("Emplace n should leave deque unchanged if generator throws") {
+        my::deque<std::string, std::allocator<std::string>, my::block_elements<4>> deq { "a", "b", "c" };
+        int next = 0;
+        const auto generator = [&next] {
+            if (next == 7) {
+                throw std::runtime_error("Generator failed");
+            }
+            return std::to_string(next++);
+        };
+
+        CHECK_THROWS_AS(deq.emplace_back_n(10, generator), std::runtime_error);
+        CHECK(deq == my::deque<std::string, std::allocator<std::string>, my::block_elements<4>> { "a", "b", "c" });
+
+        next = 0;
+        CHECK_THROWS_AS(deq.emplace_front_n(10, generator), std::runtime_error);
+        CHECK(deq == my::deque<std::string, std::allocator<std::string>, my::block_elements<4>> { "a", "b", "c" });
+
+        deq.push_front("z");
+        deq.push_back("d");
+        CHECK(deq == my::deque<std::string, std::allocator<std::string>, my::block_elements<4>> { "z", "a", "b", "c", "d" });
+    }
+}
@@ -0,0 +1,160 @@
+#include "doctest/doctest.h"
+#include "toy_stl/deque.hpp"
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <ranges>
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    using small_deque = my::deque<int, std::allocator<int>, my::block_elements<4>>;
+
+    // Elements wrap around the array of blocks and begin is in the middle of a block
+    small_deque make_wrapped_deque(int count)
+    {
+        small_deque deq;
+        for (int i = 0; i < count; ++i) {
+            deq.push_back(i);
+        }
+        for (int i = 0; i < 3; ++i) {
+            deq.pop_front();
+            deq.push_back(count + i);
+        }
+
+        return deq;
+    }
+}
+
+static_assert(std::ranges::forward_range<small_deque::segments_type>);
+static_assert(std::ranges::forward_range<small_deque::const_segments_type>);
+static_assert(std::same_as<std::ranges::range_value_t<small_deque::const_segments_type>, std::span<const int>>);
+
+TEST_SUITE("Deque segments") {
+    TEST_CASE("Segments should cover all elements in order") {
+        const auto deq = make_wrapped_deque(30);
+
+        std::vector<int> elements;
+        std::size_t segments_count = 0;
+        for (const auto segment : deq.segments()) {
+            CHECK_FALSE(segment.empty());
+            CHECK(segment.size() <= small_deque::block_size);
+            elements.insert(elements.end(), segment.begin(), segment.end());
+            ++segments_count;
+        }
+
+        CHECK(segments_count == 9);
+        CHECK(std::equal(elements.begin(), elements.end(), deq.begin(), deq.end()));
+    }
+
+    TEST_CASE("Segments of empty deque should be empty") {
+        small_deque deq;
+
+        CHECK(deq.segments().empty());
+        CHECK(deq.segments().begin() == deq.segments().end());
+    }
+
+    TEST_CASE("Segments can be used to modify elements") {
+        auto deq = make_wrapped_deque(10);
+
+        for (auto segment : deq.segments()) {
+            for (auto& element : segment) {
+                element *= 2;
+            }
+        }
+
+        CHECK(deq.front() == 6);
+        CHECK(deq.back() == 24);
+    }
+
+    TEST_CASE("Copy should copy every segment") {
+        const auto deq = make_wrapped_deque(30);
+
+        std::vector<int> to_pointer(deq.size());
+        my::copy(deq.begin(), deq.end(), to_pointer.data());
+
+        std::vector<int> to_back_inserter;
+        my::copy(deq.begin() + 5, deq.end() - 5, std::back_inserter(to_back_inserter));
+
+        CHECK(std::equal(to_pointer.begin(), to_pointer.end(), deq.begin(), deq.end()));
+        CHECK(std::equal(to_back_inserter.begin(), to_back_inserter.end(), deq.begin() + 5, deq.end() - 5));
+    }
+
+    TEST_CASE("Fill should fill only given range") {
+        auto deq = make_wrapped_deque(30);
+
+        my::fill(deq.begin() + 2, deq.end() - 3, -1);
+
+        CHECK(deq[1] == 4);
+        CHECK(deq[2] == -1);
+        CHECK(deq[26] == -1);
+        CHECK(deq[27] == 30);
+        CHECK(std::count(deq.begin(), deq.end(), -1) == 25);
+    }
+
+    TEST_CASE("Find should return iterator to the first match") {
+        const auto deq = make_wrapped_deque(30);
+
+        CHECK(my::find(deq.begin(), deq.end(), 3) == deq.begin());
+        CHECK(my::find(deq.begin(), deq.end(), 17) == deq.begin() + 14);
+        CHECK(my::find(deq.begin(), deq.end(), 100) == deq.end());
+        CHECK(my::find(deq.begin(), deq.begin() + 5, 17) == deq.begin() + 5);
+    }
+
+    TEST_CASE("For each should visit elements in order") {
+        const auto deq = make_wrapped_deque(30);
+
+        std::vector<int> visited;
+        my::for_each(deq.begin(), deq.end(), [&](int element) { visited.push_back(element); });
+
+        CHECK(std::equal(visited.begin(), visited.end(), deq.begin(), deq.end()));
+    }
+
+    TEST_CASE("Equal should compare ranges with different segments") {
+        const auto a = make_wrapped_deque(30);
+        my::deque<int> b(a.begin(), a.end());
+        const std::vector<int> c(a.begin(), a.end());
+
+        CHECK(my::equal(a.begin(), a.end(), b.begin()));
+        CHECK(my::equal(a.begin(), a.end(), c.begin(), c.end()));
+        CHECK(my::equal(c.begin(), c.end(), a.begin(), a.end()));
+        CHECK_FALSE(my::equal(a.begin(), a.end(), c.begin(), c.end() - 1));
+
+        b[20] = -1;
+
+        CHECK_FALSE(my::equal(a.begin(), a.end(), b.begin()));
+        CHECK(my::equal(a.begin(), a.begin() + 20, b.begin()));
+    }
+
+    TEST_CASE("Three way comparison should find first mismatch across segments") {
+        const auto a = make_wrapped_deque(30);
+        auto b = make_wrapped_deque(30);
+
+        CHECK((a <=> b) == std::strong_ordering::equal);
+
+        b[17] += 1;
+
+        CHECK((a <=> b) == std::strong_ordering::less);
+        CHECK((b <=> a) == std::strong_ordering::greater);
+
+        b[17] -= 1;
+        b.pop_back();
+
+        CHECK((a <=> b) == std::strong_ordering::greater);
+        CHECK(my::lexicographical_compare_three_way(b.begin(), b.end(), a.begin(), a.end(), std::compare_three_way { }) < 0);
+    }
+
+    TEST_CASE("Algorithms should work for types that are not bitwise comparable") {
+        my::deque<std::string, std::allocator<std::string>, my::block_elements<2>> a = { "a", "b", "c", "d", "e" };
+        auto b = a;
+
+        CHECK(a == b);
+
+        b[3] = "z";
+
+        CHECK(a < b);
+        CHECK(my::find(a.cbegin(), a.cend(), "c") == a.cbegin() + 2);
+    }
+}
@@ -0,0 +1,325 @@
+#include "doctest/doctest.h"
+#include "toy_stl/journaled_deque.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <sys/resource.h>
+
+namespace
+{
+    // Empty directory that is removed together with the test
+    struct TemporaryDirectory
+    {
+        TemporaryDirectory()
+        {
+            std::string name = (std::filesystem::temp_directory_path() / "toy_stl_journal_test_XXXXXX").string();
+            path = ::mkdtemp(name.data());
+        }
+
+        ~TemporaryDirectory()
+        {
+            std::filesystem::remove_all(path);
+        }
+
+        std::filesystem::path path;
+    };
+
+    struct Task
+    {
+        int id;
+        int priority;
+    };
+
+    // Commits only when asked, so tests decide what is durable
+    my::deque_journal_options manual_commit_options()
+    {
+        my::deque_journal_options options;
+        options.commit_operations = 1'000'000;
+        options.commit_interval = std::chrono::hours(1);
+        return options;
+    }
+
+    std::size_t segments_count(const std::filesystem::path& directory)
+    {
+        std::size_t count = 0;
+        for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator(directory)) {
+            ++count;
+        }
+        return count;
+    }
+
+    std::filesystem::path last_segment(const std::filesystem::path& directory)
+    {
+        std::filesystem::path last;
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            last = std::max(last, entry.path());
+        }
+        return last;
+    }
+
+    // Makes writes past size fail with EFBIG while it exists, like a full disk
+    struct FileSizeLimit
+    {
+        explicit FileSizeLimit(std::size_t size)
+        {
+            previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+            ::getrlimit(RLIMIT_FSIZE, &previous_limit);
+
+            ::rlimit limit = previous_limit;
+            limit.rlim_cur = static_cast<rlim_t>(size);
+            ::setrlimit(RLIMIT_FSIZE, &limit);
+        }
+
+        ~FileSizeLimit()
+        {
+            ::setrlimit(RLIMIT_FSIZE, &previous_limit);
+            std::signal(SIGXFSZ, previous_handler);
+        }
+
+        ::rlimit previous_limit;
+        void (*previous_handler)(int);
+    };
+}
+
+TEST_SUITE("Journaled deque") {
+    TEST_CASE("Committed operations should be recovered") {
+        TemporaryDirectory directory;
+
+        {
+            my::journaled_deque<Task> journal(directory.path, manual_commit_options());
+            CHECK(journal.empty());
+
+            for (int i = 0; i < 10; ++i) {
+                journal.push_back(Task { i, i * 10 });
+            }
+            journal.pop_front();
+            journal.pop_front();
+            journal.pop_front();
+
+            CHECK(journal.pending_operations() == 13);
+            journal.commit();
+            CHECK(journal.pending_operations() == 0);
+        }
+
+        my::journaled_deque<Task> journal(directory.path, manual_commit_options());
+        REQUIRE(journal.size() == 7);
+        CHECK(journal.front().id == 3);
+        CHECK(journal.back().id == 9);
+        CHECK(journal.back().priority == 90);
+        for (int i = 0; i < 7; ++i) {
+            CHECK(journal.items()[i].id == i + 3);
+        }
+    }
+
+    TEST_CASE("Operations should be committed by count") {
+        TemporaryDirectory directory;
+        auto options = manual_commit_options();
+        options.commit_operations = 4;
+
+        my::journaled_deque<int> journal(directory.path, options);
+        for (int i = 0; i < 3; ++i) {
+            journal.push_back(i);
+        }
+        CHECK(journal.pending_operations() == 3);
+
+        journal.pop_front();
+        CHECK(journal.pending_operations() == 0);
+    }
+
+    TEST_CASE("Operations should be committed by time") {
+        TemporaryDirectory directory;
+        auto options = manual_commit_options();
+        options.commit_interval = std::chrono::microseconds(0);
+
+        my::journaled_deque<int> journal(directory.path, options);
+        journal.push_back(1);
+        CHECK(journal.pending_operations() == 0);
+    }
+
+    TEST_CASE("Torn frame at the end of journal should be discarded") {
+        TemporaryDirectory directory;
+
+        {
+            my::journaled_deque<int> journal(directory.path, manual_commit_options());
+            for (int i = 0; i < 5; ++i) {
+                journal.push_back(i);
+            }
+            journal.commit();
+        }
+
+        // Crash in the middle of the next commit leaves part of a frame
+        {
+            std::ofstream segment(last_segment(directory.path), std::ios::binary | std::ios::app);
+            const char garbage[20] = { 1, 2, 3, 4, 5 };
+            segment.write(garbage, sizeof(garbage));
+        }
+
+        {
+            my::journaled_deque<int> journal(directory.path, manual_commit_options());
+            REQUIRE(journal.size() == 5);
+            CHECK(journal.back() == 4);
+
+            // New frames go after the last complete one
+            journal.push_back(5);
+            journal.pop_front();
+            journal.commit();
+        }
+
+        my::journaled_deque<int> journal(directory.path, manual_commit_options());
+        REQUIRE(journal.size() == 5);
+        CHECK(journal.front() == 1);
+        CHECK(journal.back() == 5);
+    }
+
+    TEST_CASE("Commit after failed commit should be recovered") {
+        TemporaryDirectory directory;
+
+        {
+            my::journaled_deque<int> journal(directory.path, manual_commit_options());
+            journal.push_back(0);
+            journal.commit();
+
+            for (int i = 1; i < 100; ++i) {
+                journal.push_back(i);
+            }
+
+            // Only part of the frame fits, it must not be left in the file
+            {
+                FileSizeLimit limit(std::filesystem::file_size(last_segment(directory.path)) + 100);
+                CHECK_THROWS_AS(journal.commit(), std::system_error);
+            }
+            CHECK(journal.pending_operations() == 99);
+
+            journal.commit();
+            journal.push_back(100);
+            journal.commit();
+        }
+
+        my::journaled_deque<int> journal(directory.path, manual_commit_options());
+        REQUIRE(journal.size() == 101);
+        for (int i = 0; i < 101; ++i) {
+            CHECK(journal.items()[i] == i);
+        }
+    }
+
+    TEST_CASE("Failed automatic commit should be thrown by the next operation") {
+        TemporaryDirectory directory;
+        auto options = manual_commit_options();
+        options.commit_operations = 4;
+
+        {
+            my::journaled_deque<int> journal(directory.path, options);
+
+            {
+                FileSizeLimit limit(std::filesystem::file_size(last_segment(directory.path)));
+                for (int i = 0; i < 3; ++i) {
+                    journal.push_back(i);
+                }
+
+                // Operation that triggers failed commit is applied, the next ones are not
+                CHECK_NOTHROW(journal.push_back(3));
+                CHECK_THROWS_AS(journal.push_back(4), std::system_error);
+                CHECK_THROWS_AS(journal.pop_front(), std::system_error);
+                CHECK(journal.size() == 4);
+                CHECK(journal.pending_operations() == 4);
+
+                CHECK_THROWS_AS(journal.commit(), std::system_error);
+                CHECK_THROWS_AS(journal.push_back(4), std::system_error);
+            }
+
+            journal.commit();
+            CHECK(journal.pending_operations() == 0);
+
+            journal.push_back(4);
+            journal.pop_front();
+            journal.commit();
+        }
+
+        my::journaled_deque<int> journal(directory.path, options);
+        REQUIRE(journal.size() == 4);
+        for (int i = 0; i < 4; ++i) {
+            CHECK(journal.items()[i] == i + 1);
+        }
+    }
+
+    TEST_CASE("Popped segments should be removed") {
+        TemporaryDirectory directory;
+        auto options = manual_commit_options();
+        options.segment_bytes = 256;
+        options.sync = false;
+
+        {
+            my::journaled_deque<int> journal(directory.path, options);
+            for (int i = 0; i < 1000; ++i) {
+                journal.push_back(i);
+                if (i % 10 == 9) {
+                    journal.commit();
+                }
+            }
+            CHECK(segments_count(directory.path) > 10);
+
+            for (int i = 0; i < 990; ++i) {
+                journal.pop_front();
+                if (i % 10 == 9) {
+                    journal.commit();
+                }
+            }
+            CHECK(segments_count(directory.path) <= 2);
+        }
+
+        my::journaled_deque<int> journal(directory.path, options);
+        REQUIRE(journal.size() == 10);
+        for (int i = 0; i < 10; ++i) {
+            CHECK(journal.items()[i] == 990 + i);
+        }
+    }
+
+    TEST_CASE("Random workload should be recovered after every reopen") {
+        TemporaryDirectory directory;
+        auto options = manual_commit_options();
+        options.commit_operations = 37;
+        options.segment_bytes = 1024;
+        options.sync = false;
+
+        std::deque<int> expected;
+        std::mt19937 generator(7);
+        int next = 0;
+
+        for (int round = 0; round < 20; ++round) {
+            my::journaled_deque<int> journal(directory.path, options);
+            REQUIRE(journal.size() == expected.size());
+            REQUIRE(std::equal(journal.items().begin(), journal.items().end(), expected.begin()));
+
+            for (int i = 0; i < 300; ++i) {
+                if (generator() % 3 != 0 || expected.empty()) {
+                    journal.push_back(next);
+                    expected.push_back(next);
+                    ++next;
+                } else {
+                    journal.pop_front();
+                    expected.pop_front();
+                }
+            }
+        }
+    }
+
+    TEST_CASE("Journal of different record type should not be opened") {
+        TemporaryDirectory directory;
+
+        {
+            my::journaled_deque<int> journal(directory.path, manual_commit_options());
+            journal.push_back(1);
+        }
+
+        CHECK_THROWS_AS(my::journaled_deque<Task>(directory.path, manual_commit_options()), std::runtime_error);
+    }
+}
@@ -0,0 +1,145 @@
+#include "doctest/doctest.h"
+#include "toy_stl/small_vector.hpp"
+#include "../test_fixtures.hpp"
+
+#include <string>
+#include <memory>
+#include <list>
+#include <utility>
+
+using test::CountingAllocator;
+
+TEST_SUITE("Small vector") {
+    TEST_CASE("Elements that fit into inline capacity do not allocate") {
+        CountingAllocator<int> allocator;
+        my::small_vector<int, 8, CountingAllocator<int>> vec(allocator);
+
+        for (int i = 0; i < 8; ++i) {
+            vec.push_back(i);
+        }
+
+        CHECK(*allocator.allocations == 0);
+        CHECK(vec.is_inline());
+        CHECK(vec.capacity() == 8);
+        CHECK(vec == my::small_vector<int, 8, CountingAllocator<int>> { 0, 1, 2, 3, 4, 5, 6, 7 });
+    }
+
+    TEST_CASE("Elements spill to the heap when inline capacity is exceeded") {
+        CountingAllocator<int> allocator;
+        my::small_vector<int, 4, CountingAllocator<int>> vec(allocator);
+
+        for (int i = 0; i < 5; ++i) {
+            vec.push_back(i);
+        }
+
+        CHECK(*allocator.allocations == 1);
+        CHECK_FALSE(vec.is_inline());
+        CHECK(vec.capacity() >= 5);
+        CHECK(vec == my::small_vector<int, 4, CountingAllocator<int>> { 0, 1, 2, 3, 4 });
+    }
+
+    TEST_CASE("Vector modifiers work on inline and heap memory") {
+        my::small_vector<std::string, 4> vec = { "a", "b", "c" };
+
+        vec.insert(vec.cbegin() + 1, "x");
+        CHECK(vec.is_inline());
+        CHECK(vec == my::small_vector<std::string, 4> { "a", "x", "b", "c" });
+
+        vec.insert_range(vec.cend(), std::list<std::string> { "y", "z" });
+        CHECK_FALSE(vec.is_inline());
+        CHECK(vec == my::small_vector<std::string, 4> { "a", "x", "b", "c", "y", "z" });
+
+        vec.erase(vec.cbegin(), vec.cbegin() + 2);
+        vec.emplace(vec.cbegin(), 3, 'q');
+        CHECK(vec == my::small_vector<std::string, 4> { "qqq", "b", "c", "y", "z" });
+    }
+
+    TEST_CASE("Copying small vector") {
+        SUBCASE("Inline elements") {
+            const my::small_vector<std::string, 4> a = { "a", "b" };
+            my::small_vector<std::string, 4> b = a;
+
+            CHECK(b == a);
+            CHECK(b.is_inline());
+            CHECK(b.data() != a.data());
+        }
+
+        SUBCASE("Heap elements") {
+            const my::small_vector<std::string, 2> a = { "a", "b", "c" };
+            my::small_vector<std::string, 2> b;
+            b = a;
+
+            CHECK(b == a);
+            CHECK(b.data() != a.data());
+        }
+    }
+
+    TEST_CASE("Moving small vector") {
+        SUBCASE("Inline elements are moved one by one") {
+            my::small_vector<std::string, 4> a = { "a", "b" };
+            my::small_vector<std::string, 4> b = std::move(a);
+
+            CHECK(b == my::small_vector<std::string, 4> { "a", "b" });
+            CHECK(b.is_inline());
+            CHECK(a.empty());
+        }
+
+        SUBCASE("Heap memory changes owner") {
+            my::small_vector<std::string, 2> a = { "a", "b", "c" };
+            const auto* data = a.data();
+            my::small_vector<std::string, 2> b = std::move(a);
+
+            CHECK(b == my::small_vector<std::string, 2> { "a", "b", "c" });
+            CHECK(b.data() == data);
+            CHECK(a.empty());
+            CHECK(a.is_inline());
+
+            // Moved-from vector is still usable
+            a.push_back("d");
+            CHECK(a == my::small_vector<std::string, 2> { "d" });
+        }
+
+        SUBCASE("Move assignment") {
+            my::small_vector<std::string, 2> a = { "a", "b", "c" };
+            my::small_vector<std::string, 2> b = { "x" };
+            my::small_vector<std::string, 2> c = { "y", "z", "w" };
+
+            b = std::move(a);
+            CHECK(b == my::small_vector<std::string, 2> { "a", "b", "c" });
+
+            c = std::move(b);
+            CHECK(c == my::small_vector<std::string, 2> { "a", "b", "c" });
+        }
+    }
+
+    TEST_CASE("Swapping small vectors") {
+        my::small_vector<int, 2> inline_a = { 1 };
+        my::small_vector<int, 2> inline_b = { 2, 3 };
+        my::small_vector<int, 2> heap_a = { 4, 5, 6 };
+        my::small_vector<int, 2> heap_b = { 7, 8, 9, 10 };
+
+        inline_a.swap(inline_b);
+        CHECK(inline_a == my::small_vector<int, 2> { 2, 3 });
+        CHECK(inline_b == my::small_vector<int, 2> { 1 });
+
+        inline_a.swap(heap_a);
+        CHECK(inline_a == my::small_vector<int, 2> { 4, 5, 6 });
+        CHECK(heap_a == my::small_vector<int, 2> { 2, 3 });
+
+        inline_a.swap(heap_b);
+        CHECK(inline_a == my::small_vector<int, 2> { 7, 8, 9, 10 });
+        CHECK(heap_b == my::small_vector<int, 2> { 4, 5, 6 });
+    }
+
+    TEST_CASE("Shrinking small vector moves elements back to inline memory") {
+        my::small_vector<int, 4> vec = { 1, 2, 3, 4, 5, 6 };
+        REQUIRE_FALSE(vec.is_inline());
+
+        vec.resize(3);
+        vec.shrink_to_fit();
+
+        CHECK(vec.is_inline());
+        CHECK(vec.capacity() == 4);
+        CHECK(vec == my::small_vector<int, 4> { 1, 2, 3 });
+    }
+}
@@ -0,0 +1,195 @@
+#include "doctest/doctest.h"
+#include "toy_stl/spill_deque.hpp"
+
+#include <deque>
+#include <filesystem>
+#include <random>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // Empty directory that is removed together with the test
+    struct TemporaryDirectory
+    {
+        TemporaryDirectory()
+        {
+            std::string name = (std::filesystem::temp_directory_path() / "toy_stl_spill_test_XXXXXX").string();
+            path = ::mkdtemp(name.data());
+        }
+
+        ~TemporaryDirectory()
+        {
+            std::filesystem::remove_all(path);
+        }
+
+        std::filesystem::path path;
+    };
+
+    struct Record
+    {
+        int id;
+        double value;
+    };
+
+    // 4 elements in a block, so that a few hundred elements span many blocks
+    using small_spill_deque = my::spill_deque<int, std::allocator<int>, my::block_elements<4>>;
+}
+
+TEST_SUITE("Spill deque") {
+    TEST_CASE("Push and pop should work like a queue") {
+        TemporaryDirectory directory;
+        small_spill_deque deq(directory.path, 1, 4);
+
+        for (int i = 0; i < 1000; ++i) {
+            deq.push_back(i);
+        }
+
+        REQUIRE(deq.size() == 1000);
+        CHECK(deq.front() == 0);
+        CHECK(deq.back() == 999);
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(deq[i] == i);
+        }
+
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(deq.front() == i);
+            deq.pop_front();
+        }
+        CHECK(deq.empty());
+    }
+
+    TEST_CASE("Only blocks near the ends should stay in RAM") {
+        TemporaryDirectory directory;
+        small_spill_deque deq(directory.path, 2, 8);
+
+        for (int i = 0; i < 400; ++i) {
+            deq.push_back(i);
+        }
+
+        // 100 blocks, 2 at each end are hot
+        CHECK(deq.ram_blocks_count() == 4);
+        CHECK(deq.spilled_blocks_count() == 96);
+        CHECK(deq.segments_count() == 12);
+
+        // Popping brings spilled blocks back to RAM as they reach the front
+        for (int i = 0; i < 200; ++i) {
+            deq.pop_front();
+        }
+        CHECK(deq.ram_blocks_count() == 4);
+        CHECK(deq.spilled_blocks_count() == 46);
+        CHECK(deq.front() == 200);
+        CHECK(deq.back() == 399);
+
+        deq.clear();
+        CHECK(deq.empty());
+        CHECK(deq.ram_blocks_count() == 0);
+        CHECK(deq.spilled_blocks_count() == 0);
+        CHECK(deq.segments_count() == 0);
+    }
+
+    TEST_CASE("Segment files should not be left in directory") {
+        TemporaryDirectory directory;
+        small_spill_deque deq(directory.path, 1, 4);
+
+        for (int i = 0; i < 100; ++i) {
+            deq.push_back(i);
+        }
+
+        CHECK(deq.spilled_blocks_count() > 0);
+        CHECK(std::filesystem::is_empty(directory.path));
+    }
+
+    TEST_CASE("Drained segments should be released") {
+        TemporaryDirectory directory;
+        small_spill_deque deq(directory.path, 1, 4);
+
+        for (int i = 0; i < 400; ++i) {
+            deq.push_back(i);
+        }
+        CHECK(deq.segments_count() == 25);
+
+        for (int i = 0; i < 396; ++i) {
+            deq.pop_front();
+        }
+
+        // Only the spare segment is left
+        CHECK(deq.spilled_blocks_count() == 0);
+        CHECK(deq.segments_count() == 1);
+        CHECK(deq.front() == 396);
+
+        // Backlog grows again into the spare segment first
+        for (int i = 400; i < 440; ++i) {
+            deq.push_back(i);
+        }
+        CHECK(deq.segments_count() == 3);
+        for (int i = 0; i < 44; ++i) {
+            REQUIRE(deq[i] == 396 + i);
+        }
+    }
+
+    TEST_CASE("Random operations at both ends should match std::deque") {
+        TemporaryDirectory directory;
+        my::spill_deque<Record, std::allocator<Record>, my::block_elements<4>> deq(directory.path, 1, 2);
+        std::deque<Record> expected;
+
+        std::mt19937 generator(42);
+        for (int i = 0; i < 20000; ++i) {
+            const auto operation = generator() % 10;
+            const Record record { i, i * 0.5 };
+
+            // Pushes are more likely, so deque grows and spills
+            if (operation < 3) {
+                deq.push_back(record);
+                expected.push_back(record);
+            } else if (operation < 6) {
+                deq.push_front(record);
+                expected.push_front(record);
+            } else if (operation < 8 && !expected.empty()) {
+                deq.pop_back();
+                expected.pop_back();
+            } else if (!expected.empty()) {
+                deq.pop_front();
+                expected.pop_front();
+            }
+
+            REQUIRE(deq.size() == expected.size());
+            if (!expected.empty()) {
+                REQUIRE(deq.front().id == expected.front().id);
+                REQUIRE(deq.back().id == expected.back().id);
+            }
+        }
+
+        CHECK(deq.spilled_blocks_count() > 0);
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            REQUIRE(deq[i].id == expected[i].id);
+            REQUIRE(deq[i].value == expected[i].value);
+        }
+    }
+
+    TEST_CASE("At should check bounds") {
+        TemporaryDirectory directory;
+        small_spill_deque deq(directory.path);
+
+        deq.push_back(1);
+        CHECK(deq.at(0) == 1);
+        CHECK_THROWS_AS(deq.at(1), std::out_of_range);
+    }
+
+    TEST_CASE("Spilling to missing directory should throw") {
+        small_spill_deque deq(std::filesystem::temp_directory_path() / "toy_stl_spill_test_missing" / "nested", 1, 4);
+
+        for (int i = 0; i < 8; ++i) {
+            deq.push_back(i);
+        }
+
+        // Third block makes the first one cold
+        CHECK_THROWS_AS(deq.push_back(8), std::system_error);
+        CHECK(deq.size() == 8);
+        CHECK(deq.back() == 7);
+
+        deq.pop_front();
+        CHECK(deq.front() == 1);
+    }
+}
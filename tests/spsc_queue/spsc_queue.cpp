@@ -0,0 +1,171 @@
+#include "doctest/doctest.h"
+#include "toy_stl/spsc_queue.hpp"
+#include "../test_fixtures.hpp"
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <memory>
+#include <iterator>
+
+using test::Tracked;
+
+TEST_SUITE("SPSC queue") {
+    TEST_CASE("Capacity should be rounded up to power of two number of blocks") {
+        my::spsc_queue<int, std::allocator<int>, my::block_elements<4>> queue(9);
+
+        CHECK(queue.capacity() == 16);
+        CHECK(queue.empty_approx());
+    }
+
+    TEST_CASE("Elements should be popped in the same order") {
+        my::spsc_queue<std::string, std::allocator<std::string>, my::block_elements<4>> queue(8);
+
+        // Several rounds, so that indices wrap around the array of blocks
+        for (int round = 0; round < 5; ++round) {
+            for (int i = 0; i < 6; ++i) {
+                CHECK(queue.try_push(std::to_string(round * 10 + i)));
+            }
+            CHECK(queue.size_approx() == 6);
+
+            for (int i = 0; i < 6; ++i) {
+                std::string value;
+                REQUIRE(queue.try_pop(value));
+                CHECK(value == std::to_string(round * 10 + i));
+            }
+            CHECK(queue.empty_approx());
+        }
+    }
+
+    TEST_CASE("Push to full queue and pop from empty queue should fail") {
+        my::spsc_queue<int, std::allocator<int>, my::block_elements<4>> queue(4);
+        int value = -1;
+
+        CHECK_FALSE(queue.try_pop(value));
+        CHECK(value == -1);
+
+        for (int i = 0; i < 4; ++i) {
+            CHECK(queue.try_emplace(i));
+        }
+        CHECK_FALSE(queue.try_push(4));
+
+        REQUIRE(queue.try_pop(value));
+        CHECK(value == 0);
+        CHECK(queue.try_push(4));
+    }
+
+    TEST_CASE("Batched push and pop should stop at capacity and size") {
+        my::spsc_queue<int, std::allocator<int>, my::block_elements<4>> queue(8);
+        std::vector<int> input { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+        CHECK(queue.try_push_n(input.begin(), input.size()) == 8);
+        CHECK(queue.try_push_n(input.begin(), 1) == 0);
+
+        std::vector<int> output;
+        CHECK(queue.try_pop_n(std::back_inserter(output), 3) == 3);
+        CHECK(output == std::vector<int> { 1, 2, 3 });
+
+        CHECK(queue.try_push_n(input.begin() + 8, 2) == 2);
+        CHECK(queue.try_pop_n(std::back_inserter(output), 100) == 7);
+        CHECK(output == std::vector<int> { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 });
+    }
+
+    TEST_CASE("Remaining elements should be destroyed with queue") {
+        {
+            my::spsc_queue<Tracked, std::allocator<Tracked>, my::block_elements<4>> queue(8);
+            for (int i = 0; i < 7; ++i) {
+                queue.try_emplace(i);
+            }
+
+            Tracked value;
+            queue.try_pop(value);
+            queue.try_pop(value);
+        }
+        CHECK(Tracked::alive == 0);
+
+        {
+            my::unbounded_spsc_queue<Tracked, std::allocator<Tracked>, my::block_elements<4>> queue;
+            for (int i = 0; i < 11; ++i) {
+                queue.emplace(i);
+            }
+
+            Tracked value;
+            for (int i = 0; i < 5; ++i) {
+                queue.try_pop(value);
+            }
+        }
+        CHECK(Tracked::alive == 0);
+    }
+
+    TEST_CASE("Unbounded queue should grow by linking blocks") {
+        my::unbounded_spsc_queue<std::string, std::allocator<std::string>, my::block_elements<4>> queue;
+
+        for (int i = 0; i < 50; ++i) {
+            queue.push(std::to_string(i));
+        }
+        CHECK(queue.size_approx() == 50);
+
+        std::vector<std::string> input { "a", "b", "c" };
+        queue.push_n(input.begin(), input.size());
+
+        std::vector<std::string> output;
+        CHECK(queue.try_pop_n(std::back_inserter(output), 20) == 20);
+        for (int i = 0; i < 30; ++i) {
+            std::string value;
+            REQUIRE(queue.try_pop(value));
+            output.push_back(value);
+        }
+        CHECK(queue.try_pop_n(std::back_inserter(output), 20) == 3);
+        CHECK(queue.empty_approx());
+
+        REQUIRE(output.size() == 53);
+        for (int i = 0; i < 50; ++i) {
+            CHECK(output[i] == std::to_string(i));
+        }
+        CHECK(output[52] == "c");
+    }
+
+    TEST_CASE("Elements should arrive in order from another thread") {
+        constexpr long count = 200000;
+
+        my::spsc_queue<long, std::allocator<long>, my::block_elements<16>> queue(64);
+        my::unbounded_spsc_queue<long, std::allocator<long>, my::block_elements<16>> unbounded_queue;
+
+        std::thread producer([&] {
+            for (long i = 0; i < count; ++i) {
+                while (!queue.try_push(i)) {
+                    std::this_thread::yield();
+                }
+                unbounded_queue.push(i);
+            }
+        });
+
+        long expected = 0;
+        long unbounded_expected = 0;
+        bool in_order = true;
+        std::vector<long> batch;
+
+        while (expected < count || unbounded_expected < count) {
+            batch.clear();
+            queue.try_pop_n(std::back_inserter(batch), 32);
+            for (auto value : batch) {
+                in_order = in_order && value == expected++;
+            }
+
+            long value = 0;
+            if (unbounded_queue.try_pop(value)) {
+                in_order = in_order && value == unbounded_expected++;
+            }
+
+            if (batch.empty()) {
+                std::this_thread::yield();
+            }
+        }
+
+        producer.join();
+
+        CHECK(in_order);
+        CHECK(queue.empty_approx());
+        CHECK(unbounded_queue.empty_approx());
+    }
+}
@@ -0,0 +1,190 @@
+#include "doctest/doctest.h"
+#include "toy_stl/static_vector.hpp"
+
+#include <string>
+#include <list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    // Vector with non-trivial elements built during compilation
+    constexpr std::size_t constexpr_string_lengths()
+    {
+        my::static_vector<std::string, 4> vec;
+        vec.push_back("a");
+        vec.emplace_back(3, 'b');
+        vec.insert(vec.begin(), "cc");
+        vec.erase(vec.begin() + 1);
+
+        std::size_t result = 0;
+        for (const auto& s : vec) {
+            result = result * 10 + s.size();
+        }
+        return result;
+    }
+
+    constexpr bool constexpr_try_push_back_overflow()
+    {
+        my::static_vector<int, 2> vec;
+        return vec.try_push_back(1) != nullptr
+            && vec.try_push_back(2) != nullptr
+            && vec.try_push_back(3) == nullptr
+            && vec.size() == 2;
+    }
+
+    static_assert(constexpr_string_lengths() == 23);
+    static_assert(constexpr_try_push_back_overflow());
+    static_assert(my::static_vector<int, 3> { 1, 2 } < my::static_vector<int, 3> { 1, 3 });
+}
+
+TEST_SUITE("Static vector") {
+    TEST_CASE("Constructing static vector") {
+        SUBCASE("Default constructed vector should be empty") {
+            my::static_vector<int, 4> vec;
+
+            CHECK(vec.empty());
+            CHECK(vec.size() == 0);
+            CHECK(vec.capacity() == 4);
+        }
+
+        SUBCASE("Constructing from count and value") {
+            my::static_vector<std::string, 4> vec(3, "abc");
+
+            CHECK(vec.size() == 3);
+            CHECK(vec[0] == "abc");
+            CHECK(vec[2] == "abc");
+        }
+
+        SUBCASE("Constructing from iterator pair") {
+            std::list<int> list { 1, 2, 3 };
+            my::static_vector<int, 4> vec(list.begin(), list.end());
+
+            CHECK(vec == my::static_vector<int, 4> { 1, 2, 3 });
+        }
+
+        SUBCASE("Constructing with too many elements should throw") {
+            CHECK_THROWS_AS((my::static_vector<int, 2> { 1, 2, 3 }), std::bad_alloc);
+            CHECK_THROWS_AS((my::static_vector<int, 2>(3)), std::bad_alloc);
+        }
+    }
+
+    TEST_CASE("Copying and moving static vector") {
+        my::static_vector<std::string, 4> vec { "a", "b", "c" };
+
+        SUBCASE("Copy constructor") {
+            auto copy = vec;
+
+            CHECK(copy == vec);
+        }
+
+        SUBCASE("Copy assignment to longer vector") {
+            my::static_vector<std::string, 4> other { "x", "y", "z", "w" };
+            other = vec;
+
+            CHECK(other == vec);
+        }
+
+        SUBCASE("Move constructor") {
+            auto moved = std::move(vec);
+
+            CHECK(moved == my::static_vector<std::string, 4> { "a", "b", "c" });
+        }
+
+        SUBCASE("Move assignment to shorter vector") {
+            my::static_vector<std::string, 4> other { "x" };
+            other = std::move(vec);
+
+            CHECK(other == my::static_vector<std::string, 4> { "a", "b", "c" });
+        }
+
+        SUBCASE("Swap vectors with different sizes") {
+            my::static_vector<std::string, 4> other { "x" };
+            vec.swap(other);
+
+            CHECK(vec == my::static_vector<std::string, 4> { "x" });
+            CHECK(other == my::static_vector<std::string, 4> { "a", "b", "c" });
+        }
+    }
+
+    TEST_CASE("Adding elements to static vector") {
+        my::static_vector<int, 4> vec { 1, 2 };
+
+        SUBCASE("Push back until full") {
+            vec.push_back(3);
+            vec.emplace_back(4);
+
+            CHECK(vec.full());
+            CHECK_THROWS_AS(vec.push_back(5), std::bad_alloc);
+            CHECK(vec == my::static_vector<int, 4> { 1, 2, 3, 4 });
+        }
+
+        SUBCASE("Try push back does not throw when full") {
+            CHECK(*vec.try_push_back(3) == 3);
+            CHECK(*vec.try_emplace_back(4) == 4);
+            CHECK(vec.try_emplace_back(5) == nullptr);
+            CHECK(vec == my::static_vector<int, 4> { 1, 2, 3, 4 });
+        }
+
+        SUBCASE("Insert in the middle") {
+            auto it = vec.insert(vec.begin() + 1, { 5, 6 });
+
+            CHECK(*it == 5);
+            CHECK(vec == my::static_vector<int, 4> { 1, 5, 6, 2 });
+        }
+
+        SUBCASE("Insert element of the same vector") {
+            vec.insert(vec.begin(), 2, vec.back());
+
+            CHECK(vec == my::static_vector<int, 4> { 2, 2, 1, 2 });
+        }
+
+        SUBCASE("Insert that does not fit leaves vector unchanged") {
+            std::list<int> list { 3, 4, 5 };
+
+            CHECK_THROWS_AS(vec.insert(vec.begin(), list.begin(), list.end()), std::bad_alloc);
+            CHECK(vec == my::static_vector<int, 4> { 1, 2 });
+        }
+    }
+
+    TEST_CASE("Removing elements from static vector") {
+        my::static_vector<std::string, 5> vec { "a", "b", "c", "d", "e" };
+
+        SUBCASE("Erase range") {
+            auto it = vec.erase(vec.begin() + 1, vec.begin() + 3);
+
+            CHECK(*it == "d");
+            CHECK(vec == my::static_vector<std::string, 5> { "a", "d", "e" });
+        }
+
+        SUBCASE("Pop back") {
+            vec.pop_back();
+
+            CHECK(vec.back() == "d");
+        }
+
+        SUBCASE("Resize down and up") {
+            vec.resize(2);
+            vec.resize(3, "z");
+
+            CHECK(vec == my::static_vector<std::string, 5> { "a", "b", "z" });
+        }
+
+        SUBCASE("Clear") {
+            vec.clear();
+
+            CHECK(vec.empty());
+        }
+    }
+
+    TEST_CASE("Accessing elements of static vector") {
+        const my::static_vector<int, 4> vec { 1, 2, 3 };
+
+        CHECK(vec.front() == 1);
+        CHECK(vec.back() == 3);
+        CHECK(vec.at(1) == 2);
+        CHECK_THROWS_AS(vec.at(3), std::out_of_range);
+        CHECK(*vec.rbegin() == 3);
+    }
+}
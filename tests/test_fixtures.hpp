@@ -0,0 +1,87 @@
+#ifndef TOY_SDL_TEST_FIXTURES_HPP
+#define TOY_SDL_TEST_FIXTURES_HPP
+
+#include <cstddef>
+#include <memory>
+
+// Helpers shared by tests of different containers
+namespace test
+{
+    // Counts calls to allocate, all copies share the same counter
+    template <typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        CountingAllocator() = default;
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>& other) : allocations(other.allocations) { }
+
+        T* allocate(std::size_t n)
+        {
+            *allocations += 1;
+            return std::allocator<T>{ }.allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n)
+        {
+            std::allocator<T>{ }.deallocate(p, n);
+        }
+
+        template <typename U>
+        bool operator==(const CountingAllocator<U>& other) const
+        {
+            return allocations == other.allocations;
+        }
+
+        std::shared_ptr<int> allocations = std::make_shared<int>(0);
+    };
+
+    // Counts bytes that are currently allocated, all copies share the same counter
+    template <typename T>
+    struct BlockCountingAllocator
+    {
+        using value_type = T;
+
+        BlockCountingAllocator() = default;
+        template <typename U>
+        BlockCountingAllocator(const BlockCountingAllocator<U>& other) : allocated(other.allocated) { }
+
+        T* allocate(std::size_t n)
+        {
+            *allocated += n * sizeof(T);
+            return std::allocator<T>{ }.allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n)
+        {
+            *allocated -= n * sizeof(T);
+            std::allocator<T>{ }.deallocate(p, n);
+        }
+
+        template <typename U>
+        bool operator==(const BlockCountingAllocator<U>& other) const
+        {
+            return allocated == other.allocated;
+        }
+
+        std::shared_ptr<std::size_t> allocated { std::make_shared<std::size_t>(0) };
+    };
+
+    // Counts constructions and destructions, so that leaks and double destructions are visible
+    struct Tracked
+    {
+        static inline int constructed = 0;
+        static inline int destroyed = 0;
+        static inline int alive = 0;
+
+        int value { 0 };
+
+        Tracked(int value = 0) : value(value) { ++constructed; ++alive; }
+        Tracked(const Tracked& other) : value(other.value) { ++constructed; ++alive; }
+        Tracked& operator=(const Tracked& other) = default;
+        ~Tracked() { ++destroyed; --alive; }
+    };
+}
+
+#endif /* TOY_SDL_TEST_FIXTURES_HPP */
@@ -1,11 +1,18 @@
 #include "doctest/doctest.h"
 #include "toy_stl/vector.hpp"
+#include "../test_fixtures.hpp"
 
 #include <iterator>
 #include <ranges>
 #include <memory_resource>
+#include <memory>
 
 #include <sstream>
+#include <string>
+#include <list>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
 
 namespace doctest
 {
@@ -140,6 +147,86 @@ TEST_CASE("Constructing from iterator pair") {
     }
 }
 
+using test::CountingAllocator;
+
+TEST_CASE("Constructing from iterator pair allocates memory once") {
+    SUBCASE("Forward iterators") {
+        const std::list<int> source = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+        CountingAllocator<int> allocator;
+
+        my::vector<int, CountingAllocator<int>> vec(source.begin(), source.end(), allocator);
+
+        CHECK(*allocator.allocations == 1);
+        CHECK(vec.size() == source.size());
+        CHECK(vec.capacity() == source.size());
+        CHECK(std::equal(vec.begin(), vec.end(), source.begin(), source.end()));
+    }
+
+    SUBCASE("Single pass iterators") {
+        std::istringstream stream("1 2 3 4 5");
+
+        my::vector<int> vec(std::istream_iterator<int>(stream), std::istream_iterator<int>{ });
+
+        CHECK(vec == my::vector<int> { 1, 2, 3, 4, 5 });
+    }
+}
+
+TEST_CASE("Assigning iterator range") {
+    const std::list<int> source = { 1, 2, 3, 4, 5 };
+
+    SUBCASE("Assigning to empty vector") {
+        my::vector<int> vec;
+        vec.assign(source.begin(), source.end());
+
+        CHECK(vec == my::vector<int> { 1, 2, 3, 4, 5 });
+    }
+
+    SUBCASE("Assigning fewer elements than size") {
+        my::vector<int> vec = { 10, 20, 30, 40, 50, 60, 70 };
+        const auto capacity_before = vec.capacity();
+        vec.assign(source.begin(), source.end());
+
+        CHECK(vec == my::vector<int> { 1, 2, 3, 4, 5 });
+        CHECK(vec.capacity() == capacity_before);
+    }
+
+    SUBCASE("Assigning more elements than size but less than capacity") {
+        my::vector<int> vec = { 10, 20 };
+        vec.reserve(10);
+        const auto capacity_before = vec.capacity();
+        vec.assign(source.begin(), source.end());
+
+        CHECK(vec == my::vector<int> { 1, 2, 3, 4, 5 });
+        CHECK(vec.capacity() == capacity_before);
+    }
+
+    SUBCASE("Assigning more elements than capacity allocates once") {
+        CountingAllocator<int> allocator;
+        my::vector<int, CountingAllocator<int>> vec({ 10, 20 }, allocator);
+        const auto allocations_before = *allocator.allocations;
+
+        vec.assign(source.begin(), source.end());
+
+        CHECK(*allocator.allocations == allocations_before + 1);
+        CHECK(std::equal(vec.begin(), vec.end(), source.begin(), source.end()));
+    }
+
+    SUBCASE("Assigning single pass range") {
+        std::istringstream stream("1 2 3");
+        my::vector<int> vec = { 10, 20, 30, 40 };
+        vec.assign(std::istream_iterator<int>(stream), std::istream_iterator<int>{ });
+
+        CHECK(vec == my::vector<int> { 1, 2, 3 });
+    }
+
+    SUBCASE("Assigning initializer list") {
+        my::vector<int> vec = { 10, 20, 30, 40 };
+        vec.assign({ 1, 2 });
+
+        CHECK(vec == my::vector<int> { 1, 2 });
+    }
+}
+
 TEST_CASE("Constructing from initializer_list") {
     SUBCASE("Explicit initializer_list") {
         std::initializer_list<int> init_list { 1, 2, 3 };
@@ -495,6 +582,41 @@ TEST_CASE("Vector resize") {
     }
 }
 
+TEST_CASE("Vector resize for overwrite") {
+    SUBCASE("Resizing up keeps old elements") {
+        my::vector<int> vec = { 1, 2, 3 };
+        vec.resize_for_overwrite(1000);
+
+        REQUIRE(vec.size() == 1000);
+        CHECK(vec[0] == 1);
+        CHECK(vec[1] == 2);
+        CHECK(vec[2] == 3);
+    }
+
+    SUBCASE("Resizing down destroys elements") {
+        my::vector<std::string> vec = { "a", "b", "c" };
+        vec.resize_for_overwrite(1);
+
+        CHECK(vec == my::vector<std::string> { "a" });
+    }
+
+    SUBCASE("Trivial elements are not zeroed") {
+        // unsigned char may hold indeterminate value, so it is fine to inspect it
+        my::vector<unsigned char> vec(64, 0xAB);
+        vec.resize(0);
+        vec.resize_for_overwrite(64);
+
+        CHECK(std::all_of(vec.begin(), vec.end(), [](unsigned char c) { return c == 0xAB; }));
+    }
+
+    SUBCASE("Non-trivial elements are default constructed") {
+        my::vector<std::string> vec = { "a" };
+        vec.resize_for_overwrite(3);
+
+        CHECK(vec == my::vector<std::string> { "a", "", "" });
+    }
+}
+
 TEST_CASE("Vector capacity reserve") {
     SUBCASE("Reserve cannot reduce capacity") {
         const std::size_t size = 10;
@@ -553,6 +675,302 @@ TEST_CASE("Vector capacity shrink") {
     CHECK(vec.capacity() == vec.size()); // Not necessary in the standard
 }
 
+struct Record
+{
+    std::int64_t key;
+    std::int64_t value;
+};
+static_assert(my::is_trivially_relocatable_v<Record>);
+
+// Counts destructor calls to check that relocation does not destroy old elements one by one
+struct RelocatableCounter
+{
+    RelocatableCounter(int value) : value(value) { }
+    RelocatableCounter(const RelocatableCounter& other) : value(other.value) { }
+    ~RelocatableCounter() { destructor_calls += 1; }
+
+    inline static int destructor_calls = 0;
+    int value;
+};
+
+template <>
+struct my::is_trivially_relocatable<RelocatableCounter> : std::true_type { };
+
+struct NonRelocatableCounter
+{
+    NonRelocatableCounter(int value) : value(value) { }
+    NonRelocatableCounter(const NonRelocatableCounter& other) : value(other.value) { }
+    ~NonRelocatableCounter() { destructor_calls += 1; }
+
+    inline static int destructor_calls = 0;
+    int value;
+};
+static_assert(!my::is_trivially_relocatable_v<NonRelocatableCounter>);
+
+TEST_CASE("Relocating elements on reallocation") {
+    SUBCASE("Trivially copyable elements keep their values after growth") {
+        my::vector<Record> vec;
+        for (std::int64_t i = 0; i < 1000; i += 1) {
+            vec.push_back(Record { .key = i, .value = -i });
+        }
+
+        bool all_elements_are_preserved = true;
+        for (std::int64_t i = 0; i < 1000; i += 1) {
+            if (vec[i].key != i || vec[i].value != -i) {
+                all_elements_are_preserved = false;
+                break;
+            }
+        }
+
+        CHECK(all_elements_are_preserved);
+    }
+
+    SUBCASE("Reallocating insert keeps elements around insert position") {
+        my::vector<Record> vec = { Record { 1, 1 }, Record { 4, 4 } };
+        vec.shrink_to_fit();
+        REQUIRE(vec.capacity() == vec.size());
+
+        vec.insert(vec.cbegin() + 1, { Record { 2, 2 }, Record { 3, 3 } });
+        REQUIRE(vec.size() == 4);
+        for (std::size_t i = 0; i < vec.size(); i += 1) {
+            CHECK(vec[i].key == static_cast<std::int64_t>(i) + 1);
+        }
+
+        vec.insert(vec.cend(), 5, vec[0]);
+        REQUIRE(vec.size() == 9);
+        CHECK(vec.back().key == 1);
+
+        vec.emplace(vec.cbegin(), vec.back());
+        CHECK(vec.front().key == 1);
+        CHECK(vec[1].key == 1);
+        CHECK(vec[2].key == 2);
+    }
+
+    SUBCASE("Opted in types are not destroyed when relocated") {
+        RelocatableCounter::destructor_calls = 0;
+        {
+            my::vector<RelocatableCounter> vec;
+            for (int i = 0; i < 100; i += 1) {
+                vec.emplace_back(i);
+            }
+            vec.reserve(1000);
+            vec.shrink_to_fit();
+
+            CHECK(RelocatableCounter::destructor_calls == 0);
+            CHECK(vec.front().value == 0);
+            CHECK(vec.back().value == 99);
+        }
+        CHECK(RelocatableCounter::destructor_calls == 100);
+    }
+
+    SUBCASE("Other types are moved and destroyed one by one") {
+        NonRelocatableCounter::destructor_calls = 0;
+        {
+            my::vector<NonRelocatableCounter> vec;
+            for (int i = 0; i < 100; i += 1) {
+                vec.emplace_back(i);
+            }
+
+            CHECK(NonRelocatableCounter::destructor_calls > 0);
+            CHECK(vec.front().value == 0);
+            CHECK(vec.back().value == 99);
+        }
+    }
+}
+
+// Move constructor is not noexcept, so vector has to copy elements when reallocating
+// Any copy or move can be configured to throw
+struct ThrowingCopy
+{
+    ThrowingCopy(int value) : value(value) { }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) { maybe_throw(); }
+    ThrowingCopy(ThrowingCopy&& other) : value(other.value) { maybe_throw(); other.value = -1; }
+    ThrowingCopy& operator= (const ThrowingCopy& other) = default;
+    ThrowingCopy& operator= (ThrowingCopy&& other) = default;
+
+    static void maybe_throw()
+    {
+        if (constructions_before_throw == 0) {
+            throw std::runtime_error("Copy failed");
+        }
+
+        constructions_before_throw -= 1;
+    }
+
+    inline static int constructions_before_throw = -1; // Negative value means never
+    int value;
+};
+
+struct NoexceptMoveCounter
+{
+    NoexceptMoveCounter(int value) : value(value) { }
+    NoexceptMoveCounter(const NoexceptMoveCounter& other) : value(other.value) { copies += 1; }
+    NoexceptMoveCounter(NoexceptMoveCounter&& other) noexcept : value(other.value) { moves += 1; }
+
+    inline static int copies = 0;
+    inline static int moves = 0;
+    int value;
+};
+
+TEST_CASE("Reallocation exception safety") {
+    my::vector<ThrowingCopy> vec;
+    for (int i = 0; i < 10; i += 1) {
+        vec.emplace_back(i);
+    }
+    vec.shrink_to_fit();
+    REQUIRE(vec.capacity() == vec.size());
+
+    const auto check_vector_is_unchanged = [&vec]() {
+        ThrowingCopy::constructions_before_throw = -1;
+
+        CHECK(vec.size() == 10);
+        CHECK(vec.capacity() == 10);
+        for (int i = 0; i < 10; i += 1) {
+            CHECK(vec[i].value == i);
+        }
+    };
+
+    SUBCASE("Push back") {
+        const ThrowingCopy value(123);
+        ThrowingCopy::constructions_before_throw = 5;
+        CHECK_THROWS_AS(vec.push_back(value), std::runtime_error);
+        check_vector_is_unchanged();
+    }
+
+    SUBCASE("Constructing new element throws") {
+        const ThrowingCopy value(123);
+        ThrowingCopy::constructions_before_throw = 0;
+        CHECK_THROWS_AS(vec.push_back(value), std::runtime_error);
+        check_vector_is_unchanged();
+    }
+
+    SUBCASE("Insert") {
+        ThrowingCopy::constructions_before_throw = 7;
+        CHECK_THROWS_AS(vec.insert(vec.cbegin() + 3, 2, ThrowingCopy(123)), std::runtime_error);
+        check_vector_is_unchanged();
+    }
+
+    SUBCASE("Emplace") {
+        ThrowingCopy::constructions_before_throw = 9;
+        CHECK_THROWS_AS(vec.emplace(vec.cbegin() + 3, 123), std::runtime_error);
+        check_vector_is_unchanged();
+    }
+
+    SUBCASE("Reserve") {
+        ThrowingCopy::constructions_before_throw = 9;
+        CHECK_THROWS_AS(vec.reserve(100), std::runtime_error);
+        check_vector_is_unchanged();
+    }
+
+    SUBCASE("Elements are copied and not moved") {
+        ThrowingCopy::constructions_before_throw = -1;
+        vec.reserve(100);
+
+        CHECK(vec.size() == 10);
+        CHECK(vec.capacity() >= 100);
+        for (int i = 0; i < 10; i += 1) {
+            CHECK(vec[i].value == i);
+        }
+    }
+}
+
+TEST_CASE("Elements with noexcept move constructor are moved on reallocation") {
+    my::vector<NoexceptMoveCounter> vec;
+    for (int i = 0; i < 10; i += 1) {
+        vec.emplace_back(i);
+    }
+
+    NoexceptMoveCounter::copies = 0;
+    NoexceptMoveCounter::moves = 0;
+
+    vec.reserve(100);
+    CHECK(NoexceptMoveCounter::copies == 0);
+    CHECK(NoexceptMoveCounter::moves == 10);
+
+    vec.shrink_to_fit();
+    CHECK(NoexceptMoveCounter::copies == 0);
+    CHECK(NoexceptMoveCounter::moves == 20);
+}
+
+template <typename Vector>
+my::vector<std::size_t> capacities_after_push_backs(std::size_t count)
+{
+    my::vector<std::size_t> capacities;
+    Vector vec;
+    for (std::size_t i = 0; i < count; i += 1) {
+        vec.push_back(typename Vector::value_type { });
+        if (capacities.empty() || capacities.back() != vec.capacity()) {
+            capacities.push_back(vec.capacity());
+        }
+    }
+
+    return capacities;
+}
+
+struct AddTenGrowth
+{
+    std::size_t operator() (std::size_t capacity, std::size_t required_capacity, std::size_t) const
+    {
+        return std::max(capacity + 10, required_capacity);
+    }
+};
+
+TEST_CASE("Vector growth policy") {
+    SUBCASE("Default policy doubles capacity") {
+        CHECK(capacities_after_push_backs<my::vector<int>>(20) == my::vector<std::size_t> { 1, 2, 4, 8, 16, 32 });
+    }
+
+    SUBCASE("Growth by factor 1.5") {
+        using vector = my::vector<int, std::allocator<int>, my::one_and_half_growth>;
+        CHECK(capacities_after_push_backs<vector>(20) == my::vector<std::size_t> { 1, 2, 3, 5, 8, 12, 18, 27 });
+    }
+
+    SUBCASE("Size class aligned growth") {
+        CHECK(my::round_up_to_size_class(1) == 8);
+        CHECK(my::round_up_to_size_class(16) == 16);
+        CHECK(my::round_up_to_size_class(17) == 32);
+        CHECK(my::round_up_to_size_class(129) == 160);
+        CHECK(my::round_up_to_size_class(4096) == 4096);
+        CHECK(my::round_up_to_size_class(4097) == 5120);
+
+        using vector = my::vector<int, std::allocator<int>, my::size_class_growth<>>;
+        const auto capacities = capacities_after_push_backs<vector>(100);
+        for (const auto capacity : capacities) {
+            CHECK(capacity * sizeof(int) == my::round_up_to_size_class(capacity * sizeof(int)));
+        }
+    }
+
+    SUBCASE("Custom policy") {
+        using vector = my::vector<int, std::allocator<int>, AddTenGrowth>;
+        CHECK(capacities_after_push_backs<vector>(25) == my::vector<std::size_t> { 10, 20, 30 });
+    }
+
+    SUBCASE("Repeated range insertion reallocates amortized") {
+        my::vector<int> vec;
+        const my::vector<int> chunk = { 1, 2, 3 };
+
+        int reallocations = 0;
+        for (int i = 0; i < 100; i += 1) {
+            const auto capacity_before = vec.capacity();
+            vec.insert(vec.cend(), chunk.cbegin(), chunk.cend());
+            if (vec.capacity() != capacity_before) {
+                reallocations += 1;
+            }
+        }
+
+        CHECK(vec.size() == 300);
+        CHECK(reallocations < 20);
+    }
+
+    SUBCASE("Resize grows capacity geometrically") {
+        my::vector<int> vec(10);
+        vec.shrink_to_fit();
+
+        vec.resize(11);
+        CHECK(vec.capacity() == 20);
+    }
+}
+
 TEST_CASE("Vector equality") {
     SUBCASE("Both vectors empty") {
         my::vector<int> a;
@@ -820,6 +1238,48 @@ TEST_CASE("Vector spaceship operator") {
     }
 }
 
+TEST_CASE("Comparing vectors of bitwise comparable types") {
+    SUBCASE("Mismatch far from the beginning") {
+        my::vector<int> a(1000, 7);
+        my::vector<int> b(1000, 7);
+        b[900] = -1;
+
+        CHECK_FALSE(a == b);
+        CHECK((a <=> b) == std::strong_ordering::greater);
+        CHECK((b <=> a) == std::strong_ordering::less);
+    }
+
+    SUBCASE("Order of values is not order of bytes") {
+        // 256 is 00 01 00 00 in little endian, so memcmp alone would put it before 1
+        my::vector<int> a { 256 };
+        my::vector<int> b { 1 };
+        my::vector<int> negative { -1 };
+
+        CHECK(a > b);
+        CHECK(negative < b);
+    }
+
+    SUBCASE("Signed and unsigned bytes") {
+        my::vector<signed char> a { 1, -1 };
+        my::vector<signed char> b { 1, 1 };
+        my::vector<unsigned char> c { 1, 255 };
+        my::vector<unsigned char> d { 1, 1 };
+
+        CHECK(a < b);
+        CHECK(c > d);
+        CHECK((c <=> my::vector<unsigned char> { 1, 255, 0 }) == std::strong_ordering::less);
+    }
+
+    SUBCASE("Enums") {
+        enum class Color { red, green, blue };
+        my::vector<Color> a { Color::red, Color::blue };
+        my::vector<Color> b { Color::red, Color::green };
+
+        CHECK(a != b);
+        CHECK(a > b);
+    }
+}
+
 // TODO: Add test cases covering insertion with reallocation
 TEST_CASE("Ordinary insertion") {
     SUBCASE("Insert before first element") {
@@ -960,6 +1420,141 @@ TEST_CASE("Inserting range") {
     }
 }
 
+TEST_CASE("Inserting range with non random access iterators") {
+    SUBCASE("Bidirectional iterators") {
+        const std::list<int> source = { 10, 20, 30 };
+        my::vector<int> vec = { 1, 2, 3, 4 };
+        vec.reserve(10);
+
+        auto it = vec.insert(vec.cbegin() + 1, source.begin(), source.end());
+
+        CHECK(it == vec.begin() + 1);
+        CHECK(vec == my::vector<int> { 1, 10, 20, 30, 2, 3, 4 });
+    }
+
+    SUBCASE("Bidirectional iterators with reallocation") {
+        const std::list<int> source = { 10, 20, 30 };
+        my::vector<int> vec = { 1, 2, 3, 4 };
+        vec.shrink_to_fit();
+
+        vec.insert(vec.cbegin() + 3, source.begin(), source.end());
+
+        CHECK(vec == my::vector<int> { 1, 2, 3, 10, 20, 30, 4 });
+    }
+
+    SUBCASE("Single pass iterators") {
+        std::istringstream stream("10 20 30");
+        my::vector<int> vec = { 1, 2, 3, 4 };
+
+        auto it = vec.insert(vec.cbegin() + 2, std::istream_iterator<int>(stream), std::istream_iterator<int>{ });
+
+        CHECK(it == vec.begin() + 2);
+        CHECK(vec == my::vector<int> { 1, 2, 10, 20, 30, 3, 4 });
+    }
+}
+
+TEST_CASE("Range modifiers") {
+    SUBCASE("Appending range") {
+        my::vector<int> vec = { 1, 2, 3 };
+        const std::list<int> source = { 4, 5, 6 };
+
+        vec.append_range(source);
+
+        CHECK(vec == my::vector<int> { 1, 2, 3, 4, 5, 6 });
+    }
+
+    SUBCASE("Appending sized range allocates memory once") {
+        CountingAllocator<int> allocator;
+        my::vector<int, CountingAllocator<int>> vec(allocator);
+
+        vec.append_range(std::views::iota(0, 1000));
+
+        CHECK(*allocator.allocations == 1);
+        REQUIRE(vec.size() == 1000);
+        CHECK(vec[0] == 0);
+        CHECK(vec[999] == 999);
+    }
+
+    SUBCASE("Appending sized single pass ranges follows growth policy") {
+        CountingAllocator<int> allocator;
+        my::vector<int, CountingAllocator<int>> vec(allocator);
+
+        for (int i = 0; i < 1000; ++i) {
+            std::istringstream element_stream(std::to_string(i));
+            vec.append_range(std::views::counted(std::istream_iterator<int>(element_stream), 1));
+        }
+
+        CHECK(*allocator.allocations < 20);
+        REQUIRE(vec.size() == 1000);
+        CHECK(vec[0] == 0);
+        CHECK(vec[999] == 999);
+    }
+
+    SUBCASE("Appending single pass range") {
+        std::istringstream stream("4 5 6");
+        my::vector<int> vec = { 1, 2, 3 };
+
+        vec.append_range(std::views::istream<int>(stream));
+
+        CHECK(vec == my::vector<int> { 1, 2, 3, 4, 5, 6 });
+    }
+
+    SUBCASE("Inserting range in the middle") {
+        my::vector<int> vec = { 1, 2, 3 };
+
+        auto it = vec.insert_range(vec.cbegin() + 1, std::views::iota(10, 13));
+
+        CHECK(it == vec.begin() + 1);
+        CHECK(vec == my::vector<int> { 1, 10, 11, 12, 2, 3 });
+    }
+
+    SUBCASE("Inserting range longer than tail") {
+        my::vector<int> vec = { 1, 2, 3 };
+        vec.reserve(10);
+
+        vec.insert_range(vec.cbegin() + 2, std::views::iota(10, 14));
+
+        CHECK(vec == my::vector<int> { 1, 2, 10, 11, 12, 13, 3 });
+    }
+
+    SUBCASE("Inserting single pass range in the middle") {
+        std::istringstream stream("10 11");
+        my::vector<int> vec = { 1, 2, 3 };
+
+        vec.insert_range(vec.cbegin() + 1, std::views::istream<int>(stream));
+
+        CHECK(vec == my::vector<int> { 1, 10, 11, 2, 3 });
+    }
+
+    SUBCASE("Inserting range of convertible elements") {
+        const std::list<short> source = { 10, 11 };
+        my::vector<long> vec = { 1, 2 };
+
+        vec.insert_range(vec.cbegin(), source);
+
+        CHECK(vec == my::vector<long> { 10, 11, 1, 2 });
+    }
+
+    SUBCASE("Assigning range") {
+        my::vector<int> vec = { 1, 2, 3, 4, 5 };
+
+        vec.assign_range(std::views::iota(10, 13));
+        CHECK(vec == my::vector<int> { 10, 11, 12 });
+
+        vec.assign_range(std::views::iota(0, 6));
+        CHECK(vec == my::vector<int> { 0, 1, 2, 3, 4, 5 });
+    }
+
+    SUBCASE("Assigning single pass range") {
+        std::istringstream stream("10 11");
+        my::vector<int> vec = { 1, 2, 3 };
+
+        vec.assign_range(std::views::istream<int>(stream));
+
+        CHECK(vec == my::vector<int> { 10, 11 });
+    }
+}
+
 TEST_CASE("Inserting initializer list") {
     SUBCASE("Inserting empty initializer list does nothing") {
         my::vector<int> a = { 1, 2, 3 };
@@ -0,0 +1,218 @@
+#include "doctest/doctest.h"
+#include "toy_stl/vector.hpp"
+
+#include <vector>
+#include <list>
+#include <random>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <sstream>
+
+namespace
+{
+    // Compares packed vector with std::vector<bool> element by element
+    bool same_bits(const my::vector<bool>& a, const std::vector<bool>& b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+}
+
+static_assert(std::random_access_iterator<my::vector<bool>::iterator>);
+static_assert(std::random_access_iterator<my::vector<bool>::const_iterator>);
+static_assert(std::output_iterator<my::vector<bool>::iterator, bool>);
+
+TEST_CASE("Vector of bools is packed") {
+    my::vector<bool> vec(1000, true);
+
+    CHECK(vec.size() == 1000);
+    CHECK(vec.capacity() >= 1000);
+    CHECK(vec.capacity() < 1000 + my::vector<bool>::bits_per_word);
+    CHECK(vec.count() == 1000);
+}
+
+TEST_CASE("Vector of bools element access") {
+    my::vector<bool> vec { true, false, true };
+
+    SUBCASE("Reading elements") {
+        CHECK(vec[0]);
+        CHECK_FALSE(vec[1]);
+        CHECK(vec.front());
+        CHECK(vec.back());
+        CHECK_THROWS_AS(vec.at(3), std::out_of_range);
+    }
+
+    SUBCASE("Writing through proxy reference") {
+        vec[1] = true;
+        vec[0].flip();
+        vec.back() = vec[0];
+
+        CHECK(vec == my::vector<bool> { false, true, false });
+    }
+
+    SUBCASE("Swapping proxy references") {
+        using std::swap;
+        swap(vec[0], vec[1]);
+
+        CHECK(vec == my::vector<bool> { false, true, true });
+    }
+}
+
+TEST_CASE("Vector of bools modifiers match std::vector<bool>") {
+    my::vector<bool> vec;
+    std::vector<bool> expected;
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> operation_distribution(0, 4);
+    std::bernoulli_distribution bit_distribution(0.5);
+
+    for (int step = 0; step < 2000; ++step) {
+        const auto position = expected.empty() ? 0 : generator() % (expected.size() + 1);
+        const auto count = generator() % 150;
+        const bool value = bit_distribution(generator);
+
+        switch (operation_distribution(generator)) {
+            case 0:
+                vec.push_back(value);
+                expected.push_back(value);
+                break;
+            case 1:
+                vec.insert(vec.cbegin() + position, count, value);
+                expected.insert(expected.cbegin() + position, count, value);
+                break;
+            case 2: {
+                std::vector<bool> source(count);
+                std::generate(source.begin(), source.end(), [&] { return bit_distribution(generator); });
+                vec.insert(vec.cbegin() + position, source.begin(), source.end());
+                expected.insert(expected.cbegin() + position, source.begin(), source.end());
+                break;
+            }
+            case 3: {
+                const auto last = std::min(expected.size(), position + count);
+                vec.erase(vec.cbegin() + position, vec.cbegin() + last);
+                expected.erase(expected.cbegin() + position, expected.cbegin() + last);
+                break;
+            }
+            case 4:
+                if (!expected.empty()) {
+                    vec.pop_back();
+                    expected.pop_back();
+                }
+                break;
+        }
+
+        REQUIRE(same_bits(vec, expected));
+        REQUIRE(vec.count() == static_cast<std::size_t>(std::count(expected.begin(), expected.end(), true)));
+    }
+}
+
+TEST_CASE("Vector of bools inserting from single pass range") {
+    my::vector<bool> vec { true, true };
+    std::istringstream stream("0 1 0 1");
+
+    vec.insert(vec.cbegin() + 1, std::istream_iterator<bool>(stream), std::istream_iterator<bool>());
+
+    CHECK(vec == my::vector<bool> { true, false, true, false, true, true });
+}
+
+TEST_CASE("Vector of bools resize") {
+    my::vector<bool> vec(70, true);
+
+    vec.resize(3);
+    vec.resize(130);
+
+    CHECK(vec.count() == 3);
+
+    vec.resize(200, true);
+
+    CHECK(vec.count() == 73);
+    CHECK(vec.find_first() == 0);
+    CHECK(vec.find_next(2) == 130);
+}
+
+TEST_CASE("Vector of bools bit operations") {
+    my::vector<bool> vec(300);
+
+    SUBCASE("Find in empty bitmap") {
+        CHECK(vec.none());
+        CHECK(vec.find_first() == my::vector<bool>::npos);
+        CHECK(vec.find_next(0) == my::vector<bool>::npos);
+    }
+
+    SUBCASE("Find set bits across words") {
+        vec[5] = true;
+        vec[64] = true;
+        vec[299] = true;
+
+        CHECK(vec.find_first() == 5);
+        CHECK(vec.find_next(5) == 64);
+        CHECK(vec.find_next(64) == 299);
+        CHECK(vec.find_next(299) == my::vector<bool>::npos);
+        CHECK(vec.count() == 3);
+    }
+
+    SUBCASE("Set and reset ranges") {
+        vec.set_range(10, 250);
+        vec.reset_range(60, 70);
+
+        CHECK(vec.count() == 230);
+        CHECK(vec[59]);
+        CHECK_FALSE(vec[60]);
+        CHECK_FALSE(vec[69]);
+        CHECK(vec[70]);
+        CHECK(vec.find_next(249) == my::vector<bool>::npos);
+    }
+
+    SUBCASE("Set, flip and reset whole bitmap") {
+        vec.set();
+
+        CHECK(vec.all());
+        CHECK(vec.count() == 300);
+
+        vec.flip();
+
+        CHECK(vec.none());
+
+        vec[7] = true;
+        vec.reset();
+
+        CHECK(vec.none());
+    }
+
+    SUBCASE("Bitwise operators") {
+        my::vector<bool> other(300);
+        vec.set_range(0, 200);
+        other.set_range(100, 300);
+
+        CHECK((vec & other).count() == 100);
+        CHECK((vec | other).count() == 300);
+        CHECK((vec ^ other).count() == 200);
+        CHECK((~vec).count() == 100);
+        CHECK((~vec).find_first() == 200);
+    }
+}
+
+TEST_CASE("Vector of bools comparisons") {
+    CHECK(my::vector<bool> { true, false } == my::vector<bool> { true, false });
+    CHECK(my::vector<bool> { true, false } != my::vector<bool> { true, false, false });
+    CHECK(my::vector<bool> { false, true } < my::vector<bool> { true, false });
+    CHECK(my::vector<bool> { true } < my::vector<bool> { true, false });
+
+    my::vector<bool> long_a(200, true);
+    my::vector<bool> long_b(200, true);
+    long_b[150] = false;
+
+    CHECK(long_b < long_a);
+    CHECK((long_a <=> long_a) == std::strong_ordering::equal);
+}
+
+TEST_CASE("Vector of bools works with algorithms") {
+    my::vector<bool> vec { true, false, true, true, false };
+
+    std::reverse(vec.begin(), vec.end());
+
+    CHECK(vec == my::vector<bool> { false, true, true, false, true });
+    CHECK(std::distance(vec.rbegin(), vec.rend()) == 5);
+    CHECK(*vec.rbegin() == true);
+    CHECK(std::ranges::count(vec, true) == 3);
+}
@@ -0,0 +1,101 @@
+#include "doctest/doctest.h"
+#include "toy_stl/work_stealing_deque.hpp"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+TEST_SUITE("Work stealing deque") {
+    TEST_CASE("Owner should pop in LIFO order and thief should steal in FIFO order") {
+        my::work_stealing_deque<int> deq;
+
+        for (int i = 0; i < 5; ++i) {
+            deq.push_bottom(i);
+        }
+        CHECK(deq.size_approx() == 5);
+
+        CHECK(deq.pop_bottom() == 4);
+        CHECK(deq.steal() == 0);
+        CHECK(deq.pop_bottom() == 3);
+        CHECK(deq.steal() == 1);
+        CHECK(deq.pop_bottom() == 2);
+
+        CHECK(deq.empty_approx());
+        CHECK(deq.pop_bottom() == std::nullopt);
+        CHECK(deq.steal() == std::nullopt);
+
+        // Popping from empty deque must not break it
+        deq.push_bottom(7);
+        CHECK(deq.size_approx() == 1);
+        CHECK(deq.steal() == 7);
+    }
+
+    TEST_CASE("Deque should grow and keep elements") {
+        my::work_stealing_deque<long> deq(4);
+        CHECK(deq.capacity() == 4);
+
+        // Some elements are stolen first, so elements wrap around the array before growth
+        for (long i = 0; i < 3; ++i) {
+            deq.push_bottom(i);
+        }
+        deq.steal();
+        deq.steal();
+
+        for (long i = 3; i < 100; ++i) {
+            deq.push_bottom(i);
+        }
+        CHECK(deq.capacity() == 128);
+        CHECK(deq.size_approx() == 98);
+
+        for (long i = 2; i < 50; ++i) {
+            CHECK(deq.steal() == i);
+        }
+        for (long i = 99; i >= 50; --i) {
+            CHECK(deq.pop_bottom() == i);
+        }
+        CHECK(deq.empty_approx());
+    }
+
+    TEST_CASE("Every element should be taken exactly once by owner or thieves") {
+        constexpr int count = 100000;
+        constexpr int thieves_count = 3;
+
+        my::work_stealing_deque<int> deq(2);
+        std::vector<std::atomic<int>> taken(count);
+        std::atomic<bool> done { false };
+
+        std::vector<std::thread> thieves;
+        for (int i = 0; i < thieves_count; ++i) {
+            thieves.emplace_back([&] {
+                while (!done.load()) {
+                    if (auto value = deq.steal()) {
+                        taken[*value].fetch_add(1);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        // Owner pushes in bursts, so deque grows while thieves are stealing
+        for (int i = 0; i < count; ++i) {
+            deq.push_bottom(i);
+            if (i % 3 == 0) {
+                if (auto value = deq.pop_bottom()) {
+                    taken[*value].fetch_add(1);
+                }
+            }
+        }
+        while (auto value = deq.pop_bottom()) {
+            taken[*value].fetch_add(1);
+        }
+
+        done.store(true);
+        for (auto& thief : thieves) {
+            thief.join();
+        }
+
+        CHECK(std::all_of(taken.begin(), taken.end(), [](const std::atomic<int>& x) { return x.load() == 1; }));
+    }
+}